@@ -53,13 +53,13 @@ Item {
     }
 
     function statusConfigChanged() {
-        applicationFile.remotePath = "file://" + status.config.remotePath
+        applicationFile.remotePath = "file://" + status.configFields.remotePath
         checkFile()
     }
 
     function checkFile() {
-        var remoteFile = "file://" + status.task.file
-        var remotePath = "file://" + status.config.remotePath
+        var remoteFile = "file://" + status.taskFields.file
+        var remotePath = "file://" + status.configFields.remotePath
         if ((remotePath !== "file://")
                 && (remoteFile !== "file://")
                 && (remoteFile.indexOf(remotePath) === 0)
@@ -71,9 +71,9 @@ Item {
     }
 
     function fileUploadFinished() {
-        if (status.task.taskMode !== ApplicationStatus.TaskModeAuto)
+        if (status.taskFields.taskMode !== ApplicationStatus.TaskModeAuto)
             command.setTaskMode('execute', ApplicationCommand.TaskModeAuto)
-        if (status.task.file !== "") {
+        if (status.taskFields.file !== "") {
             command.resetProgram('execute')
         }
         var fileName = file.localFilePath.split('/').reverse()[0]
@@ -24,7 +24,7 @@ import QtQuick 2.0
 
 QtObject {
     property var core: null
-    property var status: core === null ? {"synced": false} : core.status
+    property var status: core === null ? {"synced": false, "motionSynced": false, "configSynced": false, "ioSynced": false, "taskSynced": false, "interpSynced": false} : core.status
     property var settings: core === null ? {"initialized": false} : core.settings
     property var command: core === null ? {"connected": false} : core.command
     property var file: core === null ? {"localPath":"", "remotePath":"", "localFilePath":"", "ready":false} : core.file
@@ -24,9 +24,9 @@ import QtQuick 2.0
 import Machinekit.Application 1.0
 
 LocalSettings {
-    property var status: { "synced": false }
+    property var status: { "synced": false, "configSynced": false }
     property bool initialized: false
-    property bool _ready: status.synced
+    property bool _ready: status.configSynced
 
     id: localSettings
 
@@ -41,8 +41,8 @@ LocalSettings {
 
     on_ReadyChanged: {
         if (_ready && !initialized) {
-            for (var i = 0; i < status.config.axes; ++i) {
-                setValue("axis" + i + ".jogVelocity", status.config.defaultVelocity, false)
+            for (var i = 0; i < status.configFields.axes; ++i) {
+                setValue("axis" + i + ".jogVelocity", status.configFields.defaultVelocity, false)
             }
             setValue("dro.showOffsets", false, false)
             setValue("dro.showVelocity", true, false)
@@ -2,11 +2,11 @@ import QtQuick 2.0
 import Machinekit.Application 1.0
 
 ApplicationItem {
-    property var status: {"synced": false}
+    property var status: {"synced": false, "motionSynced": false, "configSynced": false, "taskSynced": false}
     property var command: {"ready": false}
     property bool running: false
 
-    property bool _ready: status.synced && command.ready
+    property bool _ready: status.motionSynced && status.configSynced && status.taskSynced && command.ready
     property int _currentSequence: 0
     property var _waitingAxesList: []
     property var _homingAxesList: []
@@ -21,12 +21,12 @@ ApplicationItem {
 
         var axesList = []
 
-        for (var i = 0; i < status.config.axes; ++i) {
-            if (status.motion.axis[i].homed) {
+        for (var i = 0; i < status.configFields.axes; ++i) {
+            if (status.axes[i].homed) {
                 command.unhomeAxis(i)
             }
             if ((axesList.length == 0) ||
-                    (status.config.axis[axesList[0]].homeSequence > status.config.axis[i].homeSequence))
+                    (status.configFields.axis[axesList[0]].homeSequence > status.configFields.axis[i].homeSequence))
             {
                 axesList.push(i)
             }
@@ -51,15 +51,15 @@ ApplicationItem {
         var axis
         var list
 
-        if (status.task.taskState !== ApplicationStatus.TaskStateOn) {
+        if (status.taskFields.taskState !== ApplicationStatus.TaskStateOn) {
             running = false
             return
         }
 
         for (i = (_prepareAxesList.length-1); i >= 0 ; --i) {
             axis = _prepareAxesList[i]
-            if (!status.motion.axis[axis].homing
-                    && !status.motion.axis[axis].homed) {
+            if (!status.axes[axis].homing
+                    && !status.axes[axis].homed) {
                 prepare = true
             }
             else {
@@ -79,7 +79,7 @@ ApplicationItem {
 
         for (i = 0; i < _homingAxesList.length; ++i) {
             axis = _homingAxesList[i]
-            if (status.motion.axis[axis].homing) {
+            if (status.axes[axis].homing) {
                 homing = true
                 break
             }
@@ -95,10 +95,10 @@ ApplicationItem {
                 return
             }
 
-            var currentSequence = status.config.axis[_waitingAxesList[0]].homeSequence
+            var currentSequence = status.configFields.axis[_waitingAxesList[0]].homeSequence
             for (i = (_waitingAxesList.length-1); i >= 0 ; --i) {
                 axis = _waitingAxesList[i]
-                if (status.config.axis[axis].homeSequence === currentSequence)
+                if (status.configFields.axis[axis].homeSequence === currentSequence)
                 {
                     command.homeAxis(axis)
 
@@ -20,6 +20,11 @@ SOURCES += \
     qapplicationcommand.cpp \
     qapplicationerror.cpp \
     qapplicationstatus.cpp \
+    qapplicationstatusposition.cpp \
+    qapplicationstatusaxis.cpp \
+    qapplicationstatusfields.cpp \
+    qapplicationstatusdecoder.cpp \
+    qapplicationstatusconverter.cpp \
     qapplicationfile.cpp \
     qapplicationlauncher.cpp \
     qlocalsettings.cpp \
@@ -38,6 +43,11 @@ HEADERS += \
     qapplicationcommand.h \
     qapplicationerror.h \
     qapplicationstatus.h \
+    qapplicationstatusposition.h \
+    qapplicationstatusaxis.h \
+    qapplicationstatusfields.h \
+    qapplicationstatusdecoder.h \
+    qapplicationstatusconverter.h \
     qapplicationfile.h \
     qapplicationlauncher.h \
     qlocalsettings.h \
@@ -25,6 +25,8 @@
 #include "qapplicationconfigfilter.h"
 #include "qapplicationdescription.h"
 #include "qapplicationstatus.h"
+#include "qapplicationstatusposition.h"
+#include "qapplicationstatusaxis.h"
 #include "qapplicationcommand.h"
 #include "qapplicationerror.h"
 #include "qapplicationfile.h"
@@ -67,6 +69,8 @@ void MachinekitApplicationPlugin::registerTypes(const char *uri)
     qmlRegisterType<QApplicationConfigFilter>(uri, 1, 0, "ApplicationConfigFilter");
     qmlRegisterType<QApplicationDescription>(uri, 1, 0, "ApplicationDescription");
     qmlRegisterType<QApplicationStatus>(uri, 1, 0, "ApplicationStatus");
+    qmlRegisterType<QApplicationStatusPosition>(uri, 1, 0, "ApplicationStatusPosition");
+    qmlRegisterType<QApplicationStatusAxis>(uri, 1, 0, "ApplicationStatusAxis");
     qmlRegisterType<QApplicationCommand>(uri, 1, 0, "ApplicationCommand");
     qmlRegisterType<QApplicationError>(uri, 1, 0, "ApplicationError");
     qmlRegisterType<QApplicationFile>(uri, 1, 0, "ApplicationFile");
@@ -32,7 +32,6 @@ QApplicationCommand::QApplicationCommand(QObject *parent) :
     m_connectionState(Disconnected),
     m_error(NoError),
     m_errorString(""),
-    m_context(NULL),
     m_commandSocket(NULL),
     m_commandHeartbeatTimer(new QTimer(this)),
     m_commandPingErrorCount(0),
@@ -690,7 +689,7 @@ void QApplicationCommand::sendCommandMessage(pb::ContainerType type)
 
     try {
         m_tx.set_type(type);
-        m_commandSocket->sendMessage(QByteArray(m_tx.SerializeAsString().c_str(), m_tx.ByteSize()));
+        m_commandSocket->sendMessage(m_tx);
 #ifdef QT_DEBUG
     std::string s;
     gpb::TextFormat::PrintToString(m_tx, &s);
@@ -706,7 +705,7 @@ void QApplicationCommand::sendCommandMessage(pb::ContainerType type)
 }
 
 /** Processes all message received on the command 0MQ socket */
-void QApplicationCommand::commandMessageReceived(const QList<QByteArray> &messageList)
+void QApplicationCommand::commandMessageReceived(const ThreadedZMQFrameList &messageList)
 {
     m_rx.ParseFromArray(messageList.at(0).data(), messageList.at(0).size());
 
@@ -788,12 +787,9 @@ void QApplicationCommand::commandHeartbeatTimerTick()
 /** Connects the 0MQ sockets */
 bool QApplicationCommand::connectSockets()
 {
-    m_context = new PollingZMQContext(this, 1);
-    connect(m_context, SIGNAL(pollError(int,QString)),
+    m_commandSocket = TransportManager::instance()->createSocket(ZMQSocket::TYP_DEALER, "command", this);
+    connect(m_commandSocket, SIGNAL(receiveError(int,QString)),
             this, SLOT(pollError(int,QString)));
-    m_context->start();
-
-    m_commandSocket = m_context->createSocket(ZMQSocket::TYP_DEALER, this);
     m_commandSocket->setLinger(0);
     m_commandSocket->setIdentity(QString("%1-%2").arg(QHostInfo::localHostName()).arg(m_uuid.toString()).toLocal8Bit());
 
@@ -807,8 +803,8 @@ bool QApplicationCommand::connectSockets()
         return false;
     }
 
-    connect(m_commandSocket, SIGNAL(messageReceived(QList<QByteArray>)),
-            this, SLOT(commandMessageReceived(QList<QByteArray>)));
+    connect(m_commandSocket, SIGNAL(framesReceived(ThreadedZMQFrameList)),
+            this, SLOT(commandMessageReceived(ThreadedZMQFrameList)));
 
 #ifdef QT_DEBUG
     DEBUG_TAG(1, "command", "sockets connected" << m_commandUri)
@@ -828,11 +824,4 @@ void QApplicationCommand::disconnectSockets()
         m_commandSocket->deleteLater();
         m_commandSocket = NULL;
     }
-
-    if (m_context != NULL)
-    {
-        m_context->stop();
-        m_context->deleteLater();
-        m_context = NULL;
-    }
 }
@@ -29,6 +29,7 @@
 #include <QCoreApplication>
 #include <QHostInfo>
 #include <nzmqt/nzmqt.hpp>
+#include <transportmanager.h>
 #include <google/protobuf/text_format.h>
 #include <machinetalk/protobuf/message.pb.h>
 #include <machinetalk/protobuf/status.pb.h>
@@ -211,8 +212,7 @@ private:
     ConnectionError m_error;
     QString         m_errorString;
 
-    PollingZMQContext *m_context;
-    ZMQSocket   *m_commandSocket;
+    ThreadedZMQSocket   *m_commandSocket;
     QTimer      *m_commandHeartbeatTimer;
     int         m_commandPingErrorCount;
     int         m_commandPingErrorThreshold;
@@ -232,7 +232,7 @@ private:
     void sendCommandMessage(pb::ContainerType type);
 
 private slots:
-    void commandMessageReceived(const QList<QByteArray> &messageList);
+    void commandMessageReceived(const ThreadedZMQFrameList &messageList);
     void pollError(int errorNum, const QString &errorMsg);
     void commandHeartbeatTimerTick();
 
@@ -170,7 +170,6 @@ QApplicationConfig::QApplicationConfig(QQuickItem *parent) :
      m_errorString(""),
      m_selectedConfig(new QApplicationConfigItem(this)),
      m_filter(new QApplicationConfigFilter(this)),
-     m_context(NULL),
      m_configSocket(NULL)
 {
 }
@@ -362,12 +361,9 @@ void QApplicationConfig::pollError(int errorNum, const QString &errorMsg)
 
 bool QApplicationConfig::connectSocket()
 {
-    m_context = new PollingZMQContext(this, 1);
-    connect(m_context, SIGNAL(pollError(int,QString)),
+    m_configSocket = TransportManager::instance()->createSocket(ZMQSocket::TYP_DEALER, "config", this);
+    connect(m_configSocket, SIGNAL(receiveError(int,QString)),
             this, SLOT(pollError(int,QString)));
-    m_context->start();
-
-    m_configSocket = m_context->createSocket(ZMQSocket::TYP_DEALER, this);
     m_configSocket->setLinger(0);
     m_configSocket->setIdentity(QString("%1-%2").arg("appconfig").arg(QCoreApplication::applicationPid()).toLocal8Bit());
 
@@ -382,8 +378,8 @@ bool QApplicationConfig::connectSocket()
         return false;
     }
 
-    connect(m_configSocket, SIGNAL(messageReceived(QList<QByteArray>)),
-            this, SLOT(configMessageReceived(QList<QByteArray>)));
+    connect(m_configSocket, SIGNAL(framesReceived(ThreadedZMQFrameList)),
+            this, SLOT(configMessageReceived(ThreadedZMQFrameList)));
 
     return true;
 }
@@ -396,16 +392,9 @@ void QApplicationConfig::disconnectSocket()
         m_configSocket->deleteLater();
         m_configSocket = NULL;
     }
-
-    if (m_context != NULL)
-    {
-        m_context->stop();
-        m_context->deleteLater();
-        m_context = NULL;
-    }
 }
 
-void QApplicationConfig::configMessageReceived(QList<QByteArray> messageList)
+void QApplicationConfig::configMessageReceived(const ThreadedZMQFrameList &messageList)
 {
     m_rx.ParseFromArray(messageList.at(0).data(), messageList.at(0).size());
 
@@ -419,9 +408,7 @@ void QApplicationConfig::configMessageReceived(QList<QByteArray> messageList)
     {
         for (int i = 0; i < m_rx.app_size(); ++i)
         {
-            pb::Application app;
-
-            app = m_rx.app(i);
+            const pb::Application &app = m_rx.app(i);
 
             QApplicationConfigItem::ApplicationType type;
             QString name;
@@ -452,9 +439,7 @@ void QApplicationConfig::configMessageReceived(QList<QByteArray> messageList)
     {
         for (int i = 0; i < m_rx.app_size(); ++i)
         {
-            pb::Application app;
-
-            app = m_rx.app(i);
+            const pb::Application &app = m_rx.app(i);
 
             QApplicationConfigItem::ApplicationType type;
 
@@ -487,11 +472,10 @@ void QApplicationConfig::configMessageReceived(QList<QByteArray> messageList)
 
                 for (int j = 0; j < app.file_size(); ++j)
                 {
-                    pb::File file;
+                    const pb::File &file = app.file(j);
                     QString filePath;
                     QByteArray data;
 
-                    file = app.file(j);
                     filePath = baseFilePath + QString::fromStdString(file.name());
 
                     QFileInfo fileInfo(filePath);
@@ -546,14 +530,14 @@ void QApplicationConfig::configMessageReceived(QList<QByteArray> messageList)
     }
 }
 
-void QApplicationConfig::sendConfigMessage(const QByteArray &data)
+void QApplicationConfig::sendConfigMessage(const pb::Container &container)
 {
     if (m_configSocket == NULL) {  // disallow sending messages when not connected
         return;
     }
 
     try {
-        m_configSocket->sendMessage(data);
+        m_configSocket->sendMessage(container);
     }
     catch (const zmq::error_t &e) {
         QString errorString;
@@ -583,7 +567,7 @@ void QApplicationConfig::request(pb::ContainerType type)
     qDebug() << "request:" << QString::fromStdString(s);
 #endif
 
-    sendConfigMessage(QByteArray(m_tx.SerializeAsString().c_str(), m_tx.ByteSize()));
+    sendConfigMessage(m_tx);
     m_tx.Clear();
 }
 
@@ -28,6 +28,7 @@
 #include <QCoreApplication>
 #include <QDir>
 #include <nzmqt/nzmqt.hpp>
+#include <transportmanager.h>
 #include <google/protobuf/text_format.h>
 #include "qapplicationconfigitem.h"
 #include "qapplicationconfigfilter.h"
@@ -109,8 +110,7 @@ private:
     QList<QApplicationConfigItem*> m_configs;
     QApplicationConfigFilter *m_filter;
 
-    PollingZMQContext *m_context;
-    ZMQSocket *m_configSocket;
+    ThreadedZMQSocket *m_configSocket;
     // more efficient to reuse a protobuf Message
     pb::Container m_rx;
     pb::Container m_tx;
@@ -119,13 +119,13 @@ private:
     void stop();
     void updateState(State state);
     void updateError(ConnectionError error, QString errorString);
-    void sendConfigMessage(const QByteArray &data);
+    void sendConfigMessage(const pb::Container &container);
     void cleanupFiles();
 
 private slots:
     bool connectSocket();
     void disconnectSocket();
-    void configMessageReceived(QList<QByteArray> messageList);
+    void configMessageReceived(const ThreadedZMQFrameList &messageList);
     void pollError(int errorNum, const QString &errorMsg);
     void request(pb::ContainerType type);
 
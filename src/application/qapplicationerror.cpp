@@ -32,8 +32,8 @@ QApplicationError::QApplicationError(QObject *parent) :
     m_error(NoError),
     m_errorString(""),
     m_channels(ErrorChannel | TextChannel | DisplayChannel),
-    m_context(NULL),
     m_errorSocket(NULL),
+    m_errorDecoder(NULL),
     m_errorHeartbeatTimer(new QTimer(this))
 {
    connect(m_errorHeartbeatTimer, SIGNAL(timeout()),
@@ -146,36 +146,37 @@ void QApplicationError::updateError(QApplicationError::ConnectionError error, co
     }
 }
 
-void QApplicationError::errorMessageReceived(const QList<QByteArray> &messageList)
+void QApplicationError::errorMessageDecoded(const QByteArray &topic, const ContainerPointer &container)
 {
-    QByteArray topic;
+    const pb::Container &rx = *container;
 
-    topic = messageList.at(0);
-    m_rx.ParseFromArray(messageList.at(1).data(), messageList.at(1).size());
+    if (sender() != m_errorDecoder) {  // decoded before the socket was disconnected
+        return;
+    }
 
 #ifdef QT_DEBUG
     std::string s;
-    gpb::TextFormat::PrintToString(m_rx, &s);
+    gpb::TextFormat::PrintToString(rx, &s);
     DEBUG_TAG(3, "error", "update" << topic << QString::fromStdString(s))
 #endif
 
-    if ((m_rx.type() == pb::MT_EMC_NML_ERROR)
-        || (m_rx.type() == pb::MT_EMC_NML_TEXT)
-        || (m_rx.type() == pb::MT_EMC_NML_DISPLAY)
-        || (m_rx.type() == pb::MT_EMC_OPERATOR_TEXT)
-        || (m_rx.type() == pb::MT_EMC_OPERATOR_ERROR)
-        || (m_rx.type() == pb::MT_EMC_OPERATOR_DISPLAY))
+    if ((rx.type() == pb::MT_EMC_NML_ERROR)
+        || (rx.type() == pb::MT_EMC_NML_TEXT)
+        || (rx.type() == pb::MT_EMC_NML_DISPLAY)
+        || (rx.type() == pb::MT_EMC_OPERATOR_TEXT)
+        || (rx.type() == pb::MT_EMC_OPERATOR_ERROR)
+        || (rx.type() == pb::MT_EMC_OPERATOR_DISPLAY))
     {
-        for (int i = 0; i < m_rx.note_size(); ++i)
+        for (int i = 0; i < rx.note_size(); ++i)
         {
-            messageReceived((ErrorType)m_rx.type(), QString::fromStdString(m_rx.note(i)));
+            messageReceived((ErrorType)rx.type(), QString::fromStdString(rx.note(i)));
         }
 
         refreshErrorHeartbeat();
 
         return;
     }
-    else if (m_rx.type() == pb::MT_PING)
+    else if (rx.type() == pb::MT_PING)
     {
         if (m_errorSocketState == Up)
         {
@@ -196,9 +197,9 @@ void QApplicationError::errorMessageReceived(const QList<QByteArray> &messageLis
             }
         }
 
-        if (m_rx.has_pparams())
+        if (rx.has_pparams())
         {
-            pb::ProtocolParameters pparams = m_rx.pparams();
+            const pb::ProtocolParameters &pparams = rx.pparams();
             startErrorHeartbeat(pparams.keepalive_timer() * 2); // wait double the time of the hearbeat interval
         }
 
@@ -206,7 +207,7 @@ void QApplicationError::errorMessageReceived(const QList<QByteArray> &messageLis
     }
 
 #ifdef QT_DEBUG
-    gpb::TextFormat::PrintToString(m_rx, &s);
+    gpb::TextFormat::PrintToString(rx, &s);
     DEBUG_TAG(1, "error", "update: unknown message type: " << QString::fromStdString(s))
 #endif
 }
@@ -231,12 +232,9 @@ void QApplicationError::errorHeartbeatTimerTick()
 /** Connects the 0MQ sockets */
 bool QApplicationError::connectSockets()
 {
-    m_context = new PollingZMQContext(this, 1);
-    connect(m_context, SIGNAL(pollError(int,QString)),
+    m_errorSocket = TransportManager::instance()->createSocket(ZMQSocket::TYP_SUB, "error", this);
+    connect(m_errorSocket, SIGNAL(receiveError(int,QString)),
             this, SLOT(pollError(int,QString)));
-    m_context->start();
-
-    m_errorSocket = m_context->createSocket(ZMQSocket::TYP_SUB, this);
     m_errorSocket->setLinger(0);
 
     try {
@@ -249,8 +247,10 @@ bool QApplicationError::connectSockets()
         return false;
     }
 
-    connect(m_errorSocket, SIGNAL(messageReceived(QList<QByteArray>)),
-            this, SLOT(errorMessageReceived(QList<QByteArray>)));
+    m_errorDecoder = new MessageDecoder();
+    connect(m_errorDecoder, SIGNAL(messageDecoded(QByteArray,ContainerPointer)),
+            this, SLOT(errorMessageDecoded(QByteArray,ContainerPointer)));
+    TransportManager::instance()->attachDecoder(m_errorSocket, m_errorDecoder);
 
 #ifdef QT_DEBUG
     DEBUG_TAG(1, "error", "socket connected" << m_errorUri)
@@ -269,13 +269,7 @@ void QApplicationError::disconnectSockets()
         m_errorSocket->close();
         m_errorSocket->deleteLater();
         m_errorSocket = NULL;
-    }
-
-    if (m_context != NULL)
-    {
-        m_context->stop();
-        m_context->deleteLater();
-        m_context = NULL;
+        m_errorDecoder = NULL; // deleted with the socket
     }
 }
 
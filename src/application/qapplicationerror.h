@@ -27,6 +27,7 @@
 #include <QStringList>
 #include <QTimer>
 #include <nzmqt/nzmqt.hpp>
+#include <transportmanager.h>
 #include <google/protobuf/text_format.h>
 #include <machinetalk/protobuf/message.pb.h>
 
@@ -148,12 +149,10 @@ private:
     QString         m_errorString;
     ErrorChannels   m_channels;
 
-    PollingZMQContext *m_context;
-    ZMQSocket   *m_errorSocket;
+    ThreadedZMQSocket   *m_errorSocket;
+    MessageDecoder      *m_errorDecoder;
     QStringList  m_subscriptions;
     QTimer      *m_errorHeartbeatTimer;
-    // more efficient to reuse a protobuf Message
-    pb::Container   m_rx;
 
     void start();
     void stop();
@@ -166,7 +165,7 @@ private:
     void updateError(ConnectionError error, const QString &errorString);
 
 private slots:
-    void errorMessageReceived(const QList<QByteArray> &messageList);
+    void errorMessageDecoded(const QByteArray &topic, const ContainerPointer &container);
     void pollError(int errorNum, const QString &errorMsg);
     void errorHeartbeatTimerTick();
 
@@ -15,7 +15,6 @@ QApplicationLauncher::QApplicationLauncher(QObject *parent) :
     m_errorString(""),
     m_launchers(QJsonValue(QJsonArray())),
     m_synced(false),
-    m_context(NULL),
     m_subscribeSocket(NULL),
     m_commandSocket(NULL),
     m_commandHeartbeatTimer(new QTimer(this)),
@@ -102,16 +101,15 @@ void QApplicationLauncher::shutdown()
 /** Connects the 0MQ sockets */
 bool QApplicationLauncher::connectSockets()
 {
-    m_context = new PollingZMQContext(this, 1);
-    connect(m_context, SIGNAL(pollError(int,QString)),
+    m_commandSocket = TransportManager::instance()->createSocket(ZMQSocket::TYP_DEALER, "launchercmd", this);
+    connect(m_commandSocket, SIGNAL(receiveError(int,QString)),
             this, SLOT(pollError(int,QString)));
-    m_context->start();
-
-    m_commandSocket = m_context->createSocket(ZMQSocket::TYP_DEALER, this);
     m_commandSocket->setLinger(0);
     m_commandSocket->setIdentity(QString("%1-%2").arg(m_commandIdentity).arg(QCoreApplication::applicationPid()).toLocal8Bit());
 
-    m_subscribeSocket = m_context->createSocket(ZMQSocket::TYP_SUB, this);
+    m_subscribeSocket = TransportManager::instance()->createSocket(ZMQSocket::TYP_SUB, "launcher", this);
+    connect(m_subscribeSocket, SIGNAL(receiveError(int,QString)),
+            this, SLOT(pollError(int,QString)));
     m_subscribeSocket->setLinger(0);
 
     try {
@@ -125,10 +123,10 @@ bool QApplicationLauncher::connectSockets()
         return false;
     }
 
-    connect(m_subscribeSocket, SIGNAL(messageReceived(QList<QByteArray>)),
-            this, SLOT(subscribeMessageReceived(QList<QByteArray>)));
-    connect(m_commandSocket, SIGNAL(messageReceived(QList<QByteArray>)),
-            this, SLOT(commandMessageReceived(QList<QByteArray>)));
+    connect(m_subscribeSocket, SIGNAL(framesReceived(ThreadedZMQFrameList)),
+            this, SLOT(subscribeMessageReceived(ThreadedZMQFrameList)));
+    connect(m_commandSocket, SIGNAL(framesReceived(ThreadedZMQFrameList)),
+            this, SLOT(commandMessageReceived(ThreadedZMQFrameList)));
 
 #ifdef QT_DEBUG
     DEBUG_TAG(1, m_commandIdentity, "sockets connected" << m_subscribeUri << m_commandUri)
@@ -156,13 +154,6 @@ void QApplicationLauncher::disconnectSockets()
         m_subscribeSocket->deleteLater();
         m_subscribeSocket = NULL;
     }
-
-    if (m_context != NULL)
-    {
-        m_context->stop();
-        m_context->deleteLater();
-        m_context = NULL;
-    }
 }
 
 void QApplicationLauncher::subscribe(const QString &topic)
@@ -314,11 +305,11 @@ void QApplicationLauncher::pollError(int errorNum, const QString &errorMsg)
 }
 
 /** Processes all message received on the update 0MQ socket */
-void QApplicationLauncher::subscribeMessageReceived(QList<QByteArray> messageList)
+void QApplicationLauncher::subscribeMessageReceived(const ThreadedZMQFrameList &messageList)
 {
     QByteArray topic;
 
-    topic = messageList.at(0);
+    topic = messageList.at(0).toByteArray();
     m_rx.ParseFromArray(messageList.at(1).data(), messageList.at(1).size());
 
 #ifdef QT_DEBUG
@@ -343,7 +334,7 @@ void QApplicationLauncher::subscribeMessageReceived(QList<QByteArray> messageLis
 
         if (m_rx.has_pparams())
         {
-            pb::ProtocolParameters pparams = m_rx.pparams();
+            const pb::ProtocolParameters &pparams = m_rx.pparams();
             startSubscribeHeartbeat(pparams.keepalive_timer() * 2);  // wait double the time of the hearbeat interval
         }
     }
@@ -392,7 +383,7 @@ void QApplicationLauncher::subscribeMessageReceived(QList<QByteArray> messageLis
 }
 
 /** Processes all message received on the command 0MQ socket */
-void QApplicationLauncher::commandMessageReceived(QList<QByteArray> messageList)
+void QApplicationLauncher::commandMessageReceived(const ThreadedZMQFrameList &messageList)
 {
     m_rx.ParseFromArray(messageList.at(0).data(), messageList.at(0).size());
 
@@ -452,7 +443,7 @@ void QApplicationLauncher::sendCommandMessage(pb::ContainerType type)
 
     try {
         m_tx.set_type(type);
-        m_commandSocket->sendMessage(QByteArray(m_tx.SerializeAsString().c_str(), m_tx.ByteSize()));
+        m_commandSocket->sendMessage(m_tx);
         m_tx.Clear();
     }
     catch (const zmq::error_t &e) {
@@ -27,6 +27,7 @@
 #include <service.h>
 #include <QJsonValue>
 #include <nzmqt/nzmqt.hpp>
+#include <transportmanager.h>
 #include <google/protobuf/text_format.h>
 #include <google/protobuf/message.h>
 #include <google/protobuf/descriptor.h>
@@ -152,9 +153,8 @@ private:
     QJsonValue m_launchers;
     bool m_synced;
 
-    PollingZMQContext *m_context;
-    ZMQSocket  *m_subscribeSocket;
-    ZMQSocket  *m_commandSocket;
+    ThreadedZMQSocket  *m_subscribeSocket;
+    ThreadedZMQSocket  *m_commandSocket;
     QTimer     *m_commandHeartbeatTimer;
     QTimer     *m_subscribeHeartbeatTimer;
     bool        m_commandPingOutstanding;
@@ -179,8 +179,8 @@ private:
     void initializeObject();
 
 private slots:
-    void subscribeMessageReceived(QList<QByteArray> messageList);
-    void commandMessageReceived(QList<QByteArray> messageList);
+    void subscribeMessageReceived(const ThreadedZMQFrameList &messageList);
+    void commandMessageReceived(const ThreadedZMQFrameList &messageList);
     void pollError(int errorNum, const QString& errorMsg);
     void commandHeartbeatTimerTick();
     void subscribeHeartbeatTimerTick();
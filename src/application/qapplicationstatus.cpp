@@ -22,6 +22,30 @@
 
 #include "qapplicationstatus.h"
 #include "debughelper.h"
+#include <QMetaMethod>
+
+static const QApplicationStatus::StatusChannel statusChannels[] = {
+    QApplicationStatus::MotionChannel,
+    QApplicationStatus::ConfigChannel,
+    QApplicationStatus::IoChannel,
+    QApplicationStatus::TaskChannel,
+    QApplicationStatus::InterpChannel
+};
+static const int statusChannelCount = sizeof(statusChannels) / sizeof(statusChannels[0]);
+
+static const char *channelTopic(QApplicationStatus::StatusChannel channel)
+{
+    switch (channel)
+    {
+    case QApplicationStatus::MotionChannel: return "motion";
+    case QApplicationStatus::ConfigChannel: return "config";
+    case QApplicationStatus::IoChannel:     return "io";
+    case QApplicationStatus::TaskChannel:   return "task";
+    case QApplicationStatus::InterpChannel: return "interp";
+    }
+
+    return "";
+}
 
 QApplicationStatus::QApplicationStatus(QObject *parent) :
     AbstractServiceImplementation(parent),
@@ -31,21 +55,67 @@ QApplicationStatus::QApplicationStatus(QObject *parent) :
     m_connectionState(Disconnected),
     m_error(NoError),
     m_errorString(""),
+    m_configFields(new QApplicationStatusFields(this)),
+    m_motionFields(new QApplicationStatusFields(this)),
+    m_ioFields(new QApplicationStatusFields(this)),
+    m_taskFields(new QApplicationStatusFields(this)),
+    m_interpFields(new QApplicationStatusFields(this)),
+    m_position(new QApplicationStatusPosition(this)),
+    m_actualPosition(new QApplicationStatusPosition(this)),
+    m_dtg(new QApplicationStatusPosition(this)),
+    m_g5xOffset(new QApplicationStatusPosition(this)),
+    m_g92Offset(new QApplicationStatusPosition(this)),
+    m_toolOffset(new QApplicationStatusPosition(this)),
     m_running(false),
     m_synced(false),
+    m_syncedChannels(0),
     m_channels(MotionChannel | ConfigChannel | IoChannel | TaskChannel | InterpChannel),
-    m_context(NULL),
+    m_coalesceNotifications(false),
+    m_notificationTimer(new QTimer(this)),
+    m_pendingChannels(0),
+    m_autoSubscribe(false),
+    m_unsubscribeTimer(new QTimer(this)),
+    m_subscribedChannels(0),
+    m_statisticsTimer(new QTimer(this)),
     m_statusSocket(NULL),
+    m_statusDecoder(NULL),
     m_statusHeartbeatTimer(new QTimer(this))
 {
     connect(m_statusHeartbeatTimer, SIGNAL(timeout()),
             this, SLOT(statusHeartbeatTimerTick()));
 
-    connect(this, SIGNAL(taskChanged(QJsonObject)),
-            this, SLOT(updateRunning(QJsonObject)));
-    connect(this, SIGNAL(interpChanged(QJsonObject)),
-            this, SLOT(updateRunning(QJsonObject)));
-
+    m_notificationTimer->setInterval(16);
+    m_notificationTimer->setSingleShot(true);
+    connect(m_notificationTimer, SIGNAL(timeout()),
+            this, SLOT(flushNotifications()));
+
+    m_unsubscribeTimer->setInterval(5000);
+    m_unsubscribeTimer->setSingleShot(true);
+    connect(m_unsubscribeTimer, SIGNAL(timeout()),
+            this, SLOT(unsubscribeUnused()));
+
+    m_statisticsTimer->setInterval(1000);
+    connect(m_statisticsTimer, SIGNAL(timeout()),
+            this, SLOT(sampleStatistics()));
+
+    watchUsage(m_motionFields, MotionChannel);
+    watchUsage(m_configFields, ConfigChannel);
+    watchUsage(m_ioFields, IoChannel);
+    watchUsage(m_taskFields, TaskChannel);
+    watchUsage(m_interpFields, InterpChannel);
+    watchUsage(m_position, MotionChannel);
+    watchUsage(m_actualPosition, MotionChannel);
+    watchUsage(m_dtg, MotionChannel);
+    watchUsage(m_g5xOffset, MotionChannel);
+    watchUsage(m_g92Offset, MotionChannel);
+    watchUsage(m_toolOffset, IoChannel);
+
+    for (int i = 0; i < QApplicationStatusPosition::AxisCount; ++i)
+    {
+        QApplicationStatusAxis *axis = new QApplicationStatusAxis(this);
+        watchUsage(axis, MotionChannel);
+        m_axes.append(axis);
+    }
 
     initializeObject(MotionChannel);
     initializeObject(ConfigChannel);
@@ -84,7 +154,7 @@ void QApplicationStatus::cleanup()
         unsubscribe();
     }
     disconnectSockets();
-    m_subscriptions.clear();
+    m_subscribedChannels = 0;
 }
 
 void QApplicationStatus::startStatusHeartbeat(int interval)
@@ -170,103 +240,165 @@ void QApplicationStatus::updateError(QApplicationStatus::ConnectionError error,
 
 void QApplicationStatus::updateSync(QApplicationStatus::StatusChannel channel)
 {
-    m_syncedChannels |= channel;
-
-    if (m_syncedChannels == m_channels) {
-        m_synced = true;
-        emit syncedChanged(m_synced);
-    }
+    flushNotifications();   // synced must not be seen before the values
+    updateSyncedChannels(m_syncedChannels | channel);
 }
 
 void QApplicationStatus::clearSync()
 {
-    m_synced = false;
-    m_syncedChannels = 0;
-    emit syncedChanged(m_synced);
+    updateSyncedChannels(0);
 }
 
-void QApplicationStatus::updateMotion(const pb::EmcStatusMotion &motion)
+/** Sets the synced channels and updates synced,
+ *  also called when the subscribed channels change.
+ **/
+void QApplicationStatus::updateSyncedChannels(StatusChannels channels)
 {
-    Service::recurseMessage(motion, &m_motion);
-    emit motionChanged(m_motion);
+    StatusChannels changed = m_syncedChannels ^ channels;
+    m_syncedChannels = channels;
+
+    if (changed != 0)
+    {
+        emit syncedChannelsChanged(m_syncedChannels);
+
+        if (changed & MotionChannel) {
+            emit motionSyncedChanged(isMotionSynced());
+        }
+        if (changed & ConfigChannel) {
+            emit configSyncedChanged(isConfigSynced());
+        }
+        if (changed & IoChannel) {
+            emit ioSyncedChanged(isIoSynced());
+        }
+        if (changed & TaskChannel) {
+            emit taskSyncedChanged(isTaskSynced());
+        }
+        if (changed & InterpChannel) {
+            emit interpSyncedChanged(isInterpSynced());
+        }
+    }
+
+    bool synced = (m_subscribedChannels != 0) && (m_syncedChannels == m_subscribedChannels);
+    if (synced != m_synced)
+    {
+        m_synced = synced;
+        emit syncedChanged(m_synced);
+    }
 }
 
-void QApplicationStatus::updateConfig(const pb::EmcStatusConfig &config)
+void QApplicationStatus::updateMotion(const pb::EmcStatusMotion &motion, const QJsonObject &object, const QStringList &updatedFields)
 {
-    Service::recurseMessage(config, &m_config);
-    emit configChanged(m_config);
+    m_motion = object;
+
+    // the typed objects notify their changes with the channel
+    if (motion.has_position()) {
+        m_position->merge(motion.position());
+    }
+    if (motion.has_actual_position()) {
+        m_actualPosition->merge(motion.actual_position());
+    }
+    if (motion.has_dtg()) {
+        m_dtg->merge(motion.dtg());
+    }
+    if (motion.has_g5x_offset()) {
+        m_g5xOffset->merge(motion.g5x_offset());
+    }
+    if (motion.has_g92_offset()) {
+        m_g92Offset->merge(motion.g92_offset());
+    }
+    for (int i = 0; i < motion.axis_size(); ++i)
+    {
+        const pb::EmcStatusMotionAxis &axis = motion.axis(i);
+        if ((axis.index() >= 0) && (axis.index() < m_axes.size())) {
+            m_axes.at(axis.index())->merge(axis);
+        }
+    }
+
+    emit motionSampled(m_motion);
+    notifyChannel(MotionChannel, updatedFields);
 }
 
-void QApplicationStatus::updateIo(const pb::EmcStatusIo &io)
+void QApplicationStatus::updateConfig(const QJsonObject &object, const QStringList &updatedFields)
 {
-    Service::recurseMessage(io, &m_io);
-    emit ioChanged(m_io);
+    m_config = object;
+    emit configSampled(m_config);
+    notifyChannel(ConfigChannel, updatedFields);
 }
 
-void QApplicationStatus::updateTask(const pb::EmcStatusTask &task)
+void QApplicationStatus::updateIo(const pb::EmcStatusIo &io, const QJsonObject &object, const QStringList &updatedFields)
 {
-    Service::recurseMessage(task, &m_task);
-    emit taskChanged(m_task);
+    m_io = object;
+
+    if (io.has_tool_offset()) {
+        m_toolOffset->merge(io.tool_offset());
+    }
+
+    emit ioSampled(m_io);
+    notifyChannel(IoChannel, updatedFields);
 }
 
-void QApplicationStatus::updateInterp(const pb::EmcStatusInterp &interp)
+void QApplicationStatus::updateTask(const QJsonObject &object, const QStringList &updatedFields)
 {
-    Service::recurseMessage(interp, &m_interp);
-    emit interpChanged(m_interp);
+    m_task = object;
+    emit taskSampled(m_task);
+    notifyChannel(TaskChannel, updatedFields);
 }
 
-void QApplicationStatus::statusMessageReceived(const QList<QByteArray> &messageList)
+void QApplicationStatus::updateInterp(const QJsonObject &object, const QStringList &updatedFields)
 {
-    QByteArray topic;
+    m_interp = object;
+    emit interpSampled(m_interp);
+    notifyChannel(InterpChannel, updatedFields);
+}
 
-    topic = messageList.at(0);
-    m_rx.ParseFromArray(messageList.at(1).data(), messageList.at(1).size());
+/** Takes over a status update decoded on the decoder thread */
+void QApplicationStatus::statusMessageDecoded(const QByteArray &topic, const ContainerPointer &container, int size, const QApplicationStatusUpdate &update)
+{
+    const pb::Container &rx = *container;
 
-#ifdef QT_DEBUG
-    std::string s;
-    gpb::TextFormat::PrintToString(m_rx, &s);
-    DEBUG_TAG(3, "status", "update" << topic << QString::fromStdString(s))
-#endif
+    if (sender() != m_statusDecoder) {  // decoded before the socket was disconnected
+        return;
+    }
 
-    if ((m_rx.type() == pb::MT_EMCSTAT_FULL_UPDATE)
-        || (m_rx.type() == pb::MT_EMCSTAT_INCREMENTAL_UPDATE))
+    for (int i = 0; i < statusChannelCount; ++i)
     {
-        if ((topic == "motion") && m_rx.has_emc_status_motion()) {
-            updateMotion(m_rx.emc_status_motion());
-            if (m_rx.type() == pb::MT_EMCSTAT_FULL_UPDATE) {
-                updateSync(MotionChannel);
-            }
-        }
-
-        if ((topic == "config") && m_rx.has_emc_status_config()) {
-            updateConfig(m_rx.emc_status_config());
-            if (m_rx.type() == pb::MT_EMCSTAT_FULL_UPDATE) {
-                updateSync(ConfigChannel);
-            }
+        if (topic == channelTopic(statusChannels[i])) {
+            m_channelBytes[statusChannels[i]] += size;
+            break;
         }
+    }
 
-        if ((topic == "io") && m_rx.has_emc_status_io()) {
-            updateIo(m_rx.emc_status_io());
-            if (m_rx.type() == pb::MT_EMCSTAT_FULL_UPDATE) {
-                updateSync(IoChannel);
+    if ((rx.type() == pb::MT_EMCSTAT_FULL_UPDATE)
+        || (rx.type() == pb::MT_EMCSTAT_INCREMENTAL_UPDATE))
+    {
+        // updates based on a channel state that was reset in the meantime are dropped
+        if ((update.channel != 0) && (update.generation == m_generations.value(update.channel, 0)))
+        {
+            switch (update.channel)
+            {
+            case MotionChannel:
+                updateMotion(rx.emc_status_motion(), update.object, update.updatedFields);
+                break;
+            case ConfigChannel:
+                updateConfig(update.object, update.updatedFields);
+                break;
+            case IoChannel:
+                updateIo(rx.emc_status_io(), update.object, update.updatedFields);
+                break;
+            case TaskChannel:
+                updateTask(update.object, update.updatedFields);
+                break;
+            case InterpChannel:
+                updateInterp(update.object, update.updatedFields);
+                break;
             }
-        }
 
-        if ((topic == "task") && m_rx.has_emc_status_task()) {
-            updateTask(m_rx.emc_status_task());
-            if (m_rx.type() == pb::MT_EMCSTAT_FULL_UPDATE) {
-                updateSync(TaskChannel);
+            if (rx.type() == pb::MT_EMCSTAT_FULL_UPDATE) {
+                updateSync(static_cast<StatusChannel>(update.channel));
             }
         }
 
-        if ((topic == "interp") && m_rx.has_emc_status_interp()) {
-            updateInterp(m_rx.emc_status_interp());
-            if (m_rx.type() == pb::MT_EMCSTAT_FULL_UPDATE) {
-                updateSync(InterpChannel);
-            }
-        }
-
-        if (m_rx.type() == pb::MT_EMCSTAT_FULL_UPDATE)
+        if (rx.type() == pb::MT_EMCSTAT_FULL_UPDATE)
         {
             if (m_statusSocketState != Up)
             {
@@ -274,9 +406,9 @@ void QApplicationStatus::statusMessageReceived(const QList<QByteArray> &messageL
                 updateState(Connected);
             }
 
-            if (m_rx.has_pparams())
+            if (rx.has_pparams())
             {
-                pb::ProtocolParameters pparams = m_rx.pparams();
+                const pb::ProtocolParameters &pparams = rx.pparams();
                 startStatusHeartbeat(pparams.keepalive_timer() * 2); // wait double the time of the hearbeat interval
             }
         }
@@ -287,7 +419,7 @@ void QApplicationStatus::statusMessageReceived(const QList<QByteArray> &messageL
 
         return;
     }
-    else if (m_rx.type() == pb::MT_PING)
+    else if (rx.type() == pb::MT_PING)
     {
         if (m_statusSocketState == Up)
         {
@@ -304,7 +436,8 @@ void QApplicationStatus::statusMessageReceived(const QList<QByteArray> &messageL
     }
 
 #ifdef QT_DEBUG
-    gpb::TextFormat::PrintToString(m_rx, &s);
+    std::string s;
+    gpb::TextFormat::PrintToString(rx, &s);
     DEBUG_TAG(1, "status", "update: unknown message type: " << QString::fromStdString(s))
 #endif
 }
@@ -329,12 +462,9 @@ void QApplicationStatus::statusHeartbeatTimerTick()
 /** Connects the 0MQ sockets */
 bool QApplicationStatus::connectSockets()
 {
-    m_context = new PollingZMQContext(this, 1);
-    connect(m_context, SIGNAL(pollError(int,QString)),
+    m_statusSocket = TransportManager::instance()->createSocket(ZMQSocket::TYP_SUB, "status", this);
+    connect(m_statusSocket, SIGNAL(receiveError(int,QString)),
             this, SLOT(pollError(int,QString)));
-    m_context->start();
-
-    m_statusSocket = m_context->createSocket(ZMQSocket::TYP_SUB, this);
     m_statusSocket->setLinger(0);
 
     try {
@@ -347,8 +477,13 @@ bool QApplicationStatus::connectSockets()
         return false;
     }
 
-    connect(m_statusSocket, SIGNAL(messageReceived(QList<QByteArray>)),
-            this, SLOT(statusMessageReceived(QList<QByteArray>)));
+    m_statusDecoder = new QApplicationStatusDecoder();
+    for (int i = 0; i < statusChannelCount; ++i) {
+        m_statusDecoder->reset(statusChannels[i], m_generations.value(statusChannels[i], 0));
+    }
+    connect(m_statusDecoder, SIGNAL(statusDecoded(QByteArray,ContainerPointer,int,QApplicationStatusUpdate)),
+            this, SLOT(statusMessageDecoded(QByteArray,ContainerPointer,int,QApplicationStatusUpdate)));
+    TransportManager::instance()->attachDecoder(m_statusSocket, m_statusDecoder);
 
 #ifdef QT_DEBUG
     DEBUG_TAG(1, "status", "socket connected" << m_statusUri)
@@ -369,65 +504,21 @@ void QApplicationStatus::disconnectSockets()
         m_statusSocket = NULL;
     }
 
-    if (m_context != NULL)
-    {
-        m_context->stop();
-        m_context->deleteLater();
-        m_context = NULL;
-    }
+    m_statusDecoder = NULL;     // deleted with the socket
 }
 
 void QApplicationStatus::subscribe()
 {
     m_statusSocketState = Trying;
 
-    if (m_channels | MotionChannel) {
-        m_statusSocket->subscribeTo("motion");
-        m_subscriptions.append("motion");
-    }
-    if (m_channels | ConfigChannel) {
-        m_statusSocket->subscribeTo("config");
-        m_subscriptions.append("config");
-    }
-    if (m_channels | TaskChannel) {
-        m_statusSocket->subscribeTo("task");
-        m_subscriptions.append("task");
-    }
-    if (m_channels | IoChannel) {
-        m_statusSocket->subscribeTo("io");
-        m_subscriptions.append("io");
-    }
-    if (m_channels | InterpChannel) {
-        m_statusSocket->subscribeTo("interp");
-        m_subscriptions.append("interp");
-    }
+    subscribeChannels(usedChannels());
 }
 
 void QApplicationStatus::unsubscribe()
 {
     m_statusSocketState = Down;
 
-    foreach (QString subscription, m_subscriptions)
-    {
-        m_statusSocket->unsubscribeFrom(subscription);
-
-        if (subscription == "motion") {
-            initializeObject(MotionChannel);
-        }
-        else if (subscription == "config") {
-            initializeObject(ConfigChannel);
-        }
-        else if (subscription == "io") {
-            initializeObject(IoChannel);
-        }
-        else if (subscription == "task") {
-            initializeObject(TaskChannel);
-        }
-        else if (subscription == "interp") {
-            initializeObject(InterpChannel);
-        }
-    }
-    m_subscriptions.clear();
+    unsubscribeChannels(m_subscribedChannels);
 }
 
 void QApplicationStatus::updateRunning(const QJsonObject &object)
@@ -450,32 +541,462 @@ void QApplicationStatus::updateRunning(const QJsonObject &object)
 
 void QApplicationStatus::initializeObject(QApplicationStatus::StatusChannel channel)
 {
+    int generation = m_generations.value(channel, 0) + 1;
+
+    m_generations.insert(channel, generation);
+    if (m_statusDecoder != NULL) {
+        QMetaObject::invokeMethod(m_statusDecoder, "reset", Qt::QueuedConnection,
+                                  Q_ARG(int, channel), Q_ARG(int, generation));
+    }
+
+    m_pendingChannels &= ~channel;
+    m_pendingFields.remove(channel);
+
     switch (channel)
     {
     case MotionChannel:
         m_motion = QJsonObject();
         Service::recurseDescriptor(pb::EmcStatusMotion::descriptor(), &m_motion);
+        m_position->clear();
+        m_actualPosition->clear();
+        m_dtg->clear();
+        m_g5xOffset->clear();
+        m_g92Offset->clear();
+        foreach (QApplicationStatusAxis *axis, m_axes) {
+            axis->clear();
+        }
+        updateFields(m_motionFields, m_motion, m_motion.keys());
         emit motionChanged(m_motion);
         return;
     case ConfigChannel:
         m_config = QJsonObject();
         Service::recurseDescriptor(pb::EmcStatusConfig::descriptor(), &m_config);
+        updateFields(m_configFields, m_config, m_config.keys());
         emit configChanged(m_config);
         return;
     case IoChannel:
         m_io = QJsonObject();
         Service::recurseDescriptor(pb::EmcStatusIo::descriptor(), &m_io);
+        m_toolOffset->clear();
+        updateFields(m_ioFields, m_io, m_io.keys());
         emit ioChanged(m_io);
         return;
     case TaskChannel:
         m_task = QJsonObject();
         Service::recurseDescriptor(pb::EmcStatusTask::descriptor(), &m_task);
+        updateFields(m_taskFields, m_task, m_task.keys());
         emit taskChanged(m_task);
         return;
     case InterpChannel:
         m_interp = QJsonObject();
         Service::recurseDescriptor(pb::EmcStatusInterp::descriptor(), &m_interp);
+        updateFields(m_interpFields, m_interp, m_interp.keys());
+        emit interpChanged(m_interp);
+        return;
+    }
+}
+
+/** Updates the given fields of a property map, only fields with a
+ *  different value are written to not wake up unrelated bindings.
+ **/
+void QApplicationStatus::updateFields(QQmlPropertyMap *fields, const QJsonObject &object, const QStringList &names)
+{
+    foreach (const QString &name, names)
+    {
+        QVariant value = object.value(name).toVariant();
+
+        if (fields->value(name) != value)
+        {
+            fields->insert(name, value);
+        }
+    }
+}
+
+void QApplicationStatus::notifyChannel(QApplicationStatus::StatusChannel channel, const QStringList &updatedFields)
+{
+    if (!m_coalesceNotifications)
+    {
+        emitChannelChanged(channel, updatedFields);
+        return;
+    }
+
+    m_pendingFields[channel].unite(updatedFields.toSet());
+    m_pendingChannels |= channel;
+    scheduleNotifications();
+}
+
+void QApplicationStatus::emitChannelChanged(QApplicationStatus::StatusChannel channel, const QStringList &updatedFields)
+{
+    switch (channel)
+    {
+    case MotionChannel:
+        updateFields(m_motionFields, m_motion, updatedFields);
+        m_position->notify();
+        m_actualPosition->notify();
+        m_dtg->notify();
+        m_g5xOffset->notify();
+        m_g92Offset->notify();
+        foreach (QApplicationStatusAxis *axis, m_axes) {
+            axis->notify();
+        }
+        emit motionChanged(m_motion);
+        return;
+    case ConfigChannel:
+        updateFields(m_configFields, m_config, updatedFields);
+        emit configChanged(m_config);
+        return;
+    case IoChannel:
+        updateFields(m_ioFields, m_io, updatedFields);
+        m_toolOffset->notify();
+        emit ioChanged(m_io);
+        return;
+    case TaskChannel:
+        updateFields(m_taskFields, m_task, updatedFields);
+        emit taskChanged(m_task);
+        updateRunning(m_task);
+        return;
+    case InterpChannel:
+        updateFields(m_interpFields, m_interp, updatedFields);
         emit interpChanged(m_interp);
+        updateRunning(m_interp);
         return;
     }
 }
+
+void QApplicationStatus::scheduleNotifications()
+{
+    if (!m_notificationWindow.isNull() && m_notificationWindow->isExposed())
+    {
+        m_notificationWindow->update();     // afterAnimating is only emitted for rendered frames
+    }
+    else if (!m_notificationTimer->isActive())
+    {
+        m_notificationTimer->start();
+    }
+}
+
+/** Emits the change notifications of all merged updates */
+void QApplicationStatus::flushNotifications()
+{
+    m_notificationTimer->stop();
+
+    if (m_pendingChannels == 0)
+    {
+        return;
+    }
+
+    for (int i = 0; i < statusChannelCount; ++i)
+    {
+        if (m_pendingChannels & statusChannels[i])
+        {
+            QStringList updatedFields = m_pendingFields.take(statusChannels[i]).toList();
+            m_pendingChannels &= ~statusChannels[i];
+            emitChannelChanged(statusChannels[i], updatedFields);
+        }
+    }
+}
+
+void QApplicationStatus::setCoalesceNotifications(bool arg)
+{
+    if (m_coalesceNotifications == arg)
+        return;
+
+    m_coalesceNotifications = arg;
+    emit coalesceNotificationsChanged(arg);
+
+    if (!arg)
+    {
+        flushNotifications();
+    }
+}
+
+void QApplicationStatus::setNotificationInterval(int arg)
+{
+    if (m_notificationTimer->interval() == arg)
+        return;
+
+    m_notificationTimer->setInterval(arg);
+    emit notificationIntervalChanged(arg);
+}
+
+void QApplicationStatus::setNotificationWindow(QQuickWindow *arg)
+{
+    if (m_notificationWindow == arg)
+        return;
+
+    if (!m_notificationWindow.isNull())
+    {
+        disconnect(m_notificationWindow, SIGNAL(afterAnimating()),
+                   this, SLOT(flushNotifications()));
+    }
+
+    m_notificationWindow = arg;
+
+    if (!m_notificationWindow.isNull())
+    {
+        connect(m_notificationWindow, SIGNAL(afterAnimating()),
+                this, SLOT(flushNotifications()));
+    }
+
+    emit notificationWindowChanged(arg);
+
+    if (m_pendingChannels != 0)
+    {
+        scheduleNotifications();
+    }
+}
+
+void QApplicationStatus::setChannels(StatusChannels arg)
+{
+    if (m_channels == arg)
+        return;
+
+    m_channels = arg;
+    emit channelsChanged(arg);
+
+    updateSubscriptions();
+}
+
+void QApplicationStatus::setAutoSubscribe(bool arg)
+{
+    if (m_autoSubscribe == arg)
+        return;
+
+    m_autoSubscribe = arg;
+    emit autoSubscribeChanged(arg);
+
+    updateSubscriptions();
+}
+
+void QApplicationStatus::setUnsubscribeDelay(int arg)
+{
+    if (m_unsubscribeTimer->interval() == arg)
+        return;
+
+    m_unsubscribeTimer->setInterval(arg);
+    emit unsubscribeDelayChanged(arg);
+}
+
+/** Returns the subscription state and the received bytes per second of all channels */
+QVariantList QApplicationStatus::channelStatistics() const
+{
+    QVariantList list;
+
+    for (int i = 0; i < statusChannelCount; ++i)
+    {
+        StatusChannel channel = statusChannels[i];
+        QVariantMap map;
+        map.insert("channel", QString(channelTopic(channel)));
+        map.insert("subscribed", m_subscribedChannels.testFlag(channel));
+        map.insert("users", m_channelUsers.value(channel, 0));
+        map.insert("bytesReceived", m_channelBytes.value(channel, 0));
+        map.insert("bytesPerSecond", m_channelBytesPerSecond.value(channel, 0));
+        list.append(map);
+    }
+
+    return list;
+}
+
+/** Returns the channels that should be subscribed */
+QApplicationStatus::StatusChannels QApplicationStatus::usedChannels() const
+{
+    StatusChannels channels;
+
+    if (!m_autoSubscribe) {
+        return m_channels;
+    }
+
+    for (int i = 0; i < statusChannelCount; ++i)
+    {
+        if (m_channelUsers.value(statusChannels[i], 0) > 0) {
+            channels |= statusChannels[i];
+        }
+    }
+
+    return channels & m_channels;
+}
+
+/** Returns the channels a signal of the status depends on */
+QApplicationStatus::StatusChannels QApplicationStatus::signalChannels(const QMetaMethod &signal) const
+{
+    if ((signal == QMetaMethod::fromSignal(&QApplicationStatus::motionChanged))
+        || (signal == QMetaMethod::fromSignal(&QApplicationStatus::motionSampled))) {
+        return MotionChannel;
+    }
+    else if ((signal == QMetaMethod::fromSignal(&QApplicationStatus::configChanged))
+             || (signal == QMetaMethod::fromSignal(&QApplicationStatus::configSampled))) {
+        return ConfigChannel;
+    }
+    else if ((signal == QMetaMethod::fromSignal(&QApplicationStatus::ioChanged))
+             || (signal == QMetaMethod::fromSignal(&QApplicationStatus::ioSampled))) {
+        return IoChannel;
+    }
+    else if ((signal == QMetaMethod::fromSignal(&QApplicationStatus::taskChanged))
+             || (signal == QMetaMethod::fromSignal(&QApplicationStatus::taskSampled))) {
+        return TaskChannel;
+    }
+    else if ((signal == QMetaMethod::fromSignal(&QApplicationStatus::interpChanged))
+             || (signal == QMetaMethod::fromSignal(&QApplicationStatus::interpSampled))) {
+        return InterpChannel;
+    }
+    else if (signal == QMetaMethod::fromSignal(&QApplicationStatus::runningChanged)) {
+        return StatusChannels(TaskChannel | InterpChannel);
+    }
+    else if (signal == QMetaMethod::fromSignal(&QApplicationStatus::motionSyncedChanged)) {
+        return MotionChannel;
+    }
+    else if (signal == QMetaMethod::fromSignal(&QApplicationStatus::configSyncedChanged)) {
+        return ConfigChannel;
+    }
+    else if (signal == QMetaMethod::fromSignal(&QApplicationStatus::ioSyncedChanged)) {
+        return IoChannel;
+    }
+    else if (signal == QMetaMethod::fromSignal(&QApplicationStatus::taskSyncedChanged)) {
+        return TaskChannel;
+    }
+    else if (signal == QMetaMethod::fromSignal(&QApplicationStatus::interpSyncedChanged)) {
+        return InterpChannel;
+    }
+
+    return 0;
+}
+
+void QApplicationStatus::connectNotify(const QMetaMethod &signal)
+{
+    updateUsage(signalChannels(signal), 1);
+}
+
+void QApplicationStatus::disconnectNotify(const QMetaMethod &signal)
+{
+    updateUsage(signalChannels(signal), -1);
+}
+
+void QApplicationStatus::watchUsage(QObject *object, QApplicationStatus::StatusChannel channel)
+{
+    m_channelObjects.insert(object, channel);
+    connect(object, SIGNAL(connectionsChanged(int)),
+            this, SLOT(objectConnectionsChanged(int)));
+}
+
+void QApplicationStatus::objectConnectionsChanged(int delta)
+{
+    updateUsage(m_channelObjects.value(sender()), delta);
+}
+
+void QApplicationStatus::updateUsage(StatusChannels channels, int delta)
+{
+    if (channels == 0) {
+        return;
+    }
+
+    for (int i = 0; i < statusChannelCount; ++i)
+    {
+        if (channels & statusChannels[i]) {
+            m_channelUsers[statusChannels[i]] += delta;
+        }
+    }
+
+    if (m_autoSubscribe) {
+        updateSubscriptions();
+    }
+}
+
+/** Subscribes newly used channels immediately, unused channels
+ *  are unsubscribed after the unsubscribe delay.
+ **/
+void QApplicationStatus::updateSubscriptions()
+{
+    StatusChannels channels = usedChannels();
+
+    if ((m_statusSocket == NULL) || (m_statusSocketState == Down)) {
+        return;
+    }
+
+    subscribeChannels(channels & ~m_subscribedChannels);
+
+    if ((m_subscribedChannels & ~channels) != 0)
+    {
+        if (!m_unsubscribeTimer->isActive()) {
+            m_unsubscribeTimer->start();
+        }
+    }
+    else
+    {
+        m_unsubscribeTimer->stop();
+    }
+}
+
+void QApplicationStatus::unsubscribeUnused()
+{
+    if ((m_statusSocket == NULL) || (m_statusSocketState == Down)) {
+        return;
+    }
+
+    StatusChannels channels = m_subscribedChannels & ~usedChannels();
+
+    unsubscribeChannels(channels);
+
+    for (int i = 0; i < statusChannelCount; ++i)
+    {
+        if (channels & statusChannels[i]) {
+            initializeObject(statusChannels[i]);    // data of unused channels goes stale
+        }
+    }
+
+    if (m_subscribedChannels == 0) {
+        stopStatusHeartbeat();  // no pings without subscriptions
+    }
+}
+
+void QApplicationStatus::subscribeChannels(StatusChannels channels)
+{
+    for (int i = 0; i < statusChannelCount; ++i)
+    {
+        StatusChannel channel = statusChannels[i];
+
+        if (channels & channel)
+        {
+            m_statusSocket->subscribeTo(channelTopic(channel));
+            m_subscribedChannels |= channel;
+        }
+    }
+
+    updateSyncedChannels(m_syncedChannels);    // a new channel is not synced yet
+
+    if ((m_subscribedChannels != 0) && !m_statisticsTimer->isActive()) {
+        m_statisticsTimer->start();
+    }
+}
+
+void QApplicationStatus::unsubscribeChannels(StatusChannels channels)
+{
+    for (int i = 0; i < statusChannelCount; ++i)
+    {
+        StatusChannel channel = statusChannels[i];
+
+        if (channels & channel)
+        {
+            m_statusSocket->unsubscribeFrom(channelTopic(channel));
+            m_subscribedChannels &= ~channel;
+        }
+    }
+
+    updateSyncedChannels(m_syncedChannels & m_subscribedChannels);
+
+    if (m_subscribedChannels == 0) {
+        m_statisticsTimer->stop();
+        m_channelBytesPerSecond.clear();
+    }
+}
+
+void QApplicationStatus::sampleStatistics()
+{
+    for (int i = 0; i < statusChannelCount; ++i)
+    {
+        StatusChannel channel = statusChannels[i];
+        quint64 bytes = m_channelBytes.value(channel, 0);
+
+        m_channelBytesPerSecond[channel] = (bytes - m_sampledChannelBytes.value(channel, 0)) * 1000 / m_statisticsTimer->interval();
+        m_sampledChannelBytes[channel] = bytes;
+    }
+}
@@ -27,7 +27,19 @@
 #include <service.h>
 #include <QStringList>
 #include <QTimer>
+#include <QQmlPropertyMap>
+#include <QVariantList>
+#include <QQuickWindow>
+#include <QPointer>
+#include <QHash>
+#include <QSet>
+#include <QQmlListProperty>
 #include <nzmqt/nzmqt.hpp>
+#include <transportmanager.h>
+#include "qapplicationstatusposition.h"
+#include "qapplicationstatusaxis.h"
+#include "qapplicationstatusfields.h"
+#include "qapplicationstatusdecoder.h"
 #include <google/protobuf/text_format.h>
 #include <google/protobuf/message.h>
 #include <google/protobuf/descriptor.h>
@@ -55,9 +67,32 @@ class QApplicationStatus : public AbstractServiceImplementation
     Q_PROPERTY(QJsonObject io READ io NOTIFY ioChanged)
     Q_PROPERTY(QJsonObject task READ task NOTIFY taskChanged)
     Q_PROPERTY(QJsonObject interp READ interp NOTIFY interpChanged)
+    Q_PROPERTY(QObject *configFields READ configFields CONSTANT)
+    Q_PROPERTY(QObject *motionFields READ motionFields CONSTANT)
+    Q_PROPERTY(QObject *ioFields READ ioFields CONSTANT)
+    Q_PROPERTY(QObject *taskFields READ taskFields CONSTANT)
+    Q_PROPERTY(QObject *interpFields READ interpFields CONSTANT)
+    Q_PROPERTY(QApplicationStatusPosition *position READ position CONSTANT)
+    Q_PROPERTY(QApplicationStatusPosition *actualPosition READ actualPosition CONSTANT)
+    Q_PROPERTY(QApplicationStatusPosition *dtg READ dtg CONSTANT)
+    Q_PROPERTY(QApplicationStatusPosition *g5xOffset READ g5xOffset CONSTANT)
+    Q_PROPERTY(QApplicationStatusPosition *g92Offset READ g92Offset CONSTANT)
+    Q_PROPERTY(QApplicationStatusPosition *toolOffset READ toolOffset CONSTANT)
+    Q_PROPERTY(QQmlListProperty<QApplicationStatusAxis> axes READ axes CONSTANT)
     Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
     Q_PROPERTY(bool synced READ isSynced NOTIFY syncedChanged)
+    Q_PROPERTY(StatusChannels syncedChannels READ syncedChannels NOTIFY syncedChannelsChanged)
+    Q_PROPERTY(bool motionSynced READ isMotionSynced NOTIFY motionSyncedChanged)
+    Q_PROPERTY(bool configSynced READ isConfigSynced NOTIFY configSyncedChanged)
+    Q_PROPERTY(bool ioSynced READ isIoSynced NOTIFY ioSyncedChanged)
+    Q_PROPERTY(bool taskSynced READ isTaskSynced NOTIFY taskSyncedChanged)
+    Q_PROPERTY(bool interpSynced READ isInterpSynced NOTIFY interpSyncedChanged)
     Q_PROPERTY(StatusChannels channels READ channels WRITE setChannels NOTIFY channelsChanged)
+    Q_PROPERTY(bool autoSubscribe READ autoSubscribe WRITE setAutoSubscribe NOTIFY autoSubscribeChanged)
+    Q_PROPERTY(int unsubscribeDelay READ unsubscribeDelay WRITE setUnsubscribeDelay NOTIFY unsubscribeDelayChanged)
+    Q_PROPERTY(bool coalesceNotifications READ coalesceNotifications WRITE setCoalesceNotifications NOTIFY coalesceNotificationsChanged)
+    Q_PROPERTY(int notificationInterval READ notificationInterval WRITE setNotificationInterval NOTIFY notificationIntervalChanged)
+    Q_PROPERTY(QQuickWindow *notificationWindow READ notificationWindow WRITE setNotificationWindow NOTIFY notificationWindowChanged)
     Q_ENUMS(State ConnectionError OriginIndex TrajectoryMode MotionStatus
             AxisType KinematicsType CanonUnits TaskExecState TaskState
             TaskMode InterpreterState InterpreterExitCode PositionOffset
@@ -251,26 +286,163 @@ public:
         return m_interp;
     }
 
+    /** The fields of the channels as properties, a change of one
+     *  field only notifies the bindings on this field.
+     **/
+    QObject *configFields() const
+    {
+        return m_configFields;
+    }
+
+    QObject *motionFields() const
+    {
+        return m_motionFields;
+    }
+
+    QObject *ioFields() const
+    {
+        return m_ioFields;
+    }
+
+    QObject *taskFields() const
+    {
+        return m_taskFields;
+    }
+
+    QObject *interpFields() const
+    {
+        return m_interpFields;
+    }
+
+    /** Typed copies of the positions and axis flags, filled without
+     *  going through JSON for consumers reading them at update rate.
+     **/
+    QApplicationStatusPosition *position() const
+    {
+        return m_position;
+    }
+
+    QApplicationStatusPosition *actualPosition() const
+    {
+        return m_actualPosition;
+    }
+
+    QApplicationStatusPosition *dtg() const
+    {
+        return m_dtg;
+    }
+
+    QApplicationStatusPosition *g5xOffset() const
+    {
+        return m_g5xOffset;
+    }
+
+    QApplicationStatusPosition *g92Offset() const
+    {
+        return m_g92Offset;
+    }
+
+    QApplicationStatusPosition *toolOffset() const
+    {
+        return m_toolOffset;
+    }
+
+    QQmlListProperty<QApplicationStatusAxis> axes()
+    {
+        return QQmlListProperty<QApplicationStatusAxis>(this, m_axes);
+    }
+
     StatusChannels channels() const
     {
         return m_channels;
     }
 
+    /** If enabled, only the channels that are in use are subscribed.
+     *  A channel is in use while anything is connected to its signals,
+     *  e.g. a QML binding on one of its fields. Channels no longer in use
+     *  are unsubscribed after unsubscribeDelay milliseconds.
+     **/
+    bool autoSubscribe() const
+    {
+        return m_autoSubscribe;
+    }
+
+    int unsubscribeDelay() const
+    {
+        return m_unsubscribeTimer->interval();
+    }
+
+    Q_INVOKABLE QVariantList channelStatistics() const;
+
     bool isRunning() const
     {
         return m_running;
     }
 
+    /** True if all subscribed channels are synced. **/
     bool isSynced() const
     {
         return m_synced;
     }
 
+    StatusChannels syncedChannels() const
+    {
+        return m_syncedChannels;
+    }
+
+    /** The per channel synced properties subscribe only their own channel,
+     *  controls should depend on the channels they actually read.
+     **/
+    bool isMotionSynced() const
+    {
+        return m_syncedChannels.testFlag(MotionChannel);
+    }
+
+    bool isConfigSynced() const
+    {
+        return m_syncedChannels.testFlag(ConfigChannel);
+    }
+
+    bool isIoSynced() const
+    {
+        return m_syncedChannels.testFlag(IoChannel);
+    }
+
+    bool isTaskSynced() const
+    {
+        return m_syncedChannels.testFlag(TaskChannel);
+    }
+
+    bool isInterpSynced() const
+    {
+        return m_syncedChannels.testFlag(InterpChannel);
+    }
+
     bool isConnected() const
     {
         return m_connected;
     }
 
+    /** If enabled, updates are merged and the change notifications are
+     *  emitted at most once per frame of the notification window or
+     *  once per notification interval if no window is set.
+     *  The sampled signals are emitted for every update regardless.
+     **/
+    bool coalesceNotifications() const
+    {
+        return m_coalesceNotifications;
+    }
+
+    int notificationInterval() const
+    {
+        return m_notificationTimer->interval();
+    }
+
+    QQuickWindow *notificationWindow() const
+    {
+        return m_notificationWindow;
+    }
+
 public slots:
 
     void setStatusUri(QString arg)
@@ -282,14 +454,13 @@ public slots:
         emit statusUriChanged(arg);
     }
 
-    void setChannels(StatusChannels arg)
-    {
-        if (m_channels == arg)
-            return;
+    void setChannels(StatusChannels arg);
+    void setAutoSubscribe(bool arg);
+    void setUnsubscribeDelay(int arg);
 
-        m_channels = arg;
-        emit channelsChanged(arg);
-    }
+    void setCoalesceNotifications(bool arg);
+    void setNotificationInterval(int arg);
+    void setNotificationWindow(QQuickWindow *arg);
 
 private:
     QString         m_statusUri;
@@ -303,17 +474,41 @@ private:
     QJsonObject     m_io;
     QJsonObject     m_task;
     QJsonObject     m_interp;
+    QApplicationStatusFields *m_configFields;
+    QApplicationStatusFields *m_motionFields;
+    QApplicationStatusFields *m_ioFields;
+    QApplicationStatusFields *m_taskFields;
+    QApplicationStatusFields *m_interpFields;
+    QApplicationStatusPosition *m_position;
+    QApplicationStatusPosition *m_actualPosition;
+    QApplicationStatusPosition *m_dtg;
+    QApplicationStatusPosition *m_g5xOffset;
+    QApplicationStatusPosition *m_g92Offset;
+    QApplicationStatusPosition *m_toolOffset;
+    QList<QApplicationStatusAxis*> m_axes;
     bool            m_running;
     bool            m_synced;
     StatusChannels  m_syncedChannels;
     StatusChannels  m_channels;
-
-    PollingZMQContext *m_context;
-    ZMQSocket   *m_statusSocket;
-    QStringList  m_subscriptions;
+    bool            m_coalesceNotifications;
+    QTimer          *m_notificationTimer;
+    QPointer<QQuickWindow> m_notificationWindow;
+    StatusChannels  m_pendingChannels;
+    QHash<int, QSet<QString> > m_pendingFields;
+    bool            m_autoSubscribe;
+    QTimer          *m_unsubscribeTimer;
+    StatusChannels  m_subscribedChannels;
+    QHash<int, int> m_channelUsers;
+    QHash<QObject*, StatusChannel> m_channelObjects;
+    QTimer          *m_statisticsTimer;
+    QHash<int, quint64> m_channelBytes;
+    QHash<int, quint64> m_sampledChannelBytes;
+    QHash<int, quint64> m_channelBytesPerSecond;
+
+    ThreadedZMQSocket   *m_statusSocket;
+    QApplicationStatusDecoder *m_statusDecoder;
+    QHash<int, int> m_generations;
     QTimer      *m_statusHeartbeatTimer;
-    // more efficient to reuse a protobuf Message
-    pb::Container   m_rx;
 
     void start();
     void stop();
@@ -326,15 +521,31 @@ private:
     void updateError(ConnectionError error, const QString &errorString);
     void updateSync(StatusChannel channel);
     void clearSync();
-    void updateMotion(const pb::EmcStatusMotion &motion);
-    void updateConfig(const pb::EmcStatusConfig &config);
-    void updateIo(const pb::EmcStatusIo &io);
-    void updateTask(const pb::EmcStatusTask &task);
-    void updateInterp(const pb::EmcStatusInterp &interp);
+    void updateSyncedChannels(StatusChannels channels);
+    void updateMotion(const pb::EmcStatusMotion &motion, const QJsonObject &object, const QStringList &updatedFields);
+    void updateConfig(const QJsonObject &object, const QStringList &updatedFields);
+    void updateIo(const pb::EmcStatusIo &io, const QJsonObject &object, const QStringList &updatedFields);
+    void updateTask(const QJsonObject &object, const QStringList &updatedFields);
+    void updateInterp(const QJsonObject &object, const QStringList &updatedFields);
     void initializeObject(StatusChannel channel);
+    void updateFields(QQmlPropertyMap *fields, const QJsonObject &object, const QStringList &names);
+    void notifyChannel(StatusChannel channel, const QStringList &updatedFields);
+    void emitChannelChanged(StatusChannel channel, const QStringList &updatedFields);
+    void scheduleNotifications();
+    StatusChannels usedChannels() const;
+    StatusChannels signalChannels(const QMetaMethod &signal) const;
+    void updateUsage(StatusChannels channels, int delta);
+    void updateSubscriptions();
+    void subscribeChannels(StatusChannels channels);
+    void unsubscribeChannels(StatusChannels channels);
+    void watchUsage(QObject *object, StatusChannel channel);
+
+protected:
+    void connectNotify(const QMetaMethod &signal);
+    void disconnectNotify(const QMetaMethod &signal);
 
 private slots:
-    void statusMessageReceived(const QList<QByteArray> &messageList);
+    void statusMessageDecoded(const QByteArray &topic, const ContainerPointer &container, int size, const QApplicationStatusUpdate &update);
     void pollError(int errorNum, const QString &errorMsg);
     void statusHeartbeatTimerTick();
 
@@ -344,6 +555,10 @@ private slots:
     void unsubscribe();
 
     void updateRunning(const QJsonObject &object);
+    void flushNotifications();
+    void unsubscribeUnused();
+    void objectConnectionsChanged(int delta);
+    void sampleStatistics();
 
 signals:
     void statusUriChanged(QString arg);
@@ -356,8 +571,24 @@ signals:
     void taskChanged(QJsonObject arg);
     void interpChanged(QJsonObject arg);
     void channelsChanged(StatusChannels arg);
+    void coalesceNotificationsChanged(bool arg);
+    void notificationIntervalChanged(int arg);
+    void notificationWindowChanged(QQuickWindow *arg);
+    void autoSubscribeChanged(bool arg);
+    void unsubscribeDelayChanged(int arg);
+    void configSampled(QJsonObject arg);
+    void motionSampled(QJsonObject arg);
+    void ioSampled(QJsonObject arg);
+    void taskSampled(QJsonObject arg);
+    void interpSampled(QJsonObject arg);
     void runningChanged(bool arg);
     void syncedChanged(bool arg);
+    void syncedChannelsChanged(StatusChannels arg);
+    void motionSyncedChanged(bool arg);
+    void configSyncedChanged(bool arg);
+    void ioSyncedChanged(bool arg);
+    void taskSyncedChanged(bool arg);
+    void interpSyncedChanged(bool arg);
     void connectedChanged(bool arg);
 };
 
@@ -0,0 +1,127 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+#include "qapplicationstatusaxis.h"
+#include <QMetaMethod>
+
+QApplicationStatusAxis::QApplicationStatusAxis(QObject *parent) :
+    QObject(parent),
+    m_enabled(false),
+    m_fault(false),
+    m_homed(false),
+    m_homing(false),
+    m_inpos(false),
+    m_minHardLimit(false),
+    m_maxHardLimit(false),
+    m_minSoftLimit(false),
+    m_maxSoftLimit(false),
+    m_overrideLimits(false)
+{
+}
+
+#define UPDATE_FLAG(member, signal, value) \
+    if (member != value) { \
+        member = value; \
+        emit signal(value); \
+    }
+
+/** Takes over the flags set in an incremental update */
+void QApplicationStatusAxis::update(const pb::EmcStatusMotionAxis &axis)
+{
+    if (axis.has_enabled()) {
+        UPDATE_FLAG(m_enabled, enabledChanged, axis.enabled())
+    }
+    if (axis.has_fault()) {
+        UPDATE_FLAG(m_fault, faultChanged, axis.fault())
+    }
+    if (axis.has_homed()) {
+        UPDATE_FLAG(m_homed, homedChanged, axis.homed())
+    }
+    if (axis.has_homing()) {
+        UPDATE_FLAG(m_homing, homingChanged, axis.homing())
+    }
+    if (axis.has_inpos()) {
+        UPDATE_FLAG(m_inpos, inposChanged, axis.inpos())
+    }
+    if (axis.has_min_hard_limit()) {
+        UPDATE_FLAG(m_minHardLimit, minHardLimitChanged, axis.min_hard_limit())
+    }
+    if (axis.has_max_hard_limit()) {
+        UPDATE_FLAG(m_maxHardLimit, maxHardLimitChanged, axis.max_hard_limit())
+    }
+    if (axis.has_min_soft_limit()) {
+        UPDATE_FLAG(m_minSoftLimit, minSoftLimitChanged, axis.min_soft_limit())
+    }
+    if (axis.has_max_soft_limit()) {
+        UPDATE_FLAG(m_maxSoftLimit, maxSoftLimitChanged, axis.max_soft_limit())
+    }
+    if (axis.has_override_limits()) {
+        UPDATE_FLAG(m_overrideLimits, overrideLimitsChanged, axis.override_limits())
+    }
+}
+
+/** Holds back an incremental update until notify is called,
+ *  used to emit the changes together with the status fields.
+ **/
+void QApplicationStatusAxis::merge(const pb::EmcStatusMotionAxis &axis)
+{
+    m_pending.MergeFrom(axis);
+}
+
+/** Takes over the merged updates and notifies the changes */
+void QApplicationStatusAxis::notify()
+{
+    update(m_pending);
+    m_pending.Clear();
+}
+
+void QApplicationStatusAxis::clear()
+{
+    m_pending.Clear();
+    UPDATE_FLAG(m_enabled, enabledChanged, false)
+    UPDATE_FLAG(m_fault, faultChanged, false)
+    UPDATE_FLAG(m_homed, homedChanged, false)
+    UPDATE_FLAG(m_homing, homingChanged, false)
+    UPDATE_FLAG(m_inpos, inposChanged, false)
+    UPDATE_FLAG(m_minHardLimit, minHardLimitChanged, false)
+    UPDATE_FLAG(m_maxHardLimit, maxHardLimitChanged, false)
+    UPDATE_FLAG(m_minSoftLimit, minSoftLimitChanged, false)
+    UPDATE_FLAG(m_maxSoftLimit, maxSoftLimitChanged, false)
+    UPDATE_FLAG(m_overrideLimits, overrideLimitsChanged, false)
+}
+
+#undef UPDATE_FLAG
+
+void QApplicationStatusAxis::connectNotify(const QMetaMethod &signal)
+{
+    if (signal != QMetaMethod::fromSignal(&QApplicationStatusAxis::connectionsChanged)) {
+        emit connectionsChanged(1);
+    }
+}
+
+void QApplicationStatusAxis::disconnectNotify(const QMetaMethod &signal)
+{
+    if (signal.isValid()
+        && (signal != QMetaMethod::fromSignal(&QApplicationStatusAxis::connectionsChanged))) {
+        emit connectionsChanged(-1);
+    }
+}
@@ -0,0 +1,135 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+#ifndef QAPPLICATIONSTATUSAXIS_H
+#define QAPPLICATIONSTATUSAXIS_H
+
+#include <QObject>
+#include <machinetalk/protobuf/status.pb.h>
+
+/** The state flags of a motion axis, filled directly from the
+ *  protobuf message. Each flag notifies its own changes.
+ **/
+class QApplicationStatusAxis : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool enabled READ isEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(bool fault READ hasFault NOTIFY faultChanged)
+    Q_PROPERTY(bool homed READ isHomed NOTIFY homedChanged)
+    Q_PROPERTY(bool homing READ isHoming NOTIFY homingChanged)
+    Q_PROPERTY(bool inpos READ isInpos NOTIFY inposChanged)
+    Q_PROPERTY(bool minHardLimit READ minHardLimit NOTIFY minHardLimitChanged)
+    Q_PROPERTY(bool maxHardLimit READ maxHardLimit NOTIFY maxHardLimitChanged)
+    Q_PROPERTY(bool minSoftLimit READ minSoftLimit NOTIFY minSoftLimitChanged)
+    Q_PROPERTY(bool maxSoftLimit READ maxSoftLimit NOTIFY maxSoftLimitChanged)
+    Q_PROPERTY(bool overrideLimits READ overrideLimits NOTIFY overrideLimitsChanged)
+
+public:
+    explicit QApplicationStatusAxis(QObject *parent = 0);
+
+    bool isEnabled() const
+    {
+        return m_enabled;
+    }
+
+    bool hasFault() const
+    {
+        return m_fault;
+    }
+
+    bool isHomed() const
+    {
+        return m_homed;
+    }
+
+    bool isHoming() const
+    {
+        return m_homing;
+    }
+
+    bool isInpos() const
+    {
+        return m_inpos;
+    }
+
+    bool minHardLimit() const
+    {
+        return m_minHardLimit;
+    }
+
+    bool maxHardLimit() const
+    {
+        return m_maxHardLimit;
+    }
+
+    bool minSoftLimit() const
+    {
+        return m_minSoftLimit;
+    }
+
+    bool maxSoftLimit() const
+    {
+        return m_maxSoftLimit;
+    }
+
+    bool overrideLimits() const
+    {
+        return m_overrideLimits;
+    }
+
+    void update(const pb::EmcStatusMotionAxis &axis);
+    void merge(const pb::EmcStatusMotionAxis &axis);
+    void notify();
+    void clear();
+
+protected:
+    void connectNotify(const QMetaMethod &signal);
+    void disconnectNotify(const QMetaMethod &signal);
+
+private:
+    bool m_enabled;
+    bool m_fault;
+    bool m_homed;
+    bool m_homing;
+    bool m_inpos;
+    bool m_minHardLimit;
+    bool m_maxHardLimit;
+    bool m_minSoftLimit;
+    bool m_maxSoftLimit;
+    bool m_overrideLimits;
+    pb::EmcStatusMotionAxis m_pending;
+
+signals:
+    void connectionsChanged(int delta);
+    void enabledChanged(bool arg);
+    void faultChanged(bool arg);
+    void homedChanged(bool arg);
+    void homingChanged(bool arg);
+    void inposChanged(bool arg);
+    void minHardLimitChanged(bool arg);
+    void maxHardLimitChanged(bool arg);
+    void minSoftLimitChanged(bool arg);
+    void maxSoftLimitChanged(bool arg);
+    void overrideLimitsChanged(bool arg);
+};
+
+#endif // QAPPLICATIONSTATUSAXIS_H
@@ -0,0 +1,376 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+#include "qapplicationstatusconverter.h"
+#include <QJsonArray>
+
+static inline QJsonValue jsonValue(bool value)
+{
+    return value;
+}
+
+static inline QJsonValue jsonValue(double value)
+{
+    return value;
+}
+
+static inline QJsonValue jsonValue(gpb::int32 value)
+{
+    return (int)value;
+}
+
+static inline QJsonValue jsonValue(gpb::uint32 value)
+{
+    return (int)value;
+}
+
+static inline QJsonValue jsonValue(const std::string &value)
+{
+    return QString::fromUtf8(value.data(), static_cast<int>(value.size()));
+}
+
+static inline void fieldUpdated(QStringList *updatedFields, const QString &name)
+{
+    if (updatedFields != NULL) {
+        updatedFields->append(name);
+    }
+}
+
+static inline void resizeArray(QJsonArray *array, int index)
+{
+    while (array->size() < (index + 1))
+    {
+        array->append(QJsonValue());
+    }
+}
+
+/** Merges repeated index and value elements into the array name of object */
+template <typename T, typename V>
+static bool indexValuesToJson(const gpb::RepeatedPtrField<T> &elements,
+                              bool (T::*hasValue)() const,
+                              V (T::*value)() const,
+                              const QString &name,
+                              QJsonObject *object)
+{
+    if (elements.size() == 0) {
+        return false;
+    }
+
+    QJsonArray array = object->value(name).toArray();
+
+    for (int i = 0; i < elements.size(); ++i)
+    {
+        const T &element = elements.Get(i);
+
+        resizeArray(&array, element.index());
+        if ((element.*hasValue)()) {
+            array.replace(element.index(), jsonValue((element.*value)()));
+        }
+    }
+
+    object->insert(name, array);
+
+    return true;
+}
+
+/** Merges repeated indexed messages into the array name of object */
+template <typename T>
+static bool indexObjectsToJson(const gpb::RepeatedPtrField<T> &elements,
+                               void (*toJson)(const T &, QJsonObject *),
+                               const QString &name,
+                               QJsonObject *object)
+{
+    if (elements.size() == 0) {
+        return false;
+    }
+
+    QJsonArray array = object->value(name).toArray();
+
+    for (int i = 0; i < elements.size(); ++i)
+    {
+        const T &element = elements.Get(i);
+        QJsonObject elementObject;
+
+        resizeArray(&array, element.index());
+        elementObject = array.at(element.index()).toObject();
+        toJson(element, &elementObject);
+        array.replace(element.index(), elementObject);
+    }
+
+    object->insert(name, array);
+
+    return true;
+}
+
+#define VALUE_TO_JSON(message, field, name) \
+    if (message.has_##field()) { \
+        object->insert(QStringLiteral(name), jsonValue(message.field())); \
+    }
+
+#define FIELD_TO_JSON(message, field, name) \
+    if (message.has_##field()) { \
+        object->insert(QStringLiteral(name), jsonValue(message.field())); \
+        fieldUpdated(updatedFields, QStringLiteral(name)); \
+    }
+
+#define POSITION_TO_JSON(message, field, name) \
+    if (message.has_##field()) { \
+        QJsonObject position = object->value(QStringLiteral(name)).toObject(); \
+        positionToJson(message.field(), &position); \
+        object->insert(QStringLiteral(name), position); \
+        fieldUpdated(updatedFields, QStringLiteral(name)); \
+    }
+
+#define INDEX_VALUES_TO_JSON(message, field, type, value, name) \
+    if (indexValuesToJson(message.field(), &pb::type::has_##value, &pb::type::value, \
+                          QStringLiteral(name), object)) { \
+        fieldUpdated(updatedFields, QStringLiteral(name)); \
+    }
+
+#define INDEX_OBJECTS_TO_JSON(message, field, toJson, name) \
+    if (indexObjectsToJson(message.field(), &toJson, QStringLiteral(name), object)) { \
+        fieldUpdated(updatedFields, QStringLiteral(name)); \
+    }
+
+void QApplicationStatusConverter::motionToJson(const pb::EmcStatusMotion &motion, QJsonObject *object, QStringList *updatedFields)
+{
+    FIELD_TO_JSON(motion, active_queue, "activeQueue")
+    POSITION_TO_JSON(motion, actual_position, "actualPosition")
+    FIELD_TO_JSON(motion, adaptive_feed_enabled, "adaptiveFeedEnabled")
+    INDEX_VALUES_TO_JSON(motion, ain, EmcStatusAnalogIO, value, "ain")
+    INDEX_VALUES_TO_JSON(motion, aout, EmcStatusAnalogIO, value, "aout")
+    INDEX_OBJECTS_TO_JSON(motion, axis, motionAxisToJson, "axis")
+    FIELD_TO_JSON(motion, block_delete, "blockDelete")
+    FIELD_TO_JSON(motion, current_line, "currentLine")
+    FIELD_TO_JSON(motion, current_vel, "currentVel")
+    FIELD_TO_JSON(motion, delay_left, "delayLeft")
+    INDEX_VALUES_TO_JSON(motion, din, EmcStatusDigitalIO, value, "din")
+    FIELD_TO_JSON(motion, distance_to_go, "distanceToGo")
+    INDEX_VALUES_TO_JSON(motion, dout, EmcStatusDigitalIO, value, "dout")
+    POSITION_TO_JSON(motion, dtg, "dtg")
+    FIELD_TO_JSON(motion, enabled, "enabled")
+    FIELD_TO_JSON(motion, feed_hold_enabled, "feedHoldEnabled")
+    FIELD_TO_JSON(motion, feed_override_enabled, "feedOverrideEnabled")
+    FIELD_TO_JSON(motion, feedrate, "feedrate")
+    FIELD_TO_JSON(motion, g5x_index, "g5xIndex")
+    POSITION_TO_JSON(motion, g5x_offset, "g5xOffset")
+    POSITION_TO_JSON(motion, g92_offset, "g92Offset")
+    FIELD_TO_JSON(motion, id, "id")
+    FIELD_TO_JSON(motion, inpos, "inpos")
+    POSITION_TO_JSON(motion, joint_actual_position, "jointActualPosition")
+    POSITION_TO_JSON(motion, joint_position, "jointPosition")
+    INDEX_VALUES_TO_JSON(motion, limit, EmcStatusLimit, value, "limit")
+    FIELD_TO_JSON(motion, motion_line, "motionLine")
+    FIELD_TO_JSON(motion, motion_type, "motionType")
+    FIELD_TO_JSON(motion, motion_mode, "motionMode")
+    FIELD_TO_JSON(motion, paused, "paused")
+    POSITION_TO_JSON(motion, position, "position")
+    FIELD_TO_JSON(motion, probe_tripped, "probeTripped")
+    FIELD_TO_JSON(motion, probe_val, "probeVal")
+    POSITION_TO_JSON(motion, probed_position, "probedPosition")
+    FIELD_TO_JSON(motion, probing, "probing")
+    FIELD_TO_JSON(motion, queue, "queue")
+    FIELD_TO_JSON(motion, queue_full, "queueFull")
+    FIELD_TO_JSON(motion, rotation_xy, "rotationXy")
+    FIELD_TO_JSON(motion, spindle_brake, "spindleBrake")
+    FIELD_TO_JSON(motion, spindle_direction, "spindleDirection")
+    FIELD_TO_JSON(motion, spindle_enabled, "spindleEnabled")
+    FIELD_TO_JSON(motion, spindle_increasing, "spindleIncreasing")
+    FIELD_TO_JSON(motion, spindle_override_enabled, "spindleOverrideEnabled")
+    FIELD_TO_JSON(motion, spindle_speed, "spindleSpeed")
+    FIELD_TO_JSON(motion, spindlerate, "spindlerate")
+    FIELD_TO_JSON(motion, state, "state")
+    FIELD_TO_JSON(motion, max_velocity, "maxVelocity")
+    FIELD_TO_JSON(motion, max_acceleration, "maxAcceleration")
+}
+
+void QApplicationStatusConverter::configToJson(const pb::EmcStatusConfig &config, QJsonObject *object, QStringList *updatedFields)
+{
+    FIELD_TO_JSON(config, default_acceleration, "defaultAcceleration")
+    FIELD_TO_JSON(config, angular_units, "angularUnits")
+    FIELD_TO_JSON(config, axes, "axes")
+    INDEX_OBJECTS_TO_JSON(config, axis, configAxisToJson, "axis")
+    FIELD_TO_JSON(config, axis_mask, "axisMask")
+    FIELD_TO_JSON(config, cycle_time, "cycleTime")
+    FIELD_TO_JSON(config, debug, "debug")
+    FIELD_TO_JSON(config, kinematics_type, "kinematicsType")
+    FIELD_TO_JSON(config, linear_units, "linearUnits")
+    FIELD_TO_JSON(config, max_acceleration, "maxAcceleration")
+    FIELD_TO_JSON(config, max_velocity, "maxVelocity")
+    FIELD_TO_JSON(config, program_units, "programUnits")
+    FIELD_TO_JSON(config, default_velocity, "defaultVelocity")
+    INDEX_VALUES_TO_JSON(config, program_extension, EmcProgramExtension, extension, "programExtension")
+    FIELD_TO_JSON(config, position_offset, "positionOffset")
+    FIELD_TO_JSON(config, position_feedback, "positionFeedback")
+    FIELD_TO_JSON(config, max_feed_override, "maxFeedOverride")
+    FIELD_TO_JSON(config, min_feed_override, "minFeedOverride")
+    FIELD_TO_JSON(config, max_spindle_override, "maxSpindleOverride")
+    FIELD_TO_JSON(config, min_spindle_override, "minSpindleOverride")
+    FIELD_TO_JSON(config, default_spindle_speed, "defaultSpindleSpeed")
+    FIELD_TO_JSON(config, default_linear_velocity, "defaultLinearVelocity")
+    FIELD_TO_JSON(config, min_velocity, "minVelocity")
+    FIELD_TO_JSON(config, max_linear_velocity, "maxLinearVelocity")
+    FIELD_TO_JSON(config, min_linear_velocity, "minLinearVelocity")
+    FIELD_TO_JSON(config, default_angular_velocity, "defaultAngularVelocity")
+    FIELD_TO_JSON(config, max_angular_velocity, "maxAngularVelocity")
+    FIELD_TO_JSON(config, min_angular_velocity, "minAngularVelocity")
+    FIELD_TO_JSON(config, increments, "increments")
+    FIELD_TO_JSON(config, grids, "grids")
+    FIELD_TO_JSON(config, lathe, "lathe")
+    FIELD_TO_JSON(config, geometry, "geometry")
+    FIELD_TO_JSON(config, arcdivision, "arcdivision")
+    FIELD_TO_JSON(config, no_force_homing, "noForceHoming")
+    FIELD_TO_JSON(config, remote_path, "remotePath")
+    FIELD_TO_JSON(config, time_units, "timeUnits")
+    FIELD_TO_JSON(config, name, "name")
+    INDEX_VALUES_TO_JSON(config, user_command, EmcStatusUserCommand, command, "userCommand")
+}
+
+void QApplicationStatusConverter::ioToJson(const pb::EmcStatusIo &io, QJsonObject *object, QStringList *updatedFields)
+{
+    FIELD_TO_JSON(io, estop, "estop")
+    FIELD_TO_JSON(io, flood, "flood")
+    FIELD_TO_JSON(io, lube, "lube")
+    FIELD_TO_JSON(io, lube_level, "lubeLevel")
+    FIELD_TO_JSON(io, mist, "mist")
+    FIELD_TO_JSON(io, pocket_prepped, "pocketPrepped")
+    FIELD_TO_JSON(io, tool_in_spindle, "toolInSpindle")
+    POSITION_TO_JSON(io, tool_offset, "toolOffset")
+    INDEX_OBJECTS_TO_JSON(io, tool_table, toolToJson, "toolTable")
+}
+
+void QApplicationStatusConverter::taskToJson(const pb::EmcStatusTask &task, QJsonObject *object, QStringList *updatedFields)
+{
+    FIELD_TO_JSON(task, echo_serial_number, "echoSerialNumber")
+    FIELD_TO_JSON(task, exec_state, "execState")
+    FIELD_TO_JSON(task, file, "file")
+    FIELD_TO_JSON(task, input_timeout, "inputTimeout")
+    FIELD_TO_JSON(task, optional_stop, "optionalStop")
+    FIELD_TO_JSON(task, read_line, "readLine")
+    FIELD_TO_JSON(task, task_mode, "taskMode")
+    FIELD_TO_JSON(task, task_paused, "taskPaused")
+    FIELD_TO_JSON(task, task_state, "taskState")
+    FIELD_TO_JSON(task, total_lines, "totalLines")
+}
+
+void QApplicationStatusConverter::interpToJson(const pb::EmcStatusInterp &interp, QJsonObject *object, QStringList *updatedFields)
+{
+    FIELD_TO_JSON(interp, command, "command")
+    INDEX_VALUES_TO_JSON(interp, gcodes, EmcStatusGCode, value, "gcodes")
+    FIELD_TO_JSON(interp, interp_state, "interpState")
+    FIELD_TO_JSON(interp, interpreter_errcode, "interpreterErrcode")
+    INDEX_VALUES_TO_JSON(interp, mcodes, EmcStatusMCode, value, "mcodes")
+    INDEX_VALUES_TO_JSON(interp, settings, EmcStatusSetting, value, "settings")
+}
+
+/** Positions are also accessible by axis index */
+void QApplicationStatusConverter::positionToJson(const pb::Position &position, QJsonObject *object)
+{
+    if (position.has_x()) {
+        object->insert(QStringLiteral("x"), position.x());
+        object->insert(QStringLiteral("0"), position.x());
+    }
+    if (position.has_y()) {
+        object->insert(QStringLiteral("y"), position.y());
+        object->insert(QStringLiteral("1"), position.y());
+    }
+    if (position.has_z()) {
+        object->insert(QStringLiteral("z"), position.z());
+        object->insert(QStringLiteral("2"), position.z());
+    }
+    if (position.has_a()) {
+        object->insert(QStringLiteral("a"), position.a());
+        object->insert(QStringLiteral("3"), position.a());
+    }
+    if (position.has_b()) {
+        object->insert(QStringLiteral("b"), position.b());
+        object->insert(QStringLiteral("4"), position.b());
+    }
+    if (position.has_c()) {
+        object->insert(QStringLiteral("c"), position.c());
+        object->insert(QStringLiteral("5"), position.c());
+    }
+    if (position.has_u()) {
+        object->insert(QStringLiteral("u"), position.u());
+        object->insert(QStringLiteral("6"), position.u());
+    }
+    if (position.has_v()) {
+        object->insert(QStringLiteral("v"), position.v());
+        object->insert(QStringLiteral("7"), position.v());
+    }
+    if (position.has_w()) {
+        object->insert(QStringLiteral("w"), position.w());
+        object->insert(QStringLiteral("8"), position.w());
+    }
+}
+
+void QApplicationStatusConverter::motionAxisToJson(const pb::EmcStatusMotionAxis &axis, QJsonObject *object)
+{
+    VALUE_TO_JSON(axis, enabled, "enabled")
+    VALUE_TO_JSON(axis, fault, "fault")
+    VALUE_TO_JSON(axis, ferror_current, "ferrorCurrent")
+    VALUE_TO_JSON(axis, ferror_highmark, "ferrorHighmark")
+    VALUE_TO_JSON(axis, homed, "homed")
+    VALUE_TO_JSON(axis, homing, "homing")
+    VALUE_TO_JSON(axis, inpos, "inpos")
+    VALUE_TO_JSON(axis, input, "input")
+    VALUE_TO_JSON(axis, max_hard_limit, "maxHardLimit")
+    VALUE_TO_JSON(axis, max_soft_limit, "maxSoftLimit")
+    VALUE_TO_JSON(axis, min_hard_limit, "minHardLimit")
+    VALUE_TO_JSON(axis, min_soft_limit, "minSoftLimit")
+    VALUE_TO_JSON(axis, output, "output")
+    VALUE_TO_JSON(axis, override_limits, "overrideLimits")
+    VALUE_TO_JSON(axis, velocity, "velocity")
+}
+
+void QApplicationStatusConverter::configAxisToJson(const pb::EmcStatusConfigAxis &axis, QJsonObject *object)
+{
+    VALUE_TO_JSON(axis, axistype, "axisType")
+    VALUE_TO_JSON(axis, backlash, "backlash")
+    VALUE_TO_JSON(axis, max_ferror, "maxFerror")
+    VALUE_TO_JSON(axis, max_position_limit, "maxPositionLimit")
+    VALUE_TO_JSON(axis, min_ferror, "minFerror")
+    VALUE_TO_JSON(axis, min_position_limit, "minPositionLimit")
+    VALUE_TO_JSON(axis, units, "units")
+    VALUE_TO_JSON(axis, home_sequence, "homeSequence")
+    VALUE_TO_JSON(axis, max_acceleration, "maxAcceleration")
+    VALUE_TO_JSON(axis, max_velocity, "maxVelocity")
+    VALUE_TO_JSON(axis, increments, "increments")
+}
+
+void QApplicationStatusConverter::toolToJson(const pb::EmcToolData &tool, QJsonObject *object)
+{
+    VALUE_TO_JSON(tool, id, "id")
+    VALUE_TO_JSON(tool, xoffset, "xOffset")
+    VALUE_TO_JSON(tool, yoffset, "yOffset")
+    VALUE_TO_JSON(tool, zoffset, "zOffset")
+    VALUE_TO_JSON(tool, aoffset, "aOffset")
+    VALUE_TO_JSON(tool, boffset, "bOffset")
+    VALUE_TO_JSON(tool, coffset, "cOffset")
+    VALUE_TO_JSON(tool, uoffset, "uOffset")
+    VALUE_TO_JSON(tool, voffset, "vOffset")
+    VALUE_TO_JSON(tool, woffset, "wOffset")
+    VALUE_TO_JSON(tool, diameter, "diameter")
+    VALUE_TO_JSON(tool, frontangle, "frontangle")
+    VALUE_TO_JSON(tool, backangle, "backangle")
+    VALUE_TO_JSON(tool, orientation, "orientation")
+}
@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+#ifndef QAPPLICATIONSTATUSCONVERTER_H
+#define QAPPLICATIONSTATUSCONVERTER_H
+
+#include <QJsonObject>
+#include <QStringList>
+#include <service.h>
+#include <machinetalk/protobuf/status.pb.h>
+
+/** Converts the status channel messages to JSON objects.
+ *  Written out per message type with the generated accessors,
+ *  the names are string literals. Must be kept in sync with
+ *  status.proto, the output equals Service::recurseMessage.
+ **/
+class QApplicationStatusConverter
+{
+public:
+    static void motionToJson(const pb::EmcStatusMotion &motion, QJsonObject *object, QStringList *updatedFields);
+    static void configToJson(const pb::EmcStatusConfig &config, QJsonObject *object, QStringList *updatedFields);
+    static void ioToJson(const pb::EmcStatusIo &io, QJsonObject *object, QStringList *updatedFields);
+    static void taskToJson(const pb::EmcStatusTask &task, QJsonObject *object, QStringList *updatedFields);
+    static void interpToJson(const pb::EmcStatusInterp &interp, QJsonObject *object, QStringList *updatedFields);
+
+private:
+    static void positionToJson(const pb::Position &position, QJsonObject *object);
+    static void motionAxisToJson(const pb::EmcStatusMotionAxis &axis, QJsonObject *object);
+    static void configAxisToJson(const pb::EmcStatusConfigAxis &axis, QJsonObject *object);
+    static void toolToJson(const pb::EmcToolData &tool, QJsonObject *object);
+};
+
+#endif // QAPPLICATIONSTATUSCONVERTER_H
@@ -0,0 +1,116 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+#include "qapplicationstatusdecoder.h"
+#include "qapplicationstatus.h"
+#include "qapplicationstatusconverter.h"
+#include "debughelper.h"
+
+QApplicationStatusDecoder::QApplicationStatusDecoder(QObject *parent) :
+    MessageDecoder(parent)
+{
+    qRegisterMetaType<QApplicationStatusUpdate>("QApplicationStatusUpdate");
+
+    reset(QApplicationStatus::MotionChannel, 0);
+    reset(QApplicationStatus::ConfigChannel, 0);
+    reset(QApplicationStatus::IoChannel, 0);
+    reset(QApplicationStatus::TaskChannel, 0);
+    reset(QApplicationStatus::InterpChannel, 0);
+}
+
+/** Resets the state of a channel, updates based on it get the new generation */
+void QApplicationStatusDecoder::reset(int channel, int generation)
+{
+    QJsonObject object;
+
+    switch (channel)
+    {
+    case QApplicationStatus::MotionChannel:
+        Service::recurseDescriptor(pb::EmcStatusMotion::descriptor(), &object);
+        break;
+    case QApplicationStatus::ConfigChannel:
+        Service::recurseDescriptor(pb::EmcStatusConfig::descriptor(), &object);
+        break;
+    case QApplicationStatus::IoChannel:
+        Service::recurseDescriptor(pb::EmcStatusIo::descriptor(), &object);
+        break;
+    case QApplicationStatus::TaskChannel:
+        Service::recurseDescriptor(pb::EmcStatusTask::descriptor(), &object);
+        break;
+    case QApplicationStatus::InterpChannel:
+        Service::recurseDescriptor(pb::EmcStatusInterp::descriptor(), &object);
+        break;
+    default:
+        return;
+    }
+
+    m_objects.insert(channel, object);
+    m_generations.insert(channel, generation);
+}
+
+void QApplicationStatusDecoder::decodeMessage(const QByteArray &topic, const ContainerPointer &container, int size)
+{
+    const pb::Container &rx = *container;
+    QApplicationStatusUpdate update;
+
+    update.channel = 0;
+    update.generation = 0;
+
+#ifdef QT_DEBUG
+    std::string s;
+    gpb::TextFormat::PrintToString(rx, &s);
+    DEBUG_TAG(3, "status", "update" << topic << QString::fromStdString(s))
+#endif
+
+    if ((rx.type() == pb::MT_EMCSTAT_FULL_UPDATE)
+        || (rx.type() == pb::MT_EMCSTAT_INCREMENTAL_UPDATE))
+    {
+        if ((topic == "motion") && rx.has_emc_status_motion()) {
+            update.channel = QApplicationStatus::MotionChannel;
+            QApplicationStatusConverter::motionToJson(rx.emc_status_motion(), &m_objects[update.channel], &update.updatedFields);
+        }
+        else if ((topic == "config") && rx.has_emc_status_config()) {
+            update.channel = QApplicationStatus::ConfigChannel;
+            QApplicationStatusConverter::configToJson(rx.emc_status_config(), &m_objects[update.channel], &update.updatedFields);
+        }
+        else if ((topic == "io") && rx.has_emc_status_io()) {
+            update.channel = QApplicationStatus::IoChannel;
+            QApplicationStatusConverter::ioToJson(rx.emc_status_io(), &m_objects[update.channel], &update.updatedFields);
+        }
+        else if ((topic == "task") && rx.has_emc_status_task()) {
+            update.channel = QApplicationStatus::TaskChannel;
+            QApplicationStatusConverter::taskToJson(rx.emc_status_task(), &m_objects[update.channel], &update.updatedFields);
+        }
+        else if ((topic == "interp") && rx.has_emc_status_interp()) {
+            update.channel = QApplicationStatus::InterpChannel;
+            QApplicationStatusConverter::interpToJson(rx.emc_status_interp(), &m_objects[update.channel], &update.updatedFields);
+        }
+    }
+
+    if (update.channel != 0)
+    {
+        update.object = m_objects.value(update.channel);    // shared with the status, the next update detaches
+        update.generation = m_generations.value(update.channel);
+    }
+
+    emit statusDecoded(topic, container, size, update);
+}
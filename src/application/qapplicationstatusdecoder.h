@@ -0,0 +1,66 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+#ifndef QAPPLICATIONSTATUSDECODER_H
+#define QAPPLICATIONSTATUSDECODER_H
+
+#include <QJsonObject>
+#include <QStringList>
+#include <QHash>
+#include <messagedecoder.h>
+
+/** A decoded status update, ready to be taken over by the status */
+struct QApplicationStatusUpdate {
+    int channel;                // 0 if the message updates no channel
+    int generation;             // generation of the channel state the update is based on
+    QJsonObject object;         // the complete state of the channel
+    QStringList updatedFields;
+};
+
+/** Decodes the status messages on the decoder thread.
+ *  Keeps its own copy of the channel states to merge the
+ *  incremental updates into.
+ **/
+class QApplicationStatusDecoder : public MessageDecoder
+{
+    Q_OBJECT
+
+public:
+    explicit QApplicationStatusDecoder(QObject *parent = 0);
+
+public slots:
+    void reset(int channel, int generation);
+
+protected:
+    void decodeMessage(const QByteArray &topic, const ContainerPointer &container, int size);
+
+private:
+    QHash<int, QJsonObject> m_objects;
+    QHash<int, int> m_generations;
+
+signals:
+    void statusDecoded(const QByteArray &topic, const ContainerPointer &container, int size, const QApplicationStatusUpdate &update);
+};
+
+Q_DECLARE_METATYPE(QApplicationStatusUpdate)
+
+#endif // QAPPLICATIONSTATUSDECODER_H
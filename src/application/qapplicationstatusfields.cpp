@@ -0,0 +1,44 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+#include "qapplicationstatusfields.h"
+#include <QMetaMethod>
+
+QApplicationStatusFields::QApplicationStatusFields(QObject *parent) :
+    QQmlPropertyMap(this, parent)
+{
+}
+
+void QApplicationStatusFields::connectNotify(const QMetaMethod &signal)
+{
+    if (signal != QMetaMethod::fromSignal(&QApplicationStatusFields::connectionsChanged)) {
+        emit connectionsChanged(1);
+    }
+}
+
+void QApplicationStatusFields::disconnectNotify(const QMetaMethod &signal)
+{
+    if (signal.isValid()    // invalid for disconnects of all signals, these are not counted
+        && (signal != QMetaMethod::fromSignal(&QApplicationStatusFields::connectionsChanged))) {
+        emit connectionsChanged(-1);
+    }
+}
@@ -0,0 +1,47 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+#ifndef QAPPLICATIONSTATUSFIELDS_H
+#define QAPPLICATIONSTATUSFIELDS_H
+
+#include <QQmlPropertyMap>
+
+/** The fields of a status channel as properties.
+ *  Reports connections to its signals to let the status
+ *  subscribe only the channels that are actually used.
+ **/
+class QApplicationStatusFields : public QQmlPropertyMap
+{
+    Q_OBJECT
+
+public:
+    explicit QApplicationStatusFields(QObject *parent = 0);
+
+protected:
+    void connectNotify(const QMetaMethod &signal);
+    void disconnectNotify(const QMetaMethod &signal);
+
+signals:
+    void connectionsChanged(int delta);
+};
+
+#endif // QAPPLICATIONSTATUSFIELDS_H
@@ -0,0 +1,155 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+#include "qapplicationstatusposition.h"
+#include <QMetaMethod>
+
+QApplicationStatusPosition::QApplicationStatusPosition(QObject *parent) :
+    QObject(parent)
+{
+    for (int i = 0; i < AxisCount; ++i)
+    {
+        m_values[i] = 0.0;
+    }
+}
+
+double QApplicationStatusPosition::value(int axis) const
+{
+    if ((axis < 0) || (axis >= AxisCount))
+    {
+        return 0.0;
+    }
+
+    return m_values[axis];
+}
+
+/** Takes over the axes set in an incremental update */
+void QApplicationStatusPosition::update(const pb::Position &position)
+{
+    if (position.has_x()) {
+        updateValue(0, position.x());
+    }
+    if (position.has_y()) {
+        updateValue(1, position.y());
+    }
+    if (position.has_z()) {
+        updateValue(2, position.z());
+    }
+    if (position.has_a()) {
+        updateValue(3, position.a());
+    }
+    if (position.has_b()) {
+        updateValue(4, position.b());
+    }
+    if (position.has_c()) {
+        updateValue(5, position.c());
+    }
+    if (position.has_u()) {
+        updateValue(6, position.u());
+    }
+    if (position.has_v()) {
+        updateValue(7, position.v());
+    }
+    if (position.has_w()) {
+        updateValue(8, position.w());
+    }
+}
+
+/** Holds back an incremental update until notify is called,
+ *  used to emit the changes together with the status fields.
+ **/
+void QApplicationStatusPosition::merge(const pb::Position &position)
+{
+    m_pending.MergeFrom(position);
+}
+
+/** Takes over the merged updates and notifies the changes */
+void QApplicationStatusPosition::notify()
+{
+    update(m_pending);
+    m_pending.Clear();
+}
+
+void QApplicationStatusPosition::clear()
+{
+    m_pending.Clear();
+    for (int i = 0; i < AxisCount; ++i)
+    {
+        updateValue(i, 0.0);
+    }
+}
+
+void QApplicationStatusPosition::updateValue(int axis, double value)
+{
+    if (m_values[axis] == value)
+    {
+        return;
+    }
+
+    m_values[axis] = value;
+
+    switch (axis)
+    {
+    case 0:
+        emit xChanged(value);
+        return;
+    case 1:
+        emit yChanged(value);
+        return;
+    case 2:
+        emit zChanged(value);
+        return;
+    case 3:
+        emit aChanged(value);
+        return;
+    case 4:
+        emit bChanged(value);
+        return;
+    case 5:
+        emit cChanged(value);
+        return;
+    case 6:
+        emit uChanged(value);
+        return;
+    case 7:
+        emit vChanged(value);
+        return;
+    case 8:
+        emit wChanged(value);
+        return;
+    }
+}
+
+void QApplicationStatusPosition::connectNotify(const QMetaMethod &signal)
+{
+    if (signal != QMetaMethod::fromSignal(&QApplicationStatusPosition::connectionsChanged)) {
+        emit connectionsChanged(1);
+    }
+}
+
+void QApplicationStatusPosition::disconnectNotify(const QMetaMethod &signal)
+{
+    if (signal.isValid()
+        && (signal != QMetaMethod::fromSignal(&QApplicationStatusPosition::connectionsChanged))) {
+        emit connectionsChanged(-1);
+    }
+}
@@ -0,0 +1,125 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+#ifndef QAPPLICATIONSTATUSPOSITION_H
+#define QAPPLICATIONSTATUSPOSITION_H
+
+#include <QObject>
+#include <machinetalk/protobuf/preview.pb.h>
+
+/** A position vector of the status, filled directly from the
+ *  protobuf message. Each axis notifies its own changes.
+ **/
+class QApplicationStatusPosition : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(double x READ x NOTIFY xChanged)
+    Q_PROPERTY(double y READ y NOTIFY yChanged)
+    Q_PROPERTY(double z READ z NOTIFY zChanged)
+    Q_PROPERTY(double a READ a NOTIFY aChanged)
+    Q_PROPERTY(double b READ b NOTIFY bChanged)
+    Q_PROPERTY(double c READ c NOTIFY cChanged)
+    Q_PROPERTY(double u READ u NOTIFY uChanged)
+    Q_PROPERTY(double v READ v NOTIFY vChanged)
+    Q_PROPERTY(double w READ w NOTIFY wChanged)
+
+public:
+    explicit QApplicationStatusPosition(QObject *parent = 0);
+
+    enum { AxisCount = 9 };
+
+    double x() const
+    {
+        return m_values[0];
+    }
+
+    double y() const
+    {
+        return m_values[1];
+    }
+
+    double z() const
+    {
+        return m_values[2];
+    }
+
+    double a() const
+    {
+        return m_values[3];
+    }
+
+    double b() const
+    {
+        return m_values[4];
+    }
+
+    double c() const
+    {
+        return m_values[5];
+    }
+
+    double u() const
+    {
+        return m_values[6];
+    }
+
+    double v() const
+    {
+        return m_values[7];
+    }
+
+    double w() const
+    {
+        return m_values[8];
+    }
+
+    Q_INVOKABLE double value(int axis) const;
+
+    void update(const pb::Position &position);
+    void merge(const pb::Position &position);
+    void notify();
+    void clear();
+
+protected:
+    void connectNotify(const QMetaMethod &signal);
+    void disconnectNotify(const QMetaMethod &signal);
+
+private:
+    double m_values[AxisCount];
+    pb::Position m_pending;
+
+    void updateValue(int axis, double value);
+
+signals:
+    void connectionsChanged(int delta);
+    void xChanged(double arg);
+    void yChanged(double arg);
+    void zChanged(double arg);
+    void aChanged(double arg);
+    void bChanged(double arg);
+    void cChanged(double arg);
+    void uChanged(double arg);
+    void vChanged(double arg);
+    void wChanged(double arg);
+};
+
+#endif // QAPPLICATIONSTATUSPOSITION_H
@@ -26,7 +26,7 @@ import Machinekit.Application 1.0
 
 FileDialog {
     property var core: null
-    property var status: core === null ? {"synced": false} : core.status
+    property var status: core === null ? {"synced": false, "motionSynced": false, "configSynced": false, "ioSynced": false, "taskSynced": false, "interpSynced": false} : core.status
     property var file: core === null ? {"localPath":"", "remotePath":"", "localFilePath":"", "ready":false} : core.file
 
     id: fileDialog
@@ -40,11 +40,11 @@ FileDialog {
         var filters = []
         var allExtensions = ["*.ngc"]
 
-        if ((status.synced) && (status.config.programExtension !== undefined))
+        if ((status.configSynced) && (status.configFields.programExtension !== undefined))
         {
-            for (var i = 0; i < status.config.programExtension.length; ++i)
+            for (var i = 0; i < status.configFields.programExtension.length; ++i)
             {
-                var extension = status.config.programExtension[i]
+                var extension = status.configFields.programExtension[i]
                 if (extension === "") {  // skip empty
                     continue
                 }
@@ -77,8 +77,8 @@ Gauge {
             return file.progress
         }
         else if (_mode == "running") {
-            var totalLines = status.task.totalLines
-            var currentLine = status.motion.motionLine
+            var totalLines = status.taskFields.totalLines
+            var currentLine = status.motionFields.motionLine
             if (currentLine > totalLines) {
                 currentLine = 0
             }
@@ -7,20 +7,20 @@ import Machinekit.Application 1.0
 
 Dialog {
     property var core: null
-    property var status: core === null ? {"synced": false} : core.status
+    property var status: core === null ? {"synced": false, "motionSynced": false, "configSynced": false, "ioSynced": false, "taskSynced": false, "interpSynced": false} : core.status
     property var command: core === null ? {"ready": false} : core.command
     property var file: core === null ? {"localPath":"", "remotePath":"", "localFilePath":"", "ready":false} : core.file
     property var fileDialog: null
 
-    property bool _ready: status.synced && file.ready && (file.transferState === ApplicationFile.NoTransfer)
+    property bool _ready: status.taskSynced && file.ready && (file.transferState === ApplicationFile.NoTransfer)
 
     function _openFile(row) {
         if (row < 0)
             return
 
-        if (status.task.taskMode !== ApplicationStatus.TaskModeAuto)
+        if (status.taskFields.taskMode !== ApplicationStatus.TaskModeAuto)
             command.setTaskMode('execute', ApplicationCommand.TaskModeAuto)
-        if (status.task.file !== "") {
+        if (status.taskFields.file !== "") {
             command.resetProgram('execute')
         }
         var fileName = tableView.model.getName(row)
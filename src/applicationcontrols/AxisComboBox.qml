@@ -29,9 +29,9 @@ ComboBox {
     property alias status: object.status
     property int axis: currentIndex
     property var axisNames: ["X", "Y", "Z", "A", "B", "C", "U", "V", "W"]
-    property int axes: status.synced ? status.config.axes : 3
+    property int axes: status.configSynced ? status.configFields.axes : 3
 
-    enabled: status.synced
+    enabled: status.configSynced
     model: axisNames.slice(0, axes)
 
     ApplicationObject {
@@ -32,7 +32,7 @@ RowLayout {
     property var axisNames: ["X", "Y", "Z", "A", "B", "C", "U", "V", "W"]
 
     id: root
-    enabled: status.synced
+    enabled: status.configSynced
 
     ExclusiveGroup {
         property int currentIndex: 0
@@ -40,7 +40,7 @@ RowLayout {
     }
 
     Repeater {
-        model: status.synced ? status.config.axes : 3
+        model: status.configSynced ? status.configFields.axes : 3
         RadioButton {
             exclusiveGroup: axisGroup
             text: root.axisNames[index]
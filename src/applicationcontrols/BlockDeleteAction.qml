@@ -25,23 +25,23 @@ import QtQuick.Controls 1.2
 import Machinekit.Application 1.0
 
 ApplicationAction {
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.motionSynced && status.taskSynced && status.interpSynced && command.connected
 
     id: root
     text: qsTr("Block Delete")
     shortcut: ""
     tooltip: qsTr("Enable block delete [%1]").arg(shortcut)
     onTriggered: {
-        if (status.task.taskMode !== ApplicationStatus.TaskModeManual)
+        if (status.taskFields.taskMode !== ApplicationStatus.TaskModeManual)
             command.setTaskMode('execute', ApplicationCommand.TaskModeManual)
         command.setBlockDeleteEnabled(checked)
     }
 
     checkable: true
 
-    checked: _ready ? status.motion.blockDelete : false
+    checked: _ready ? status.motionFields.blockDelete : false
 
     enabled: _ready
-             && (status.task.taskState === ApplicationStatus.TaskStateOn)
+             && (status.taskFields.taskState === ApplicationStatus.TaskStateOn)
              && !status.running
 }
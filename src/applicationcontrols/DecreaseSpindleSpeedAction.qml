@@ -25,22 +25,22 @@ import QtQuick.Controls 1.2
 import Machinekit.Application 1.0
 
 ApplicationAction {
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.motionSynced && status.taskSynced && status.interpSynced && command.connected
 
     id: root
     text: qsTr("-")
     shortcut: "F11"
     tooltip: qsTr("Turn spindle slower [%1]").arg(shortcut)
     onTriggered: {
-        if (status.task.taskMode !== ApplicationStatus.TaskModeManual) {
+        if (status.taskFields.taskMode !== ApplicationStatus.TaskModeManual) {
             command.setTaskMode('execute', ApplicationCommand.TaskModeManual)
         }
         command.setSpindle(ApplicationCommand.SpindleDecrease)
     }
 
     enabled: _ready
-             && (status.task.taskState === ApplicationStatus.TaskStateOn)
-             && (status.motion.spindleDirection !== 0)
+             && (status.taskFields.taskState === ApplicationStatus.TaskStateOn)
+             && (status.motionFields.spindleDirection !== 0)
              && !status.running
 }
 
@@ -32,35 +32,35 @@ ApplicationItem {
     property int decimals: 4
     property string prefix: ""
     property string suffix: ""
-    property int axes: _ready ? status.config.axes : 4
-    property var axisHomed: _ready ? status.motion.axis : [{"homed":false}, {"homed":false}, {"homed":false}, {"homed":false}]
+    property int axes: _ready ? status.configFields.axes : 4
+    property var axisHomed: _ready ? status.axes : [{"homed":false}, {"homed":false}, {"homed":false}, {"homed":false}]
     property var axisNames: ["X:", "Y:", "Z:", "A:", "B:", "C:", "U:", "V:", "W:"]
     property var g5xNames: ["G54", "G55", "G56", "G57", "G58", "G59", "G59.1", "G59.2", "G59.3"]
-    property int g5xIndex: _ready ? status.motion.g5xIndex : 1
+    property int g5xIndex: _ready ? status.motionFields.g5xIndex : 1
     property var position: getPosition()
-    property var dtg: _ready ? status.motion.dtg : {"x":0.0, "y":0.0, "z":0.0, "a":0.0, "b":0.0, "c":0.0, "u":0.0, "v":0.0, "w":0.0}
-    property var g5xOffset: _ready ? status.motion.g5xOffset : {"x":0.0, "y":0.0, "z":0.0, "a":0.0, "b":0.0, "c":0.0, "u":0.0, "v":0.0, "w":0.0}
-    property var g92Offset: _ready ? status.motion.g92Offset : {"x":0.0, "y":0.0, "z":0.0, "a":0.0, "b":0.0, "c":0.0, "u":0.0, "v":0.0, "w":0.0}
-    property var toolOffset: _ready ? status.io.toolOffset : {"x":0.0, "y":0.0, "z":0.0, "a":0.0, "b":0.0, "c":0.0, "u":0.0, "v":0.0, "w":0.0}
-    property double velocity: _ready ? status.motion.currentVel * _timeFactor : 0.0
-    property double distanceToGo: _ready ? status.motion.distanceToGo : 0.0
+    property var dtg: _ready ? status.dtg : {"x":0.0, "y":0.0, "z":0.0, "a":0.0, "b":0.0, "c":0.0, "u":0.0, "v":0.0, "w":0.0}
+    property var g5xOffset: _ready ? status.g5xOffset : {"x":0.0, "y":0.0, "z":0.0, "a":0.0, "b":0.0, "c":0.0, "u":0.0, "v":0.0, "w":0.0}
+    property var g92Offset: _ready ? status.g92Offset : {"x":0.0, "y":0.0, "z":0.0, "a":0.0, "b":0.0, "c":0.0, "u":0.0, "v":0.0, "w":0.0}
+    property var toolOffset: _ready ? status.toolOffset : {"x":0.0, "y":0.0, "z":0.0, "a":0.0, "b":0.0, "c":0.0, "u":0.0, "v":0.0, "w":0.0}
+    property double velocity: _ready ? status.motionFields.currentVel * _timeFactor : 0.0
+    property double distanceToGo: _ready ? status.motionFields.distanceToGo : 0.0
     property bool offsetsVisible: settings.initialized && settings.values.dro.showOffsets
     property bool velocityVisible: settings.initialized && settings.values.dro.showVelocity
     property bool distanceToGoVisible: settings.initialized && settings.values.dro.showDistanceToGo
-    property int positionFeedback: _ready ? status.config.positionFeedback : ApplicationStatus.ActualPositionFeedback
-    property int positionOffset: _ready ? status.config.positionOffset : ApplicationStatus.RelativePositionOffset
+    property int positionFeedback: _ready ? status.configFields.positionFeedback : ApplicationStatus.ActualPositionFeedback
+    property int positionOffset: _ready ? status.configFields.positionOffset : ApplicationStatus.RelativePositionOffset
 
-    property bool _ready: status.synced
+    property bool _ready: status.motionSynced && status.configSynced && status.ioSynced
     property var _axisNames: ["x", "y", "z", "a", "b", "c", "u", "v", "w"]
-    property double _timeFactor: (_ready && (status.config.timeUnits === ApplicationStatus.TimeUnitsMinute)) ? 60 : 1
+    property double _timeFactor: (_ready && (status.configFields.timeUnits === ApplicationStatus.TimeUnitsMinute)) ? 60 : 1
 
     function getPosition() {
-        var basePosition
+        var basePosition = {"x":0.0, "y":0.0, "z":0.0, "a":0.0, "b":0.0, "c":0.0, "u":0.0, "v":0.0, "w":0.0}
         if (_ready) {
-            basePosition = (positionFeedback == ApplicationStatus.ActualPositionFeedback) ? status.motion.actualPosition : status.motion.position
-        }
-        else {
-            basePosition = {"x":0.0, "y":0.0, "z":0.0, "a":0.0, "b":0.0, "c":0.0, "u":0.0, "v":0.0, "w":0.0}
+            var statusPosition = (positionFeedback == ApplicationStatus.ActualPositionFeedback) ? status.actualPosition : status.position
+            for (var j = 0; j < axes; ++j) {
+                basePosition[_axisNames[j]] = statusPosition[_axisNames[j]]
+            }
         }
 
         if (positionOffset == ApplicationStatus.RelativePositionOffset) {
@@ -25,7 +25,7 @@ import QtQuick.Controls 1.2
 import Machinekit.Application 1.0
 
 ApplicationAction {
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.taskSynced && command.connected
 
     id: root
     text: qsTr("Estop")
@@ -43,6 +43,6 @@ ApplicationAction {
         }
     }
 
-    checked: _ready && (status.task.taskState === ApplicationStatus.TaskStateEstop)
+    checked: _ready && (status.taskFields.taskState === ApplicationStatus.TaskStateEstop)
     enabled: _ready
 }
@@ -25,7 +25,7 @@ import Machinekit.Application 1.0
 
 ApplicationAction {
     property bool reset: false
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.taskSynced && command.connected
 
     id: root
     text: qsTr("Power")
@@ -36,7 +36,7 @@ ApplicationAction {
     checkable: true
     onTriggered: {
         if (!checked) {
-            if (status.task.taskState === ApplicationStatus.TaskStateEstop) {
+            if (status.taskFields.taskState === ApplicationStatus.TaskStateEstop) {
                 command.setTaskState('execute', ApplicationCommand.TaskStateEstopReset)
             }
             command.setTaskState('execute', ApplicationCommand.TaskStateOn)
@@ -51,6 +51,6 @@ ApplicationAction {
         }
     }
 
-    checked: _ready && (status.task.taskState !== ApplicationStatus.TaskStateOn)
+    checked: _ready && (status.taskFields.taskState !== ApplicationStatus.TaskStateOn)
     enabled: _ready
 }
@@ -30,7 +30,7 @@ ApplicationObject {
     property bool enabled: _ready
     property bool synced: false
 
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.motionSynced && status.configSynced && command.connected
     property bool _remoteUpdate: false
 
     onValueChanged: {
@@ -55,10 +55,10 @@ ApplicationObject {
 
     function _update() {
         _remoteUpdate = true
-        minimumValue = status.config.minFeedOverride
-        maximumValue = status.config.maxFeedOverride
-        if (value !== status.motion.feedrate) {
-            value = status.motion.feedrate
+        minimumValue = status.configFields.minFeedOverride
+        maximumValue = status.configFields.maxFeedOverride
+        if (value !== status.motionFields.feedrate) {
+            value = status.motionFields.feedrate
         }
         else {
             synced = true
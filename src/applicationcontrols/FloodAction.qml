@@ -25,24 +25,24 @@ import QtQuick.Controls 1.2
 import Machinekit.Application 1.0
 
 ApplicationAction {
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.ioSynced && status.taskSynced && status.interpSynced && command.connected
 
     id: root
     text: qsTr("Flood")
     shortcut: ""
     tooltip: qsTr("Enable flood [%1]").arg(shortcut)
     onTriggered: {
-        if (status.task.taskMode !== ApplicationStatus.TaskModeManual)
+        if (status.taskFields.taskMode !== ApplicationStatus.TaskModeManual)
             command.setTaskMode('execute', ApplicationCommand.TaskModeManual)
         command.setFloodEnabled(checked)
     }
 
     checkable: true
 
-    checked: _ready ? status.io.flood : false
+    checked: _ready ? status.ioFields.flood : false
 
     enabled: _ready
-             && (status.task.taskState === ApplicationStatus.TaskStateOn)
+             && (status.taskFields.taskState === ApplicationStatus.TaskStateOn)
              && !status.running
 }
 
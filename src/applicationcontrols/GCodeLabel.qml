@@ -31,9 +31,9 @@ Label {
     property var desiredGCodes: [1,2,3,4,5,6,7,8,9]
     property var desiredMCodes: [1,2,3,4,5,6,7,8,9,10,11,12,13,14,15]
 
-    property bool _ready: status.synced
-    property var _mcodes: _ready ? status.interp.mcodes : []
-    property var _gcodes: _ready ? status.interp.gcodes : []
+    property bool _ready: status.interpSynced
+    property var _mcodes: _ready ? status.interpFields.mcodes : []
+    property var _gcodes: _ready ? status.interpFields.gcodes : []
 
     text: {
         var mcodes = []
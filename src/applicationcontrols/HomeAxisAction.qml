@@ -26,13 +26,13 @@ import Machinekit.Application 1.0
 
 ApplicationAction {
     property int axis: 0
-    property bool homed: _ready ? (axis > -1 ? status.motion.axis[axis].homed : _allHomed()) : false
+    property bool homed: _ready ? (axis > -1 ? status.axes[axis].homed : _allHomed()) : false
 
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.motionSynced && status.configSynced && status.taskSynced && status.interpSynced && command.connected
 
     function _allHomed() {
-        for (var i = 0; i < status.config.axes; ++i) {
-            if (!status.motion.axis[i].homed) {
+        for (var i = 0; i < status.configFields.axes; ++i) {
+            if (!status.axes[i].homed) {
                 return false
             }
         }
@@ -44,10 +44,10 @@ ApplicationAction {
     shortcut: "Ctrl+Home"
     tooltip: ((axis > -1) ? (qsTr("Home axis %1 [%2]") + axis) : qsTr("Home all axes [%1]")).arg(shortcut)
     enabled: _ready
-             && (status.task.taskState === ApplicationStatus.TaskStateOn)
+             && (status.taskFields.taskState === ApplicationStatus.TaskStateOn)
              && !status.running
     onTriggered: {
-        if (status.task.taskMode !== ApplicationStatus.TaskModeManual)
+        if (status.taskFields.taskMode !== ApplicationStatus.TaskModeManual)
             command.setTaskMode('execute', ApplicationCommand.TaskModeManual)
 
         if (axis > -1) {
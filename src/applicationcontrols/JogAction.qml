@@ -29,14 +29,14 @@ ApplicationAction {
     property double velocity: settings.initialized ? settings.values["axis" + axis]["jogVelocity"] : 0.0
     property double distance: 0.0
 
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.taskSynced && status.interpSynced && command.connected
 
     id: root
     text: ""
     shortcut: ""
     tooltip: qsTr("Jog Axis %1 [%2]").arg(axis).arg(shortcut)
     onTriggered: {
-        if (status.task.taskMode !== ApplicationStatus.TaskModeManual) {
+        if (status.taskFields.taskMode !== ApplicationStatus.TaskModeManual) {
             command.setTaskMode('execute', ApplicationCommand.TaskModeManual)
         }
         if (velocity !== 0.0) {
@@ -52,6 +52,6 @@ ApplicationAction {
     }
 
     enabled: _ready
-             && (status.task.taskState === ApplicationStatus.TaskStateOn)
+             && (status.taskFields.taskState === ApplicationStatus.TaskStateOn)
              && !status.running
 }
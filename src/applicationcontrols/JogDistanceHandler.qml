@@ -31,7 +31,7 @@ ApplicationObject {
     property var incrementsModelReverse: incrementsModel.slice(0).reverse()
     property var distanceModel: continuousVisible ? _incrementsModelBase.concat([0]) : _incrementsModelBase
     property var distanceModelReverse: distanceModel.slice(0).reverse()
-    property var _incrementsModelBase: object.status.synced ? getIncrements() : []
+    property var _incrementsModelBase: object.status.configSynced ? getIncrements() : []
 
     function _compareNumbers(a, b)
     {
@@ -42,11 +42,11 @@ ApplicationObject {
 
     function getIncrements() {
         var axisIncrements = undefined
-        if ((object.axis >= 0) && (object.axis < object.status.config.axes)) {
-            axisIncrements = object.status.config.axis[object.axis].increments
+        if ((object.axis >= 0) && (object.axis < object.status.configFields.axes)) {
+            axisIncrements = object.status.configFields.axis[object.axis].increments
         }
         if ((axisIncrements === undefined) || (axisIncrements === "")) {
-            axisIncrements =  object.status.config.increments
+            axisIncrements =  object.status.configFields.increments
         }
         return axisIncrements.split(" ").sort(_compareNumbers)
     }
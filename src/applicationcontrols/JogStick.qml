@@ -31,7 +31,7 @@ VirtualJoystick {
     property int xAxis: 0
     property int yAxis: 1
 
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.taskSynced && status.interpSynced && command.connected
 
     id: root
 
@@ -39,7 +39,7 @@ VirtualJoystick {
         if (axis === -1)
             return
 
-        if (status.task.taskMode !== ApplicationStatus.TaskModeManual)
+        if (status.taskFields.taskMode !== ApplicationStatus.TaskModeManual)
             command.setTaskMode('execute', ApplicationCommand.TaskModeManual)
         if (value !== 0.0) {
             command.jog(ApplicationCommand.ContinuousJog, axis, value)
@@ -49,7 +49,7 @@ VirtualJoystick {
     }
 
     enabled: _ready
-             && (status.task.taskState === ApplicationStatus.TaskStateOn)
+             && (status.taskFields.taskState === ApplicationStatus.TaskStateOn)
              && !status.running
 
     onXValueChanged: _jog(xAxis, xValue)
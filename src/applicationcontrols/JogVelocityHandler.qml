@@ -38,7 +38,7 @@ ApplicationObject {
     property bool synced: false
 
     property double _timeFactor: (timeUnits == "min") ? 60 : 1
-    property bool _ready: status.synced && settings.initialized
+    property bool _ready: status.motionSynced && status.configSynced && settings.initialized
     property bool _remoteUpdate: false
 
     onValueChanged: {
@@ -84,9 +84,9 @@ ApplicationObject {
 
     function _update() {
         _remoteUpdate = true
-        minimumValue = status.config.minVelocity
-        var axisMaxVel = status.config.axis[axis].maxVelocity
-        var configMaxVel = status.config.maxVelocity
+        minimumValue = status.configFields.minVelocity
+        var axisMaxVel = status.configFields.axis[axis].maxVelocity
+        var configMaxVel = status.configFields.maxVelocity
         if ((axisMaxVel === undefined) || (axisMaxVel === 0) || (axisMaxVel > configMaxVel)) {
             maximumValue = configMaxVel
         } else {
@@ -112,7 +112,7 @@ ApplicationObject {
 
     function getTimeUnits() {
         if (_ready) {
-            switch (status.config.timeUnits) {
+            switch (status.configFields.timeUnits) {
             case ApplicationStatus.TimeUnitsMinute:
                 return "min"
             case ApplicationStatus.TimeUnitsSecond:
@@ -125,7 +125,7 @@ ApplicationObject {
 
     function getDistanceUnits() {
         if (_ready) {
-            switch (status.config.programUnits) {
+            switch (status.configFields.programUnits) {
             case ApplicationStatus.CanonUnitsInches:
                 return "in"
             case ApplicationStatus.CanonUnitsMm:
@@ -37,7 +37,7 @@ ApplicationObject {
     property bool synced: false
 
     property double _timeFactor: (timeUnits == "min") ? 60 : 1
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.motionSynced && status.configSynced && command.connected
     property bool _remoteUpdate: false
 
     onValueChanged: {
@@ -67,11 +67,11 @@ ApplicationObject {
 
     function _update() {
         _remoteUpdate = true                    // set remote
-        minimumValue = status.config.minVelocity
-        maximumValue = status.config.maxVelocity
+        minimumValue = status.configFields.minVelocity
+        maximumValue = status.configFields.maxVelocity
         minimumProportion = (minimumValue / maximumValue) * 100.0
 
-        var maxVelocity = status.motion.maxVelocity
+        var maxVelocity = status.motionFields.maxVelocity
         maxVelocity = Math.max(Math.min(maxVelocity, maximumValue), minimumValue)
         if (proportional) {
             maxVelocity /= maximumValue
@@ -90,7 +90,7 @@ ApplicationObject {
 
     function getTimeUnits() {
         if (_ready) {
-            switch (status.config.timeUnits) {
+            switch (status.configFields.timeUnits) {
             case ApplicationStatus.TimeUnitsMinute:
                 return "min"
             case ApplicationStatus.TimeUnitsSecond:
@@ -103,7 +103,7 @@ ApplicationObject {
 
     function getDistanceUnits() {
         if (_ready) {
-            switch (status.config.programUnits) {
+            switch (status.configFields.programUnits) {
             case ApplicationStatus.CanonUnitsInches:
                 return "in"
             case ApplicationStatus.CanonUnitsMm:
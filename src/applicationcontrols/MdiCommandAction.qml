@@ -28,14 +28,14 @@ ApplicationAction {
     property string mdiCommand: ""
     property bool enableHistory: true
 
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.taskSynced && status.interpSynced && command.connected
 
     id: root
     text: qsTr("Go")
     shortcut: ""
     tooltip: qsTr("Execute MDI command [%1]").arg(shortcut)
     onTriggered: {
-        if (status.task.taskMode !== ApplicationStatus.TaskModeMdi)
+        if (status.taskFields.taskMode !== ApplicationStatus.TaskModeMdi)
             command.setTaskMode('execute', ApplicationCommand.TaskModeMdi)
         command.executeMdi('execute', mdiCommand)
         if (enableHistory) {
@@ -43,8 +43,8 @@ ApplicationAction {
         }
     }
 
-    //checked: _ready && (status.task.taskState === ApplicationStatus.TaskStateEstop)
+    //checked: _ready && (status.taskFields.taskState === ApplicationStatus.TaskStateEstop)
     enabled: _ready
-             && (status.task.taskState === ApplicationStatus.TaskStateOn)
+             && (status.taskFields.taskState === ApplicationStatus.TaskStateOn)
              && !status.running
 }
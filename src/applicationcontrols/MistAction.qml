@@ -25,24 +25,24 @@ import QtQuick.Controls 1.2
 import Machinekit.Application 1.0
 
 ApplicationAction {
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.ioSynced && status.taskSynced && status.interpSynced && command.connected
 
     id: root
     text: qsTr("Mist")
     shortcut: ""
     tooltip: qsTr("Enable mist [%1]").arg(shortcut)
     onTriggered: {
-        if (status.task.taskMode !== ApplicationStatus.TaskModeManual)
+        if (status.taskFields.taskMode !== ApplicationStatus.TaskModeManual)
             command.setTaskMode('execute', ApplicationCommand.TaskModeManual)
         command.setMistEnabled(checked)
     }
 
     checkable: true
 
-    checked: _ready ? status.io.mist : false
+    checked: _ready ? status.ioFields.mist : false
 
     enabled: _ready
-             && (status.task.taskState === ApplicationStatus.TaskStateOn)
+             && (status.taskFields.taskState === ApplicationStatus.TaskStateOn)
              && !status.running
 }
 
@@ -25,7 +25,7 @@ import QtQuick.Controls 1.2
 import Machinekit.Application 1.0
 
 ApplicationAction {
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.taskSynced && command.connected
 
     id: root
     text: qsTr("Optional stop (M1)")
@@ -37,5 +37,5 @@ ApplicationAction {
         command.setOptionalStopEnabled(checked)
     }
     enabled: _ready
-    checked: _ready && status.task.optionalStop
+    checked: _ready && status.taskFields.optionalStop
 }
@@ -27,26 +27,26 @@ import Machinekit.Application 1.0
 ApplicationAction {
     property int axis: 0
 
-    property bool _ready: status.synced && command.connected
-    property bool _axisOnLimit: status.synced
-                                 && status.motion.axis[root.axis].minSoftLimit
-                                 && status.motion.axis[root.axis].maxSoftLimit
+    property bool _ready: status.motionSynced && status.taskSynced && status.interpSynced && command.connected
+    property bool _axisOnLimit: status.motionSynced
+                                 && status.axes[root.axis].minSoftLimit
+                                 && status.axes[root.axis].maxSoftLimit
 
     id: root
     text: qsTr("Override Limits")
     shortcut: ""
     tooltip: qsTr("Override the machine limits [%1]").arg(shortcut)
     onTriggered: {
-        if (status.task.taskMode !== ApplicationStatus.TaskModeManual) {
+        if (status.taskFields.taskMode !== ApplicationStatus.TaskModeManual) {
             command.setTaskMode('execute', ApplicationCommand.TaskModeManual)
         }
         ApplicationCommand.overrideLimits()
     }
 
     checkable: true
-    checked: _ready ? (status.motion.axis[root.axis].overrideLimits) : false
+    checked: _ready ? (status.axes[root.axis].overrideLimits) : false
     enabled: _ready
-             && (status.task.taskState === ApplicationStatus.TaskStateOn)
+             && (status.taskFields.taskState === ApplicationStatus.TaskStateOn)
              && !status.running
              && root._axisOnLimit
 }
@@ -28,7 +28,7 @@ ApplicationAction {
     property string pauseShortcut: "P"
     property string resumeShortcut: "S"
 
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.taskSynced && status.interpSynced && command.connected
 
     id: root
     checkable: true
@@ -44,6 +44,6 @@ ApplicationAction {
         }
     }
     enabled: _ready
-             && (status.task.taskState === ApplicationStatus.TaskStateOn)
+             && (status.taskFields.taskState === ApplicationStatus.TaskStateOn)
              && status.running
 }
@@ -25,7 +25,7 @@ import QtQuick.Controls 1.2
 import Machinekit.Application 1.0
 
 ApplicationAction {
-    property bool _ready: status.synced && command.connected && file.ready
+    property bool _ready: status.taskSynced && status.interpSynced && command.connected && file.ready
 
     id: openAction
     text: qsTr("Reopen file")
@@ -34,13 +34,13 @@ ApplicationAction {
     shortcut: "Ctrl+R"
     tooltip: qsTr("Reopen current file [%1]").arg(shortcut)
     onTriggered: {
-        if (status.task.taskMode !== ApplicationStatus.TaskModeAuto) {
+        if (status.taskFields.taskMode !== ApplicationStatus.TaskModeAuto) {
             command.setTaskMode('execute', ApplicationCommand.TaskModeAuto)
         }
         command.resetProgram('execute')
         command.openProgram('execute', file.remoteFilePath)
     }
     enabled: _ready
-             && (status.task.file !== "")
+             && (status.taskFields.file !== "")
              && !status.running
 }
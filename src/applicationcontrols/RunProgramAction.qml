@@ -28,7 +28,7 @@ ApplicationAction {
     property int programStartLine: 0
     property int programResetLine: 0
 
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.taskSynced && status.interpSynced && command.connected
 
     id: root
     text: qsTr("Run")
@@ -36,13 +36,13 @@ ApplicationAction {
     shortcut: "R"
     tooltip: qsTr("Begin executing current file [%1]").arg(shortcut)
     onTriggered: {
-        if (status.task.taskMode !== ApplicationStatus.TaskModeAuto)
+        if (status.taskFields.taskMode !== ApplicationStatus.TaskModeAuto)
             command.setTaskMode('execute', ApplicationCommand.TaskModeAuto)
         command.runProgram('execute', programStartLine)
         programStartLine = programResetLine
     }
     enabled: _ready
-             && (status.task.taskState === ApplicationStatus.TaskStateOn)
-             && (status.task.file !== "")
+             && (status.taskFields.taskState === ApplicationStatus.TaskStateOn)
+             && (status.taskFields.file !== "")
              && !status.running
 }
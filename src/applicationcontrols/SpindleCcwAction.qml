@@ -25,23 +25,23 @@ import QtQuick.Controls 1.2
 import Machinekit.Application 1.0
 
 ApplicationAction {
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.motionSynced && status.configSynced && status.taskSynced && status.interpSynced && command.connected
 
     id: root
     text: qsTr("CCW")
     shortcut: "F10"
     tooltip: qsTr("Turn spindle counterclockwise [%1]").arg(shortcut)
     onTriggered: {
-        if (status.task.taskMode !== ApplicationStatus.TaskModeManual) {
+        if (status.taskFields.taskMode !== ApplicationStatus.TaskModeManual) {
             command.setTaskMode('execute', ApplicationCommand.TaskModeManual)
         }
-        command.setSpindle(ApplicationCommand.SpindleReverse, status.config.defaultSpindleSpeed)
+        command.setSpindle(ApplicationCommand.SpindleReverse, status.configFields.defaultSpindleSpeed)
     }
 
     checkable: true
-    checked: _ready ? (status.motion.spindleDirection === -1) : false
+    checked: _ready ? (status.motionFields.spindleDirection === -1) : false
     enabled: _ready
-             && (status.task.taskState === ApplicationStatus.TaskStateOn)
+             && (status.taskFields.taskState === ApplicationStatus.TaskStateOn)
              && !status.running
 }
 
@@ -30,7 +30,7 @@ ApplicationObject {
     property bool enabled: _ready
     property bool synced: false
 
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.motionSynced && status.configSynced && command.connected
     property bool _remoteUpdate: false
 
     onValueChanged: {
@@ -55,10 +55,10 @@ ApplicationObject {
 
     function _update() {
         _remoteUpdate = true
-        minimumValue = status.config.minSpindleOverride
-        maximumValue = status.config.maxSpindleOverride
-        if (value !== status.motion.spindlerate) {
-            value = status.motion.spindlerate
+        minimumValue = status.configFields.minSpindleOverride
+        maximumValue = status.configFields.maxSpindleOverride
+        if (value !== status.motionFields.spindlerate) {
+            value = status.motionFields.spindlerate
         }
         else {
             synced = true
@@ -25,7 +25,7 @@ import QtQuick.Controls 1.2
 import Machinekit.Application 1.0
 
 ApplicationAction {
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.taskSynced && status.interpSynced && command.connected
 
     id: root
     text: qsTr("Step")
@@ -33,12 +33,12 @@ ApplicationAction {
     shortcut: "T"
     tooltip: qsTr("Execute next line [%1]").arg(shortcut)
     onTriggered: {
-        if (status.task.taskMode !== ApplicationStatus.TaskModeAuto)
+        if (status.taskFields.taskMode !== ApplicationStatus.TaskModeAuto)
             command.setTaskMode('execute', ApplicationCommand.TaskModeAuto)
         command.stepProgram('execute')
     }
     enabled: _ready
-             && (status.task.taskState === ApplicationStatus.TaskStateOn)
-             && (status.task.file !== "")
+             && (status.taskFields.taskState === ApplicationStatus.TaskStateOn)
+             && (status.taskFields.file !== "")
              && !status.running
 }
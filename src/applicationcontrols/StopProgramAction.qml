@@ -25,7 +25,7 @@ import QtQuick.Controls 1.2
 import Machinekit.Application 1.0
 
 ApplicationAction {
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.motionSynced && status.taskSynced && command.connected
 
     id: root
     text: qsTr("Stop")
@@ -36,6 +36,6 @@ ApplicationAction {
         command.abort('execute')
     }
     enabled: _ready
-             && (status.task.taskState === ApplicationStatus.TaskStateOn)
-             && status.motion.state === ApplicationStatus.MotionExec
+             && (status.taskFields.taskState === ApplicationStatus.TaskStateOn)
+             && status.motionFields.state === ApplicationStatus.MotionExec
 }
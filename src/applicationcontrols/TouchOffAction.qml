@@ -27,7 +27,7 @@ import Machinekit.Application 1.0
 ApplicationAction {
     property var touchOffDialog
 
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.taskSynced && status.interpSynced && command.connected
 
     id: root
     text: qsTr("Touch Off")
@@ -38,7 +38,7 @@ ApplicationAction {
     }
 
     enabled: _ready
-             && (status.task.taskState === ApplicationStatus.TaskStateOn)
+             && (status.taskFields.taskState === ApplicationStatus.TaskStateOn)
              && !status.running
 }
 
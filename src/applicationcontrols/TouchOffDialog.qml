@@ -34,7 +34,7 @@ Dialog {
     property var axisNames: ["X", "Y", "Z", "A", "B", "C", "U", "V", "W"]
     property var _axisNames: ["x", "y", "z", "a", "b", "c", "u", "v", "w"]
 
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.motionSynced && status.configSynced && status.ioSynced && status.taskSynced && command.connected
     property bool _done: true
 
     id: dialog
@@ -46,18 +46,18 @@ Dialog {
         if (visible) {
             _done = false
             coordinateSpin.value = 0.0
-            coordinateSystemCombo.currentIndex = status.motion.g5xIndex - 1
+            coordinateSystemCombo.currentIndex = status.motionFields.g5xIndex - 1
         }
     }
 
     onAccepted: {
         if (_ready && !_done) {
-            if (status.task.taskMode !== ApplicationStatus.TaskModeMdi) {
+            if (status.taskFields.taskMode !== ApplicationStatus.TaskModeMdi) {
                 command.setTaskMode('execute', ApplicationCommand.TaskModeMdi)
             }
             var axisName = _axisNames[axis]
-            var position = status.motion.position[axisName] - status.motion.g92Offset[axisName] - status.io.toolOffset[axisName]
-            var newOffset = (position - coordinateSpin.value) / status.config.axis[axis].units
+            var position = status.position[axisName] - status.g92Offset[axisName] - status.toolOffset[axisName]
+            var newOffset = (position - coordinateSpin.value) / status.configFields.axis[axis].units
             var mdi = "G10 L2 P" + (coordinateSystemCombo.currentIndex + 1) + " " + axisNames[axis] + newOffset.toFixed(6)
             command.executeMdi('execute', mdi)
         }
@@ -27,26 +27,26 @@ import Machinekit.Application 1.0
 ApplicationAction {
     property int axis: 0
 
-    property bool _ready: status.synced && command.connected
+    property bool _ready: status.motionSynced && status.configSynced && status.taskSynced && status.interpSynced && command.connected
 
     id: root
     text: qsTr("Unhome")
     shortcut: "Ctrl+Shift+Home"
     tooltip: qsTr("Unhome axis %1 [%2]").arg(axis).arg(shortcut)
     enabled: _ready
-             && (status.task.taskState === ApplicationStatus.TaskStateOn)
+             && (status.taskFields.taskState === ApplicationStatus.TaskStateOn)
              && !status.running
 
     onTriggered: {
-        if (status.task.taskMode !== ApplicationStatus.TaskModeManual)
+        if (status.taskFields.taskMode !== ApplicationStatus.TaskModeManual)
             command.setTaskMode('execute', ApplicationCommand.TaskModeManual)
 
         if (axis > -1) {
             command.unhomeAxis(axis)
         }
         else {
-            for (var i = 0; i < status.config.axes; ++i) {
-                if (status.motion.axis[i].homed) {
+            for (var i = 0; i < status.configFields.axes; ++i) {
+                if (status.axes[i].homed) {
                     command.unhomeAxis(i)
                 }
             }
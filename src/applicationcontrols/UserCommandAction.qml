@@ -25,11 +25,11 @@ import Machinekit.Application 1.0
 MdiCommandAction {
     property var commands: {
         var commandList = []
-        if ((status.synced) && (status.config.userCommand !== undefined))
+        if ((status.configSynced) && (status.configFields.userCommand !== undefined))
         {
-            for (var i = 0; i < status.config.userCommand.length; ++i)
+            for (var i = 0; i < status.configFields.userCommand.length; ++i)
             {
-                var command = status.config.userCommand[i]
+                var command = status.configFields.userCommand[i]
                 if (command === "") {
                     continue
                 }
@@ -1,6 +1,10 @@
-HEADERS += $$PWD/abstractserviceimplementation.h \
-    $$PWD/service.h
-SOURCES += $$PWD/abstractserviceimplementation.cpp \
-    $$PWD/service.cpp
-
+# Include this file into a plugin to link the common library
+COMMON_PATH = $$OUT_PWD/../common
 INCLUDEPATH += $$PWD
+
+# the library has to be linked before the libraries it depends on
+!win32 {
+    LIBS = -L$$COMMON_PATH -lmachinekit-common $$LIBS
+} else {
+    LIBS = -L$$COMMON_PATH/release -L$$COMMON_PATH/debug -lmachinekit-common $$LIBS
+}
@@ -0,0 +1,33 @@
+# Shared by all plugins, so the transport manager and the threaded
+# transport exist once per process instead of once per plugin.
+QT     += qml
+QT     -= gui
+CONFIG -= android_install
+
+macx | win32: {
+    CONFIG += static
+}
+
+TARGET = machinekit-common
+TEMPLATE = lib
+
+include(../../paths.pri)
+include(../zeromq.pri)
+include(../../3rdparty/machinetalk-protobuf-qt/machinetalk-protobuf-lib.pri)
+
+HEADERS += abstractserviceimplementation.h \
+    messageconverter.h \
+    messagedecoder.h \
+    threadedzmqcontext.h \
+    transportmanager.h \
+    service.h
+SOURCES += abstractserviceimplementation.cpp \
+    messageconverter.cpp \
+    messagedecoder.cpp \
+    threadedzmqcontext.cpp \
+    transportmanager.cpp \
+    service.cpp
+
+win32: target.path = $$[QT_INSTALL_BINS]
+!win32: target.path = $$[QT_INSTALL_LIBS]
+INSTALLS += target
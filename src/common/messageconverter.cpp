@@ -0,0 +1,257 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+
+#include "messageconverter.h"
+#include <QMutex>
+#include <QJsonArray>
+
+struct MessageConverterCache {
+    QMutex mutex;
+    QHash<const gpb::Descriptor*, MessageConverter*> converters;
+
+    ~MessageConverterCache()
+    {
+        qDeleteAll(converters);
+    }
+};
+
+Q_GLOBAL_STATIC(MessageConverterCache, converterCache)
+
+MessageConverter::MessageConverter(const gpb::Descriptor *descriptor) :
+    m_descriptor(descriptor),
+    m_isFile(descriptor == pb::File::descriptor()),
+    m_isPosition(descriptor == pb::Position::descriptor())
+{
+}
+
+/** Returns the converter for a message type, it is created on first use.
+ *  Converters are never changed after creation and may be shared
+ *  between threads.
+ **/
+const MessageConverter *MessageConverter::converter(const gpb::Descriptor *descriptor)
+{
+    MessageConverterCache *cache = converterCache();
+    QMutexLocker locker(&cache->mutex);
+
+    return createConverter(descriptor);
+}
+
+/** Creates the converters of a message type and all nested types, the cache must be locked */
+MessageConverter *MessageConverter::createConverter(const gpb::Descriptor *descriptor)
+{
+    MessageConverterCache *cache = converterCache();
+    MessageConverter *converter = cache->converters.value(descriptor, NULL);
+
+    if (converter != NULL)
+    {
+        return converter;
+    }
+
+    converter = new MessageConverter(descriptor);
+    cache->converters.insert(descriptor, converter);    // before the fields, types may be recursive
+
+    for (int i = 0; i < descriptor->field_count(); ++i)
+    {
+        Field field;
+
+        field.descriptor = descriptor->field(i);
+        field.name = QString::fromStdString(field.descriptor->camelcase_name());
+        field.positionName = QString::number(field.descriptor->index());
+        field.indexField = NULL;
+        field.valueField = NULL;
+        field.converter = NULL;
+
+        if (field.descriptor->cpp_type() == gpb::FieldDescriptor::CPPTYPE_MESSAGE)
+        {
+            const gpb::Descriptor *subDescriptor = field.descriptor->message_type();
+
+            field.converter = createConverter(subDescriptor);
+
+            if (field.descriptor->is_repeated())
+            {
+                field.indexField = subDescriptor->FindFieldByName("index");
+
+                if ((field.indexField != NULL) && (subDescriptor->field_count() == 2))   // index and value field
+                {
+                    field.valueField = subDescriptor->field((field.indexField->index() == 0) ? 1 : 0);
+                }
+            }
+        }
+
+        converter->m_fieldIndexes.insert(field.name, converter->m_fields.size());
+        converter->m_fields.append(field);
+    }
+
+    return converter;
+}
+
+/** Merges the set fields of message into object, the names of the
+ *  merged fields are appended to updatedFields if given.
+ **/
+void MessageConverter::toJson(const gpb::Message &message, QJsonObject *object, const QString &fieldFilter, const QString &tempDir, QStringList *updatedFields) const
+{
+    const gpb::Reflection *reflection = message.GetReflection();
+
+    if (m_isFile)   // handle files with binary data
+    {
+        Service::fileToJson(static_cast<const pb::File &>(message), object, tempDir);
+        return;
+    }
+
+    if (!fieldFilter.isEmpty())
+    {
+        int index = m_fieldIndexes.value(fieldFilter, -1);
+        if ((index != -1)
+            && fieldToJson(message, reflection, m_fields.at(index), object, tempDir)
+            && (updatedFields != NULL))
+        {
+            updatedFields->append(fieldFilter);
+        }
+        return;
+    }
+
+    for (int i = 0; i < m_fields.size(); ++i)
+    {
+        if (fieldToJson(message, reflection, m_fields.at(i), object, tempDir)
+            && (updatedFields != NULL))
+        {
+            updatedFields->append(m_fields.at(i).name);
+        }
+    }
+}
+
+bool MessageConverter::fieldToJson(const gpb::Message &message, const gpb::Reflection *reflection, const Field &field, QJsonObject *object, const QString &tempDir) const
+{
+    if (!field.descriptor->is_repeated())
+    {
+        QJsonValue jsonValue;
+
+        if (!reflection->HasField(message, field.descriptor))
+        {
+            return false;
+        }
+
+        jsonValue = valueToJson(message, reflection, field.descriptor, field.converter,
+                                (field.converter != NULL) ? object->value(field.name) : QJsonValue(),
+                                tempDir);
+        object->insert(field.name, jsonValue);
+
+        if (m_isPosition && (field.descriptor->cpp_type() == gpb::FieldDescriptor::CPPTYPE_DOUBLE))
+        {
+            object->insert(field.positionName, jsonValue);
+        }
+
+        return true;
+    }
+    else if ((field.converter != NULL) && (field.indexField != NULL))
+    {
+        int size = reflection->FieldSize(message, field.descriptor);
+        QJsonArray jsonArray;
+
+        if (size == 0)
+        {
+            return false;
+        }
+
+        jsonArray = object->value(field.name).toArray();
+
+        for (int j = 0; j < size; ++j)
+        {
+            const gpb::Message &subMessage = reflection->GetRepeatedMessage(message, field.descriptor, j);
+            const gpb::Reflection *subReflection = subMessage.GetReflection();
+            int index = subReflection->GetInt32(subMessage, field.indexField);
+
+            while (jsonArray.size() < (index + 1))
+            {
+                jsonArray.append(QJsonValue());
+            }
+
+            if (field.valueField != NULL)
+            {
+                if (!subReflection->HasField(subMessage, field.valueField))
+                {
+                    continue;
+                }
+
+                const MessageConverter *valueConverter = NULL;
+                if (field.valueField->cpp_type() == gpb::FieldDescriptor::CPPTYPE_MESSAGE)
+                {
+                    valueConverter = field.converter->m_fields.at(field.valueField->index()).converter;
+                }
+
+                jsonArray.replace(index, field.converter->valueToJson(subMessage, subReflection, field.valueField,
+                                                                      valueConverter, QJsonValue(), tempDir));
+            }
+            else
+            {
+                QJsonObject jsonObject = jsonArray.at(index).toObject(QJsonObject());
+                field.converter->toJson(subMessage, &jsonObject, QString(), tempDir);
+                jsonObject.remove("index");
+                jsonArray.replace(index, jsonObject);
+            }
+        }
+
+        object->insert(field.name, jsonArray);
+
+        return true;
+    }
+
+    return false;
+}
+
+QJsonValue MessageConverter::valueToJson(const gpb::Message &message, const gpb::Reflection *reflection, const gpb::FieldDescriptor *field, const MessageConverter *converter, const QJsonValue &previous, const QString &tempDir) const
+{
+    switch (field->cpp_type())
+    {
+    case gpb::FieldDescriptor::CPPTYPE_BOOL:
+        return reflection->GetBool(message, field);
+    case gpb::FieldDescriptor::CPPTYPE_DOUBLE:
+        return reflection->GetDouble(message, field);
+    case gpb::FieldDescriptor::CPPTYPE_FLOAT:
+        return (double)reflection->GetFloat(message, field);
+    case gpb::FieldDescriptor::CPPTYPE_INT32:
+        return (int)reflection->GetInt32(message, field);
+    case gpb::FieldDescriptor::CPPTYPE_INT64:
+        return (int)reflection->GetInt64(message, field);
+    case gpb::FieldDescriptor::CPPTYPE_UINT32:
+        return (int)reflection->GetUInt32(message, field);
+    case gpb::FieldDescriptor::CPPTYPE_UINT64:
+        return (int)reflection->GetUInt64(message, field);
+    case gpb::FieldDescriptor::CPPTYPE_STRING:
+    {
+        std::string scratch;
+        const std::string &value = reflection->GetStringReference(message, field, &scratch);
+        return QString::fromUtf8(value.data(), static_cast<int>(value.size()));
+    }
+    case gpb::FieldDescriptor::CPPTYPE_ENUM:
+        return reflection->GetEnum(message, field)->number();
+    case gpb::FieldDescriptor::CPPTYPE_MESSAGE:
+    {
+        QJsonObject jsonObject = previous.toObject();
+        converter->toJson(reflection->GetMessage(message, field), &jsonObject, QString(), tempDir);
+        return jsonObject;
+    }
+    }
+
+    return QJsonValue();
+}
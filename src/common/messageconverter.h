@@ -0,0 +1,81 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+
+#ifndef MESSAGECONVERTER_H
+#define MESSAGECONVERTER_H
+
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QVector>
+#include <QHash>
+#include "service.h"
+
+/** Converts protobuf messages of one type to JSON objects.
+ *  The field layout is resolved once per message type from the
+ *  descriptor, converting a message only walks the prepared fields.
+ **/
+class MessageConverter
+{
+public:
+    static const MessageConverter *converter(const gpb::Descriptor *descriptor);
+
+    void toJson(const gpb::Message &message,
+                QJsonObject *object,
+                const QString &fieldFilter,
+                const QString &tempDir,
+                QStringList *updatedFields = NULL) const;
+
+private:
+    struct Field {
+        const gpb::FieldDescriptor *descriptor;
+        QString name;
+        QString positionName;                       // axis index of position vectors
+        const gpb::FieldDescriptor *indexField;     // index of repeated message elements
+        const gpb::FieldDescriptor *valueField;     // set if the element has only index and value
+        const MessageConverter *converter;          // converter of message fields
+    };
+
+    explicit MessageConverter(const gpb::Descriptor *descriptor);
+
+    static MessageConverter *createConverter(const gpb::Descriptor *descriptor);
+
+    bool fieldToJson(const gpb::Message &message,
+                     const gpb::Reflection *reflection,
+                     const Field &field,
+                     QJsonObject *object,
+                     const QString &tempDir) const;
+    QJsonValue valueToJson(const gpb::Message &message,
+                           const gpb::Reflection *reflection,
+                           const gpb::FieldDescriptor *field,
+                           const MessageConverter *converter,
+                           const QJsonValue &previous,
+                           const QString &tempDir) const;
+
+    const gpb::Descriptor *m_descriptor;
+    bool m_isFile;
+    bool m_isPosition;
+    QVector<Field> m_fields;
+    QHash<QString, int> m_fieldIndexes;
+};
+
+#endif // MESSAGECONVERTER_H
@@ -0,0 +1,197 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+#include "messagedecoder.h"
+#include <QMutex>
+#include <QDateTime>
+#include <QVector>
+
+static const int maximumPoolSize = 16;  // containers in flight at the same time are rare
+
+class PooledContainer
+{
+public:
+    explicit PooledContainer(ContainerPool *pool) :
+        pool(pool),
+        receiveTime(0)
+    {
+    }
+
+    pb::Container container;
+    ContainerPool *pool;
+    qint64 receiveTime;     // ms since epoch
+    QAtomicInt ref;
+};
+
+/** Free list of containers of one decoder. The pool is referenced by the
+ *  decoder and by every container taken from it, so it stays alive until
+ *  the decoder is deleted and all its containers have been returned.
+ **/
+class ContainerPool
+{
+public:
+    ContainerPool() :
+        m_ref(1)
+    {
+        m_free.reserve(maximumPoolSize);
+    }
+
+    ~ContainerPool()
+    {
+        qDeleteAll(m_free);
+    }
+
+    PooledContainer *take()
+    {
+        PooledContainer *container = NULL;
+
+        m_mutex.lock();
+        if (!m_free.isEmpty())
+        {
+            container = m_free.last();
+            m_free.removeLast();
+        }
+        m_mutex.unlock();
+
+        if (container == NULL)
+        {
+            container = new PooledContainer(this);
+        }
+        container->ref.store(1);
+        m_ref.ref();
+
+        return container;
+    }
+
+    void recycle(PooledContainer *container)
+    {
+        m_mutex.lock();
+        if (m_free.size() < maximumPoolSize)
+        {
+            m_free.append(container);
+            container = NULL;
+        }
+        m_mutex.unlock();
+
+        delete container;
+        release();
+    }
+
+    void release()
+    {
+        if (!m_ref.deref())
+        {
+            delete this;
+        }
+    }
+
+private:
+    QAtomicInt m_ref;
+    QMutex m_mutex;
+    QVector<PooledContainer*> m_free;
+};
+
+ContainerPointer::ContainerPointer() :
+    d(NULL)
+{
+}
+
+ContainerPointer::ContainerPointer(PooledContainer *container) :
+    d(container)
+{
+}
+
+ContainerPointer::ContainerPointer(const ContainerPointer &other) :
+    d(other.d)
+{
+    if (d != NULL)
+    {
+        d->ref.ref();
+    }
+}
+
+ContainerPointer::~ContainerPointer()
+{
+    if ((d != NULL) && !d->ref.deref())
+    {
+        d->pool->recycle(d);
+    }
+}
+
+ContainerPointer &ContainerPointer::operator=(const ContainerPointer &other)
+{
+    ContainerPointer copy(other);
+    qSwap(d, copy.d);   // the old container is released by copy
+    return *this;
+}
+
+const pb::Container &ContainerPointer::operator*() const
+{
+    return d->container;
+}
+
+const pb::Container *ContainerPointer::operator->() const
+{
+    return &d->container;
+}
+
+qint64 ContainerPointer::receiveTime() const
+{
+    return d->receiveTime;
+}
+
+MessageDecoder::MessageDecoder(QObject *parent) :
+    QObject(parent),
+    m_pool(new ContainerPool())
+{
+}
+
+MessageDecoder::~MessageDecoder()
+{
+    m_pool->release();
+}
+
+/** Subscribe messages carry the topic in the first frame.
+ *  The message is parsed into a container of the pool, parsing clears
+ *  the container but keeps the memory of its repeated fields and strings.
+ **/
+void MessageDecoder::decode(const ThreadedZMQFrameList &messageList)
+{
+    QByteArray topic;
+    const ThreadedZMQFrame &payload = messageList.last();
+    PooledContainer *container = m_pool->take();
+
+    if (messageList.size() > 1) {
+        topic = messageList.at(0).toByteArray();
+    }
+
+    container->receiveTime = QDateTime::currentMSecsSinceEpoch();
+    container->container.ParseFromArray(payload.data(), payload.size());
+    decodeMessage(topic, ContainerPointer(container), payload.size());
+}
+
+void MessageDecoder::decodeMessage(const QByteArray &topic, const ContainerPointer &container, int size)
+{
+    Q_UNUSED(size)
+
+    emit messageDecoded(topic, container);
+}
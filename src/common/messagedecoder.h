@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+#ifndef MESSAGEDECODER_H
+#define MESSAGEDECODER_H
+
+#include <QObject>
+#include <QAtomicInt>
+#include <machinetalk/protobuf/message.pb.h>
+#include "threadedzmqcontext.h"
+
+class ContainerPool;
+class PooledContainer;
+
+/** A shared, read-only reference to a decoded container.
+ *  The container is taken from the pool of a decoder and returned to it
+ *  when the last reference is released, so decoding a message does not
+ *  allocate once the pool is warm. References may be released in any thread.
+ **/
+class ContainerPointer
+{
+public:
+    ContainerPointer();
+    ContainerPointer(const ContainerPointer &other);
+    ~ContainerPointer();
+
+    ContainerPointer &operator=(const ContainerPointer &other);
+
+    const pb::Container &operator*() const;
+    const pb::Container *operator->() const;
+    qint64 receiveTime() const;     // ms since epoch, taken on the decoder thread
+    bool isNull() const
+    {
+        return d == NULL;
+    }
+
+private:
+    explicit ContainerPointer(PooledContainer *container);   // takes over the reference
+
+    PooledContainer *d;
+
+    friend class MessageDecoder;
+};
+
+/** Parses the messages of a socket on the decoder thread of the
+ *  transport manager. The parsed containers are not modified anymore
+ *  and handed to the owner of the socket with messageDecoded.
+ *  Subclasses can do further processing in decodeMessage.
+ **/
+class MessageDecoder : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MessageDecoder(QObject *parent = 0);
+    ~MessageDecoder();
+
+public slots:
+    void decode(const ThreadedZMQFrameList &messageList);
+
+private:
+    ContainerPool *m_pool;
+
+protected:
+    virtual void decodeMessage(const QByteArray &topic, const ContainerPointer &container, int size);
+
+signals:
+    void messageDecoded(const QByteArray &topic, const ContainerPointer &container);
+};
+
+Q_DECLARE_METATYPE(ContainerPointer)
+
+#endif // MESSAGEDECODER_H
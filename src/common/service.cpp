@@ -1,4 +1,5 @@
 #include "service.h"
+#include "messageconverter.h"
 #include <QDebug>
 
 Service::Service(QObject *parent) : QObject(parent)
@@ -105,122 +106,18 @@ void Service::recurseDescriptor(const gpb::Descriptor *descriptor, QJsonObject *
     }
 }
 
+/** Merges the set fields of a message into a JSON object.
+ *  The conversion uses a converter prepared once per message type.
+ **/
 void Service::recurseMessage(const gpb::Message &message, QJsonObject *object, const QString &fieldFilter, const QString &tempDir)
 {
-    bool filterEnabled = !fieldFilter.isEmpty();
-    bool isPosition = false;
-    const gpb::Reflection *reflection = message.GetReflection();
-    gpb::vector< const gpb::FieldDescriptor * > output;
-    reflection->ListFields(message, &output);
-
-    if (message.GetDescriptor() == pb::File::descriptor())  // handle files with binary data
-    {
-        pb::File file;
-        file.MergeFrom(message);
-        fileToJson(file, object, tempDir);
-        return;
-    }
-    else if (message.GetDescriptor() == pb::Position::descriptor()) // handle position vecotors
-    {
-        isPosition = true;
-    }
-
-    for (int i = 0; i < (int)output.size(); ++i)
-    {
-        QString name;
-        QJsonValue jsonValue;
-        const gpb::FieldDescriptor *field;
-
-        field = output[i];
-        name = QString::fromStdString(field->camelcase_name());
-
-        if (filterEnabled && (name != fieldFilter)) {
-            continue;
-        }
-
-        if (!field->is_repeated())
-        {
-            switch (field->cpp_type())
-            {
-            case gpb::FieldDescriptor::CPPTYPE_BOOL:
-                jsonValue = reflection->GetBool(message, field);
-                break;
-            case gpb::FieldDescriptor::CPPTYPE_DOUBLE:
-                jsonValue = reflection->GetDouble(message, field);
-                if (isPosition) {
-                    object->insert(QString::number(field->index()), jsonValue);
-                }
-                break;
-            case gpb::FieldDescriptor::CPPTYPE_FLOAT:
-                jsonValue = (double)reflection->GetFloat(message, field);
-                break;
-            case gpb::FieldDescriptor::CPPTYPE_INT32:
-                jsonValue = (int)reflection->GetInt32(message, field);
-                break;
-            case gpb::FieldDescriptor::CPPTYPE_INT64:
-                jsonValue = (int)reflection->GetInt64(message, field);
-                break;
-            case gpb::FieldDescriptor::CPPTYPE_UINT32:
-                jsonValue = (int)reflection->GetUInt32(message, field);
-                break;
-            case gpb::FieldDescriptor::CPPTYPE_UINT64:
-                jsonValue = (int)reflection->GetUInt64(message, field);
-                break;
-            case gpb::FieldDescriptor::CPPTYPE_STRING:
-                jsonValue = QString::fromStdString(reflection->GetString(message, field));
-                break;
-            case gpb::FieldDescriptor::CPPTYPE_ENUM:
-                jsonValue = reflection->GetEnum(message, field)->number();
-                //jsonValue = enumNameToCamelCase(QString::fromStdString(reflection->GetEnum(message, field)->name()));
-                break;
-            case gpb::FieldDescriptor::CPPTYPE_MESSAGE:
-                QJsonObject jsonObject = object->value(name).toObject();
-                recurseMessage(reflection->GetMessage(message, field), &jsonObject, QString(), tempDir);
-                jsonValue = jsonObject;
-                break;
-            }
-            object->insert(name, jsonValue);
-        }
-        else
-        {
-            if (field->cpp_type() == gpb::FieldDescriptor::CPPTYPE_MESSAGE)
-            {
-                QJsonArray jsonArray = object->value(name).toArray();
-                for (int j = 0; j < reflection->FieldSize(message, field); ++j)
-                {
-                    QJsonObject jsonObject;
-                    QJsonValue jsonValue;
-                    const gpb::Message &subMessage = reflection->GetRepeatedMessage(message, field, j);
-                    const gpb::Descriptor *subDescriptor = subMessage.GetDescriptor();
-                    const gpb::FieldDescriptor *subField = subDescriptor->FindFieldByName("index");
-                    const gpb::Reflection *subReflection = subMessage.GetReflection();
-                    int index = subReflection->GetInt32(subMessage, subField);
-
-                    while (jsonArray.size() < (index + 1))
-                    {
-                        jsonArray.append(QJsonValue());
-                    }
-
-                    if (subDescriptor->field_count() == 2)  // index and value field
-                    {
-                        recurseMessage(subMessage, &jsonObject, QString(), tempDir);
-                        jsonObject.remove("index");
-                        jsonValue = jsonObject.value(jsonObject.keys().at(0));
-                    }
-                    else
-                    {
-                        jsonObject = jsonArray.at(index).toObject(QJsonObject());
-                        recurseMessage(subMessage, &jsonObject, QString(), tempDir);
-                        jsonObject.remove("index");
-                        jsonValue = jsonObject;
-                    }
+    MessageConverter::converter(message.GetDescriptor())->toJson(message, object, fieldFilter, tempDir);
+}
 
-                    jsonArray.replace(index, jsonValue);
-                }
-                object->insert(name, QJsonValue(jsonArray));
-            }
-        }
-    }
+/** Like recurseMessage, the names of the updated fields are appended to updatedFields */
+void Service::recurseMessage(const gpb::Message &message, QJsonObject *object, QStringList *updatedFields, const QString &tempDir)
+{
+    MessageConverter::converter(message.GetDescriptor())->toJson(message, object, QString(), tempDir, updatedFields);
 }
 
 void Service::updateValue(const gpb::Message &message, QJsonValue *value, const QString &field, const QString &tempDir)
@@ -63,6 +63,10 @@ public:
                                QJsonObject *object,
                                const QString &fieldFilter = QString(),
                                const QString &tempDir = QString("json"));
+    static void recurseMessage(const gpb::Message &message,
+                               QJsonObject *object,
+                               QStringList *updatedFields,
+                               const QString &tempDir = QString("json"));
     static void updateValue(const gpb::Message &message,
                             QJsonValue *value,
                             const QString &field,
@@ -0,0 +1,441 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+#include "threadedzmqcontext.h"
+#include <QMetaMethod>
+
+using namespace nzmqt;
+
+ThreadedZMQFrame::ThreadedZMQFrame()
+{
+}
+
+ThreadedZMQFrame::ThreadedZMQFrame(ZMQMessage *message) :
+    m_message(message)
+{
+}
+
+const char *ThreadedZMQFrame::data() const
+{
+    return m_message.isNull() ? NULL : static_cast<const char*>(m_message->data());
+}
+
+int ThreadedZMQFrame::size() const
+{
+    return m_message.isNull() ? 0 : static_cast<int>(m_message->size());
+}
+
+/** Returns a deep copy of the payload */
+QByteArray ThreadedZMQFrame::toByteArray() const
+{
+    return QByteArray(data(), size());
+}
+
+ThreadedZMQSocket::ThreadedZMQSocket(ThreadedZMQContext *context, Type type) :
+    ZMQSocket(context, type),
+    m_threadedContext(context),
+    m_queueDepth(0)
+{
+    m_statistics.messagesReceived = 0;
+    m_statistics.bytesReceived = 0;
+    m_statistics.messagesSent = 0;
+    m_statistics.bytesSent = 0;
+    m_statistics.queueDepth = 0;
+}
+
+void ThreadedZMQSocket::connectTo(const QString &address)
+{
+    QMutexLocker locker(&m_mutex);
+    ZMQSocket::connectTo(address);
+}
+
+void ThreadedZMQSocket::setLinger(int msec)
+{
+    QMutexLocker locker(&m_mutex);
+    ZMQSocket::setLinger(msec);
+}
+
+void ThreadedZMQSocket::setIdentity(const QByteArray &name)
+{
+    QMutexLocker locker(&m_mutex);
+    ZMQSocket::setIdentity(name);
+}
+
+void ThreadedZMQSocket::subscribeTo(const char *filter)
+{
+    subscribeTo(QByteArray(filter));
+}
+
+void ThreadedZMQSocket::subscribeTo(const QString &filter)
+{
+    subscribeTo(filter.toLocal8Bit());
+}
+
+void ThreadedZMQSocket::subscribeTo(const QByteArray &filter)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        ZMQSocket::subscribeTo(filter);
+    }
+    checkEvents();
+}
+
+void ThreadedZMQSocket::unsubscribeFrom(const char *filter)
+{
+    unsubscribeFrom(QByteArray(filter));
+}
+
+void ThreadedZMQSocket::unsubscribeFrom(const QString &filter)
+{
+    unsubscribeFrom(filter.toLocal8Bit());
+}
+
+void ThreadedZMQSocket::unsubscribeFrom(const QByteArray &filter)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        ZMQSocket::unsubscribeFrom(filter);
+    }
+    checkEvents();
+}
+
+bool ThreadedZMQSocket::sendMessage(const QByteArray &bytes)
+{
+    bool result;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        result = ZMQSocket::sendMessage(bytes);
+        if (result)
+        {
+            m_statistics.messagesSent++;
+            m_statistics.bytesSent += bytes.size();
+        }
+    }
+    checkEvents();
+
+    return result;
+}
+
+bool ThreadedZMQSocket::sendMessage(const QList<QByteArray> &message)
+{
+    bool result;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        result = ZMQSocket::sendMessage(message);
+        if (result)
+        {
+            m_statistics.messagesSent++;
+            for (int i = 0; i < message.size(); ++i) {
+                m_statistics.bytesSent += message.at(i).size();
+            }
+        }
+    }
+    checkEvents();
+
+    return result;
+}
+
+/** Receives all pending messages, called from the I/O thread */
+void ThreadedZMQSocket::receiveAvailable()
+{
+    QList<ThreadedZMQFrameList> messages;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        while (events() & EVT_POLLIN)
+        {
+            ThreadedZMQFrameList message;
+            do {
+                ZMQMessage *part = new ZMQMessage();
+                if (!receiveMessage(part))
+                {
+                    delete part;
+                    break;
+                }
+                m_statistics.bytesReceived += part->size();
+                message.append(ThreadedZMQFrame(part));
+            } while (hasMoreMessageParts());
+
+            if (message.isEmpty()) {
+                break;
+            }
+
+            m_statistics.messagesReceived++;
+            messages.append(message);
+        }
+    }
+
+    // decoders get the messages directly, without the owner thread
+    bool decoded = isSignalConnected(QMetaMethod::fromSignal(&ThreadedZMQSocket::framesAvailable));
+    bool delivered = !decoded
+            || isSignalConnected(QMetaMethod::fromSignal(&ThreadedZMQSocket::framesReceived))
+            || isSignalConnected(QMetaMethod::fromSignal(&ZMQSocket::messageReceived));
+
+    for (int i = 0; i < messages.size(); ++i)
+    {
+        if (decoded) {
+            emit framesAvailable(messages.at(i));
+        }
+
+        // the socket lives in the owner thread, the delivery is queued
+        if (delivered)
+        {
+            m_queueDepth.ref();
+            QMetaObject::invokeMethod(this, "deliverMessage", Qt::QueuedConnection,
+                                      Q_ARG(ThreadedZMQFrameList, messages.at(i)));
+        }
+    }
+}
+
+void ThreadedZMQSocket::deliverMessage(const ThreadedZMQFrameList &message)
+{
+    m_queueDepth.deref();
+    emit framesReceived(message);
+
+    if (receivers(SIGNAL(messageReceived(QList<QByteArray>))) > 0)    // copying interface
+    {
+        QList<QByteArray> parts;
+        for (int i = 0; i < message.size(); ++i) {
+            parts.append(message.at(i).toByteArray());
+        }
+        emit messageReceived(parts);
+    }
+}
+
+/** Serialises a protobuf message directly into the buffer of a 0MQ message */
+bool ThreadedZMQSocket::sendMessage(const google::protobuf::MessageLite &message)
+{
+    int size = message.ByteSize();
+    ZMQMessage frame(size);
+    bool result;
+
+    message.SerializeWithCachedSizesToArray(static_cast<google::protobuf::uint8*>(frame.data()));
+
+    {
+        QMutexLocker locker(&m_mutex);
+        result = ZMQSocket::sendMessage(frame);
+        if (result)
+        {
+            m_statistics.messagesSent++;
+            m_statistics.bytesSent += size;
+        }
+    }
+    checkEvents();
+
+    return result;
+}
+
+ThreadedZMQSocketStatistics ThreadedZMQSocket::statistics() const
+{
+    QMutexLocker locker(&m_mutex);
+    ThreadedZMQSocketStatistics statistics = m_statistics;
+    statistics.queueDepth = m_queueDepth.load();
+    return statistics;
+}
+
+/** Any operation on a 0MQ socket may consume the edge of the ZMQ_FD
+ *  notification, so the I/O thread has to look at the events again.
+ **/
+void ThreadedZMQSocket::checkEvents()
+{
+    if (m_threadedContext != NULL)
+    {
+        m_threadedContext->wakeReceiver(this);
+    }
+}
+
+ThreadedZMQReceiver::ThreadedZMQReceiver(QObject *parent) :
+    QObject(parent),
+    m_enabled(true)
+{
+}
+
+void ThreadedZMQReceiver::addSocket(ThreadedZMQSocket *socket)
+{
+    int fd;
+
+    {
+        QMutexLocker locker(&socket->m_mutex);
+        fd = socket->fileDescriptor();
+    }
+
+    QSocketNotifier *notifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+    notifier->setEnabled(m_enabled);
+    connect(notifier, SIGNAL(activated(int)),
+            this, SLOT(readActivity(int)));
+
+    m_sockets.insert(fd, socket);
+    m_notifiers.insert(socket, notifier);
+
+    checkSocket(socket);
+}
+
+void ThreadedZMQReceiver::removeSocket(ThreadedZMQSocket *socket)
+{
+    QSocketNotifier *notifier = m_notifiers.take(socket);
+
+    if (notifier != NULL)
+    {
+        m_sockets.remove(notifier->socket());
+        notifier->setEnabled(false);
+        delete notifier;
+    }
+}
+
+void ThreadedZMQReceiver::checkSocket(ThreadedZMQSocket *socket)
+{
+    QSocketNotifier *notifier = m_notifiers.value(socket, NULL);
+
+    if (notifier != NULL)
+    {
+        readActivity(notifier->socket());
+    }
+}
+
+void ThreadedZMQReceiver::setEnabled(bool enabled)
+{
+    m_enabled = enabled;
+
+    foreach (QSocketNotifier *notifier, m_notifiers)
+    {
+        notifier->setEnabled(enabled);
+    }
+
+    if (enabled)
+    {
+        foreach (ThreadedZMQSocket *socket, m_sockets)
+        {
+            checkSocket(socket);
+        }
+    }
+}
+
+void ThreadedZMQReceiver::readActivity(int fd)
+{
+    ThreadedZMQSocket *socket = m_sockets.value(fd, NULL);
+
+    if ((socket == NULL) || !m_enabled)
+    {
+        return;
+    }
+
+    QSocketNotifier *notifier = m_notifiers.value(socket);
+    notifier->setEnabled(false);
+
+    try {
+        socket->receiveAvailable();
+    }
+    catch (const zmq::error_t &e) {
+        emit socket->receiveError(e.num(), QString(e.what()));
+    }
+
+    notifier->setEnabled(true);
+}
+
+ThreadedZMQContext::ThreadedZMQContext(QObject *parent, int ioThreads) :
+    ZMQContext(parent, ioThreads),
+    m_receiver(new ThreadedZMQReceiver()),
+    m_stopped(true)
+{
+    qRegisterMetaType<ThreadedZMQSocket*>();
+    qRegisterMetaType<ThreadedZMQFrameList>("ThreadedZMQFrameList");
+
+    m_receiver->setEnabled(false);
+    m_receiver->moveToThread(&m_thread);
+    connect(&m_thread, SIGNAL(finished()),
+            m_receiver, SLOT(deleteLater()));
+
+    m_thread.start();
+}
+
+ThreadedZMQContext::~ThreadedZMQContext()
+{
+    // close the sockets while the receiver can still release them
+    Sockets sockets = registeredSockets();
+    foreach (ZMQSocket *socket, sockets)
+    {
+        socket->close();
+    }
+
+    m_thread.quit();
+    m_thread.wait();
+}
+
+ThreadedZMQSocket *ThreadedZMQContext::createSocket(ZMQSocket::Type type, QObject *parent)
+{
+    return static_cast<ThreadedZMQSocket*>(ZMQContext::createSocket(type, parent));
+}
+
+void ThreadedZMQContext::start()
+{
+    m_stopped = false;
+    QMetaObject::invokeMethod(m_receiver, "setEnabled", Qt::QueuedConnection,
+                              Q_ARG(bool, true));
+}
+
+void ThreadedZMQContext::stop()
+{
+    m_stopped = true;
+    QMetaObject::invokeMethod(m_receiver, "setEnabled", Qt::QueuedConnection,
+                              Q_ARG(bool, false));
+}
+
+bool ThreadedZMQContext::isStopped() const
+{
+    return m_stopped;
+}
+
+ZMQSocket *ThreadedZMQContext::createSocketInternal(ZMQSocket::Type type)
+{
+    return new ThreadedZMQSocket(this, type);
+}
+
+void ThreadedZMQContext::registerSocket(ZMQSocket *socket)
+{
+    ZMQContext::registerSocket(socket);
+    QMetaObject::invokeMethod(m_receiver, "addSocket", Qt::QueuedConnection,
+                              Q_ARG(ThreadedZMQSocket*, static_cast<ThreadedZMQSocket*>(socket)));
+}
+
+void ThreadedZMQContext::unregisterSocket(ZMQSocket *socket)
+{
+    ThreadedZMQSocket *threadedSocket = static_cast<ThreadedZMQSocket*>(socket);
+
+    threadedSocket->m_threadedContext = NULL;
+
+    // the I/O thread must not touch the socket once it is closed
+    if (m_thread.isRunning())
+    {
+        QMetaObject::invokeMethod(m_receiver, "removeSocket", Qt::BlockingQueuedConnection,
+                                  Q_ARG(ThreadedZMQSocket*, threadedSocket));
+    }
+
+    ZMQContext::unregisterSocket(socket);
+}
+
+void ThreadedZMQContext::wakeReceiver(ThreadedZMQSocket *socket)
+{
+    QMetaObject::invokeMethod(m_receiver, "checkSocket", Qt::QueuedConnection,
+                              Q_ARG(ThreadedZMQSocket*, socket));
+}
@@ -0,0 +1,180 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+#ifndef THREADEDZMQCONTEXT_H
+#define THREADEDZMQCONTEXT_H
+
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QHash>
+#include <QSocketNotifier>
+#include <QSharedPointer>
+#include <nzmqt/nzmqt.hpp>
+#include <google/protobuf/message_lite.h>
+
+class ThreadedZMQContext;
+class ThreadedZMQReceiver;
+
+/** A received message part. The payload stays in the 0MQ message
+ *  it was received into, copies of a frame share this message.
+ **/
+class ThreadedZMQFrame
+{
+public:
+    ThreadedZMQFrame();
+    explicit ThreadedZMQFrame(nzmqt::ZMQMessage *message);    // takes ownership
+
+    const char *data() const;
+    int size() const;
+    QByteArray toByteArray() const;
+
+private:
+    QSharedPointer<nzmqt::ZMQMessage> m_message;
+};
+
+typedef QList<ThreadedZMQFrame> ThreadedZMQFrameList;
+
+/** Counters of a socket for diagnostics */
+struct ThreadedZMQSocketStatistics {
+    quint64 messagesReceived;
+    quint64 bytesReceived;
+    quint64 messagesSent;
+    quint64 bytesSent;
+    int queueDepth;     // received messages not yet delivered to the owner
+};
+
+/** A socket of a ThreadedZMQContext.
+ *  Messages are received in the I/O thread of the context and
+ *  messageReceived is delivered to the owner through a queued signal.
+ *  The socket operations below may be used from the owner thread,
+ *  they are serialised with the receiving I/O thread.
+ **/
+class ThreadedZMQSocket : public nzmqt::ZMQSocket
+{
+    Q_OBJECT
+
+    friend class ThreadedZMQContext;
+    friend class ThreadedZMQReceiver;
+
+public:
+    void connectTo(const QString &address);
+    void setLinger(int msec);
+    void setIdentity(const QByteArray &name);
+    void subscribeTo(const char *filter);
+    void subscribeTo(const QString &filter);
+    void subscribeTo(const QByteArray &filter);
+    void unsubscribeFrom(const char *filter);
+    void unsubscribeFrom(const QString &filter);
+    void unsubscribeFrom(const QByteArray &filter);
+
+    bool sendMessage(const google::protobuf::MessageLite &message);
+
+    ThreadedZMQSocketStatistics statistics() const;
+
+public slots:
+    bool sendMessage(const QByteArray &bytes);
+    bool sendMessage(const QList<QByteArray> &message);
+
+protected:
+    ThreadedZMQSocket(ThreadedZMQContext *context, Type type);
+
+private:
+    ThreadedZMQContext *m_threadedContext;
+    mutable QMutex m_mutex;
+    ThreadedZMQSocketStatistics m_statistics;
+    QAtomicInt m_queueDepth;
+
+    void receiveAvailable();
+    void checkEvents();
+
+private slots:
+    void deliverMessage(const ThreadedZMQFrameList &message);
+
+signals:
+    void framesReceived(const ThreadedZMQFrameList &message);
+    void framesAvailable(const ThreadedZMQFrameList &message);     // emitted in the I/O thread
+    void receiveError(int errorNum, const QString &errorMsg);
+};
+
+/** Receives the messages of all sockets of a context in the I/O thread.
+ *  The sockets are watched with socket notifiers on their ZMQ_FD,
+ *  so the thread sleeps until the network delivers something.
+ **/
+class ThreadedZMQReceiver : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ThreadedZMQReceiver(QObject *parent = 0);
+
+public slots:
+    void addSocket(ThreadedZMQSocket *socket);
+    void removeSocket(ThreadedZMQSocket *socket);
+    void checkSocket(ThreadedZMQSocket *socket);
+    void setEnabled(bool enabled);
+
+private:
+    QHash<int, ThreadedZMQSocket*> m_sockets;
+    QHash<ThreadedZMQSocket*, QSocketNotifier*> m_notifiers;
+    bool m_enabled;
+
+private slots:
+    void readActivity(int fd);
+};
+
+/** A ZeroMQ context that receives on a dedicated I/O thread instead of
+ *  polling the sockets with a timer in the GUI thread.
+ **/
+class ThreadedZMQContext : public nzmqt::ZMQContext
+{
+    Q_OBJECT
+
+public:
+    ThreadedZMQContext(QObject *parent = 0, int ioThreads = NZMQT_DEFAULT_IOTHREADS);
+    ~ThreadedZMQContext();
+
+    ThreadedZMQSocket *createSocket(nzmqt::ZMQSocket::Type type, QObject *parent = 0);
+
+    void start();
+    void stop();
+    bool isStopped() const;
+
+protected:
+    nzmqt::ZMQSocket *createSocketInternal(nzmqt::ZMQSocket::Type type);
+    void registerSocket(nzmqt::ZMQSocket *socket);
+    void unregisterSocket(nzmqt::ZMQSocket *socket);
+
+private:
+    QThread m_thread;
+    ThreadedZMQReceiver *m_receiver;
+    bool m_stopped;
+
+    void wakeReceiver(ThreadedZMQSocket *socket);
+
+    friend class ThreadedZMQSocket;
+};
+
+Q_DECLARE_METATYPE(ThreadedZMQSocket*)
+Q_DECLARE_METATYPE(ThreadedZMQFrameList)
+
+#endif // THREADEDZMQCONTEXT_H
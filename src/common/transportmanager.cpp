@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+#include "transportmanager.h"
+#include <QCoreApplication>
+#include <QVariantMap>
+
+static const char *instanceProperty = "_machinekitTransportManager";
+static const char *ioThreadsVariable = "MACHINEKIT_ZMQ_IO_THREADS";
+
+TransportManager::TransportManager(int ioThreads, QObject *parent) :
+    QObject(parent),
+    m_ioThreadCount(ioThreads),
+    m_context(new ThreadedZMQContext(this, ioThreads))
+{
+    qRegisterMetaType<ContainerPointer>("ContainerPointer");
+
+    m_context->start();
+    m_decoderThread.start();
+}
+
+TransportManager::~TransportManager()
+{
+    m_decoderThread.quit();
+    m_decoderThread.wait();
+}
+
+/** Returns the transport manager of the process.
+ *  The instance is anchored at the application object to be shared
+ *  between the plugins linking the common library. Where the library is
+ *  linked statically every plugin has its own copy of this class, the
+ *  anchored object is only used if it is an instance of this copy,
+ *  otherwise the plugin falls back to a manager of its own.
+ *  The number of 0MQ I/O threads can be set with MACHINEKIT_ZMQ_IO_THREADS.
+ **/
+TransportManager *TransportManager::instance()
+{
+    static TransportManager *privateManager = NULL;
+    QCoreApplication *application = QCoreApplication::instance();
+    QObject *object = application->property(instanceProperty).value<QObject*>();
+    TransportManager *manager = qobject_cast<TransportManager*>(object);
+
+    if (manager != NULL)
+    {
+        return manager;
+    }
+
+    if (privateManager == NULL)
+    {
+        int ioThreads = qMax(qgetenv(ioThreadsVariable).toInt(), 1);
+        privateManager = new TransportManager(ioThreads, application);
+        if (object == NULL)
+        {
+            application->setProperty(instanceProperty, QVariant::fromValue<QObject*>(privateManager));
+        }
+    }
+
+    return privateManager;
+}
+
+int TransportManager::ioThreadCount() const
+{
+    return m_ioThreadCount;
+}
+
+/** Creates a socket in the shared context and registers it under name */
+ThreadedZMQSocket *TransportManager::createSocket(nzmqt::ZMQSocket::Type type, const QString &name, QObject *parent)
+{
+    ThreadedZMQSocket *socket = m_context->createSocket(type, parent);
+
+    socket->setObjectName(name);
+    m_sockets.append(socket);
+    connect(socket, SIGNAL(destroyed(QObject*)),
+            this, SLOT(socketDestroyed(QObject*)));
+
+    return socket;
+}
+
+/** Returns the counters of all registered sockets as a list of maps */
+QVariantList TransportManager::socketStatistics() const
+{
+    QVariantList list;
+
+    foreach (ThreadedZMQSocket *socket, m_sockets)
+    {
+        ThreadedZMQSocketStatistics statistics = socket->statistics();
+        QVariantMap map;
+        map.insert("name", socket->objectName());
+        map.insert("messagesReceived", statistics.messagesReceived);
+        map.insert("bytesReceived", statistics.bytesReceived);
+        map.insert("messagesSent", statistics.messagesSent);
+        map.insert("bytesSent", statistics.bytesSent);
+        map.insert("queueDepth", statistics.queueDepth);
+        list.append(map);
+    }
+
+    return list;
+}
+
+/** Moves the decoder to the decoder thread and lets it parse the messages
+ *  of socket. The messages are passed from the I/O thread directly to
+ *  the decoder without going through the thread of the socket owner.
+ *  The decoder is deleted together with the socket.
+ **/
+void TransportManager::attachDecoder(ThreadedZMQSocket *socket, MessageDecoder *decoder)
+{
+    decoder->moveToThread(&m_decoderThread);
+    connect(socket, SIGNAL(framesAvailable(ThreadedZMQFrameList)),
+            decoder, SLOT(decode(ThreadedZMQFrameList)));
+    connect(socket, SIGNAL(destroyed()),
+            decoder, SLOT(deleteLater()));
+}
+
+void TransportManager::socketDestroyed(QObject *object)
+{
+    m_sockets.removeAll(static_cast<ThreadedZMQSocket*>(object));
+}
@@ -0,0 +1,64 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+#ifndef TRANSPORTMANAGER_H
+#define TRANSPORTMANAGER_H
+
+#include <QObject>
+#include <QVariantList>
+#include <QThread>
+#include "threadedzmqcontext.h"
+#include "messagedecoder.h"
+
+/** Owns the one 0MQ context shared by all services of the process.
+ *  Services create their sockets here, the sockets are kept in a
+ *  registry under a descriptive name for diagnostics.
+ **/
+class TransportManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    static TransportManager *instance();
+
+    int ioThreadCount() const;
+
+    ThreadedZMQSocket *createSocket(nzmqt::ZMQSocket::Type type, const QString &name, QObject *parent = 0);
+
+    Q_INVOKABLE QVariantList socketStatistics() const;
+
+    void attachDecoder(ThreadedZMQSocket *socket, MessageDecoder *decoder);
+
+private:
+    explicit TransportManager(int ioThreads, QObject *parent = 0);
+    ~TransportManager();
+
+    int m_ioThreadCount;
+    ThreadedZMQContext *m_context;
+    QThread m_decoderThread;
+    QList<ThreadedZMQSocket*> m_sockets;
+
+private slots:
+    void socketDestroyed(QObject *object);
+};
+
+#endif // TRANSPORTMANAGER_H
@@ -20,6 +20,7 @@
 **
 ****************************************************************************/
 import QtQuick 2.0
+import Machinekit.Controls 1.0
 
 /*!
     \qmltype LogChart
@@ -64,7 +65,32 @@ ValueChart {
 
         The default value is \c{10}.
     */
-    property alias sampleInterval: sampleTimer.interval
+    property alias sampleInterval: valueModel.sampleInterval
+
+    /*! \qmlproperty enumeration samplingMode
+
+        This property holds how the value is sampled while \l autoSampling is enabled.
+        See \l{ValueModel::samplingMode}{ValueModel.samplingMode} for the possible values.
+
+        The default value is \c{ValueModel.TimerSampling}.
+    */
+    property int samplingMode: ValueModel.TimerSampling
+
+    /*! \qmlproperty QtObject sampleSource
+
+        This property holds the object that is sampled.
+
+        The default value is the chart itself, sampling \l value.
+    */
+    property alias sampleSource: valueModel.source
+
+    /*! \qmlproperty string sampleProperty
+
+        This property holds the name of the property of \l sampleSource that is sampled.
+
+        The default value is \c{"value"}.
+    */
+    property alias sampleProperty: valueModel.sourceProperty
 
     /*! \qmlproperty int updateInterval
 
@@ -88,7 +114,7 @@ ValueChart {
 
         The default value is \c{true}.
     */
-    property alias autoSampling: sampleTimer.running
+    property bool autoSampling: true
 
     /*! This property holds the value that should be sampled.
     */
@@ -116,17 +142,9 @@ ValueChart {
 
     valueModel: ValueModel {
         id: valueModel
-    }
-
-    Timer {
-        id: sampleTimer
-
-        interval: 10
-        running: chart.enabled
-        repeat: true
-        onTriggered: {
-            valueModel.addData(value)
-        }
+        source: chart
+        sourceProperty: "value"
+        samplingMode: (chart.autoSampling && chart.enabled) ? chart.samplingMode : ValueModel.ManualSampling
     }
 
     Timer {
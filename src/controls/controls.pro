@@ -8,10 +8,14 @@ include(../plugin.pri)
 SOURCES +=
 
 HEADERS += \
-    plugin.h
+    plugin.h \
+    qvaluemodel.h \
+    qvaluechartitem.h
 
 SOURCES += \
-    plugin.cpp
+    plugin.cpp \
+    qvaluemodel.cpp \
+    qvaluechartitem.cpp
 
 RESOURCES += \
     controls.qrc
@@ -30,7 +34,6 @@ QML_FILES = \
     TooltipArea.qml \
     TouchButton.qml \
     ValueChart.qml \
-    ValueModel.qml \
     VirtualJoystick.qml
 
 include(Private/private.pri)
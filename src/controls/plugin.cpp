@@ -21,6 +21,8 @@
 ****************************************************************************/
 #include "plugin.h"
 #include "pluginprivate.h"
+#include "qvaluemodel.h"
+#include "qvaluechartitem.h"
 
 static void initResources()
 {
@@ -46,7 +48,6 @@ static const struct {
     { "TouchButton", 1, 0 },
     { "VirtualJoystick", 1, 0 },
     { "ValueChart", 1, 0 },
-    { "ValueModel", 1, 0 },
     { "LogChart", 1, 0 }
 };
 
@@ -60,6 +61,9 @@ void MachinekitControlsPlugin::registerTypes(const char *uri)
     for (int i = 0; i < int(sizeof(qmldir)/sizeof(qmldir[0])); i++) {
         qmlRegisterType(QUrl(filesLocation + "/" + qmldir[i].type + ".qml"), uri, qmldir[i].major, qmldir[i].minor, qmldir[i].type);
         }
+
+    qmlRegisterType<QValueModel>(uri, 1, 0, "ValueModel");
+    qmlRegisterType<QValueChartItem>(uri, 1, 0, "ValueChartItem");
 }
 
 void MachinekitControlsPlugin::initializeEngine(QQmlEngine *engine, const char *uri)
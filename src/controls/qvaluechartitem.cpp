@@ -0,0 +1,722 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#include "qvaluechartitem.h"
+#include <QSGSimpleRectNode>
+#include <QSGGeometryNode>
+#include <QSGTransformNode>
+#include <QSGFlatColorMaterial>
+#include <QSGVertexColorMaterial>
+#include <QLineF>
+#include <qmath.h>
+
+static const qint64 maximumColumnOffset = 1 << 20;  // keeps the vertex coordinates exact in float
+static const int signalSlotVertices = 8;            // four lines per column
+static const int changeSlotVertices = 6;            // two triangles per column
+static const float unusedSlotX = -(float)maximumColumnOffset;  // far left of any chart
+
+/*!
+    \qmltype ValueChartItem
+    \instantiates QValueChartItem
+    \inqmlmodule Machinekit.Controls
+    \brief Draws the values of a value model with the scene graph.
+    \ingroup machinekitcontrols
+
+    This item draws the background, grid, change graph, target line and
+    signal of a \l ValueChart. The values between \l startTimestamp and
+    \l endTimestamp are reduced to the lowest and highest value of each
+    pixel column, only samples appended to the model since the last
+    update are processed.
+
+    \sa ValueChart, ValueModel
+*/
+
+QValueChartItem::QValueChartItem(QQuickItem *parent) :
+    QQuickItem(parent),
+    m_valueModel(NULL),
+    m_startTimestamp(0.0),
+    m_endTimestamp(0.0),
+    m_minimumValue(0.0),
+    m_maximumValue(300.0),
+    m_xGrid(10000.0),
+    m_yGrid(20.0),
+    m_backgroundColor(Qt::black),
+    m_gridColor(QColor("#222222")),
+    m_signalColor(Qt::red),
+    m_hLineColor(QColor("#666666")),
+    m_positiveChangeColor(Qt::green),
+    m_negativeChangeColor(Qt::red),
+    m_signalLineWidth(2),
+    m_gridLineWidth(1),
+    m_changeGraphScale(10.0),
+    m_changeGraphEnabled(true),
+    m_columnWidth(0.0),
+    m_baseColumn(0),
+    m_coveredFrom(0.0),
+    m_nextSequence(0),
+    m_columnsDirty(true),
+    m_droppedColumns(0),
+    m_writtenColumns(0),
+    m_slotOffset(0),
+    m_slotCapacity(0),
+    m_slotsDirty(true),
+    m_changeDirty(true),
+    m_gridDirty(true),
+    m_targetDirty(true),
+    m_gridTimeSpan(0.0)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void QValueChartItem::setValueModel(QObject *arg)
+{
+    QValueModel *model = qobject_cast<QValueModel*>(arg);
+
+    if (m_valueModel != model) {
+        if (!m_valueModel.isNull())
+        {
+            disconnect(m_valueModel, 0, this, 0);
+        }
+
+        m_valueModel = model;
+
+        if (!m_valueModel.isNull())
+        {
+            connect(m_valueModel, SIGNAL(modelReset()),
+                    this, SLOT(invalidateColumns()));
+            connect(m_valueModel, SIGNAL(targetValueChanged(double)),
+                    this, SLOT(invalidateTarget()));
+        }
+
+        m_targetDirty = true;
+        invalidateColumns();
+        emit valueModelChanged(model);
+    }
+}
+
+void QValueChartItem::setStartTimestamp(double arg)
+{
+    if (m_startTimestamp != arg) {
+        m_startTimestamp = arg;
+        update();
+        emit startTimestampChanged(arg);
+    }
+}
+
+void QValueChartItem::setEndTimestamp(double arg)
+{
+    if (m_endTimestamp != arg) {
+        m_endTimestamp = arg;
+        update();
+        emit endTimestampChanged(arg);
+    }
+}
+
+void QValueChartItem::setMinimumValue(double arg)
+{
+    if (m_minimumValue != arg) {
+        m_minimumValue = arg;
+        m_gridDirty = true;
+        m_targetDirty = true;
+        m_changeDirty = true;
+        update();
+        emit minimumValueChanged(arg);
+    }
+}
+
+void QValueChartItem::setMaximumValue(double arg)
+{
+    if (m_maximumValue != arg) {
+        m_maximumValue = arg;
+        m_gridDirty = true;
+        m_targetDirty = true;
+        m_changeDirty = true;
+        update();
+        emit maximumValueChanged(arg);
+    }
+}
+
+void QValueChartItem::setXGrid(double arg)
+{
+    if (m_xGrid != arg) {
+        m_xGrid = arg;
+        m_gridDirty = true;
+        update();
+        emit xGridChanged(arg);
+    }
+}
+
+void QValueChartItem::setYGrid(double arg)
+{
+    if (m_yGrid != arg) {
+        m_yGrid = arg;
+        m_gridDirty = true;
+        update();
+        emit yGridChanged(arg);
+    }
+}
+
+void QValueChartItem::setBackgroundColor(const QColor &arg)
+{
+    if (m_backgroundColor != arg) {
+        m_backgroundColor = arg;
+        update();
+        emit backgroundColorChanged(arg);
+    }
+}
+
+void QValueChartItem::setGridColor(const QColor &arg)
+{
+    if (m_gridColor != arg) {
+        m_gridColor = arg;
+        update();
+        emit gridColorChanged(arg);
+    }
+}
+
+void QValueChartItem::setSignalColor(const QColor &arg)
+{
+    if (m_signalColor != arg) {
+        m_signalColor = arg;
+        update();
+        emit signalColorChanged(arg);
+    }
+}
+
+void QValueChartItem::setHLineColor(const QColor &arg)
+{
+    if (m_hLineColor != arg) {
+        m_hLineColor = arg;
+        update();
+        emit hLineColorChanged(arg);
+    }
+}
+
+void QValueChartItem::setPositiveChangeColor(const QColor &arg)
+{
+    if (m_positiveChangeColor != arg) {
+        m_positiveChangeColor = arg;
+        m_changeDirty = true;
+        update();
+        emit positiveChangeColorChanged(arg);
+    }
+}
+
+void QValueChartItem::setNegativeChangeColor(const QColor &arg)
+{
+    if (m_negativeChangeColor != arg) {
+        m_negativeChangeColor = arg;
+        m_changeDirty = true;
+        update();
+        emit negativeChangeColorChanged(arg);
+    }
+}
+
+void QValueChartItem::setSignalLineWidth(int arg)
+{
+    if (m_signalLineWidth != arg) {
+        m_signalLineWidth = arg;
+        m_targetDirty = true;
+        update();
+        emit signalLineWidthChanged(arg);
+    }
+}
+
+void QValueChartItem::setGridLineWidth(int arg)
+{
+    if (m_gridLineWidth != arg) {
+        m_gridLineWidth = arg;
+        m_gridDirty = true;
+        update();
+        emit gridLineWidthChanged(arg);
+    }
+}
+
+void QValueChartItem::setChangeGraphScale(double arg)
+{
+    if (m_changeGraphScale != arg) {
+        m_changeGraphScale = arg;
+        m_changeDirty = true;
+        update();
+        emit changeGraphScaleChanged(arg);
+    }
+}
+
+void QValueChartItem::setChangeGraphEnabled(bool arg)
+{
+    if (m_changeGraphEnabled != arg) {
+        m_changeGraphEnabled = arg;
+        m_changeDirty = true;
+        update();
+        emit changeGraphEnabledChanged(arg);
+    }
+}
+
+static QSGGeometryNode *createGeometryNode(const QSGGeometry::AttributeSet &attributes, GLenum drawingMode, QSGMaterial *material)
+{
+    QSGGeometryNode *node = new QSGGeometryNode();
+    QSGGeometry *geometry = new QSGGeometry(attributes, 0);
+
+    geometry->setDrawingMode(drawingMode);
+    node->setGeometry(geometry);
+    node->setFlag(QSGNode::OwnsGeometry);
+    node->setMaterial(material);
+    node->setFlag(QSGNode::OwnsMaterial);
+
+    return node;
+}
+
+static void setNodeColor(QSGNode *node, const QColor &color)
+{
+    QSGGeometryNode *geometryNode = static_cast<QSGGeometryNode*>(node);
+    QSGFlatColorMaterial *material = static_cast<QSGFlatColorMaterial*>(geometryNode->material());
+
+    if (material->color() != color)
+    {
+        material->setColor(color);
+        geometryNode->markDirty(QSGNode::DirtyMaterial);
+    }
+}
+
+/** The node tree is the background rectangle with the grid, the change
+ *  graph, the target line and the signal as children in painting order.
+ *  The change graph and the signal are placed in transform nodes mapping
+ *  column and value coordinates to the item.
+ **/
+QSGNode *QValueChartItem::updatePaintNode(QSGNode *oldNode, QQuickItem::UpdatePaintNodeData *updatePaintNodeData)
+{
+    Q_UNUSED(updatePaintNodeData)
+
+    QSGSimpleRectNode *root = static_cast<QSGSimpleRectNode*>(oldNode);
+    bool created = (root == NULL);
+
+    if (created)
+    {
+        root = new QSGSimpleRectNode();
+        root->appendChildNode(createGeometryNode(QSGGeometry::defaultAttributes_Point2D(),
+                                                 GL_LINES, new QSGFlatColorMaterial()));
+        QSGTransformNode *changeTransform = new QSGTransformNode();
+        changeTransform->appendChildNode(createGeometryNode(QSGGeometry::defaultAttributes_ColoredPoint2D(),
+                                                            GL_TRIANGLES, new QSGVertexColorMaterial()));
+        root->appendChildNode(changeTransform);
+        root->appendChildNode(createGeometryNode(QSGGeometry::defaultAttributes_Point2D(),
+                                                 GL_LINES, new QSGFlatColorMaterial()));
+        QSGTransformNode *signalTransform = new QSGTransformNode();
+        signalTransform->appendChildNode(createGeometryNode(QSGGeometry::defaultAttributes_Point2D(),
+                                                            GL_LINES, new QSGFlatColorMaterial()));
+        root->appendChildNode(signalTransform);
+    }
+
+    QSGGeometryNode *gridNode = static_cast<QSGGeometryNode*>(root->childAtIndex(0));
+    QSGTransformNode *changeTransform = static_cast<QSGTransformNode*>(root->childAtIndex(1));
+    QSGGeometryNode *changeNode = static_cast<QSGGeometryNode*>(changeTransform->firstChild());
+    QSGGeometryNode *targetNode = static_cast<QSGGeometryNode*>(root->childAtIndex(2));
+    QSGTransformNode *signalTransform = static_cast<QSGTransformNode*>(root->childAtIndex(3));
+    QSGGeometryNode *signalNode = static_cast<QSGGeometryNode*>(signalTransform->firstChild());
+
+    double timeSpan = m_endTimestamp - m_startTimestamp;
+
+    if (created)
+    {
+        m_gridDirty = true;
+        m_targetDirty = true;
+        m_slotsDirty = true;
+    }
+
+    root->setRect(boundingRect());
+    updateStyle(root);
+
+    if (m_gridDirty || (timeSpan != m_gridTimeSpan))
+    {
+        m_gridTimeSpan = timeSpan;
+        updateGridNode(gridNode);
+        m_gridDirty = false;
+    }
+    if (m_targetDirty)
+    {
+        updateTargetNode(targetNode);
+        m_targetDirty = false;
+    }
+
+    if (updateColumns() || m_slotsDirty || m_changeDirty)
+    {
+        updateColumnNodes(signalNode, changeNode);
+    }
+    if (signalNode->geometry()->lineWidth() != m_signalLineWidth)
+    {
+        signalNode->geometry()->setLineWidth(m_signalLineWidth);
+        signalNode->markDirty(QSGNode::DirtyGeometry);
+    }
+    updateTransform(changeTransform);
+    updateTransform(signalTransform);
+
+    return root;
+}
+
+void QValueChartItem::geometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChanged(newGeometry, oldGeometry);
+
+    if (newGeometry.size() != oldGeometry.size())
+    {
+        m_gridDirty = true;
+        m_targetDirty = true;
+        update();
+    }
+}
+
+void QValueChartItem::invalidateColumns()
+{
+    m_columnsDirty = true;
+    update();
+}
+
+void QValueChartItem::invalidateTarget()
+{
+    m_targetDirty = true;
+    update();
+}
+
+/** Folds the samples appended to the model since the last update into the
+ *  pixel columns and drops the columns that scrolled out of the chart.
+ *  The columns are rebuilt only if the time scale changed, the model was
+ *  reset or the chart was scrolled back to samples not yet covered.
+ *  Returns whether the columns have been changed.
+ **/
+bool QValueChartItem::updateColumns()
+{
+    double timeSpan = m_endTimestamp - m_startTimestamp;
+
+    if (m_valueModel.isNull() || (m_valueModel->count() == 0) || (width() < 1.0) || (timeSpan <= 0.0))
+    {
+        bool changed = !m_columns.isEmpty();
+        m_columns.clear();
+        m_columnsDirty = true;
+        m_slotsDirty |= changed;
+        return changed;
+    }
+
+    QValueModel *model = m_valueModel.data();
+    double columnWidth = timeSpan / qFloor(width());
+    qint64 startColumn = (qint64)qFloor(m_startTimestamp / columnWidth);
+    int index;
+
+    if ((columnWidth != m_columnWidth)
+        || ((m_startTimestamp < m_coveredFrom) && (model->timestampAt(0) < m_coveredFrom))
+        || ((startColumn - m_baseColumn) > maximumColumnOffset))
+    {
+        m_columnsDirty = true;
+    }
+
+    if (m_columnsDirty)
+    {
+        index = qMax(model->indexOf(m_startTimestamp), 0);
+        m_columns.clear();
+        m_columnWidth = columnWidth;
+        m_baseColumn = startColumn;
+        m_coveredFrom = model->timestampAt(index);
+        m_columnsDirty = false;
+        m_slotsDirty = true;
+    }
+    else
+    {
+        index = (int)qMax(m_nextSequence - model->firstSequence(), (qint64)0);
+    }
+
+    bool changed = (index < model->count());
+
+    for (; index < model->count(); ++index)
+    {
+        addSample(model->timestampAt(index), model->valueAt(index));
+    }
+    m_nextSequence = model->firstSequence() + model->count();
+
+    // keep the last column left of the chart to draw the line into the chart
+    int dropCount = 0;
+    while (((dropCount + 1) < m_columns.size()) && (m_columns.at(dropCount + 1).column < startColumn))
+    {
+        dropCount++;
+    }
+    if (dropCount > 0)
+    {
+        m_columns.remove(0, dropCount);
+        m_coveredFrom = m_columns.first().column * m_columnWidth;
+        m_droppedColumns += dropCount;
+        changed = true;
+    }
+
+    return changed;
+}
+
+void QValueChartItem::addSample(double timestamp, double value)
+{
+    qint64 column = (qint64)qFloor(timestamp / m_columnWidth);
+    float sampleValue = (float)value;
+
+    if (!m_columns.isEmpty() && (m_columns.last().column >= column))   // older samples are merged into the last column
+    {
+        Column &last = m_columns.last();
+        if (sampleValue < last.minimum)
+        {
+            last.minimum = sampleValue;
+            last.minimumFirst = false;
+        }
+        if (sampleValue > last.maximum)
+        {
+            last.maximum = sampleValue;
+            last.minimumFirst = true;
+        }
+        last.last = sampleValue;
+    }
+    else
+    {
+        Column newColumn;
+        newColumn.column = column;
+        newColumn.first = sampleValue;
+        newColumn.minimum = sampleValue;
+        newColumn.maximum = sampleValue;
+        newColumn.last = sampleValue;
+        newColumn.minimumFirst = true;
+        m_columns.append(newColumn);
+    }
+}
+
+void QValueChartItem::updateGridNode(QSGGeometryNode *node)
+{
+    QVector<QLineF> lines;
+    double valueRange = m_maximumValue - m_minimumValue;
+    double timeSpan = m_endTimestamp - m_startTimestamp;
+
+    if ((m_yGrid > 0.0) && (valueRange > 0.0))
+    {
+        for (double i = m_minimumValue / m_yGrid; i < (m_maximumValue / m_yGrid); i += 1.0)
+        {
+            double y = height() - (i * m_yGrid - m_minimumValue) / valueRange * height();
+            lines.append(QLineF(0.0, y, width(), y));
+        }
+    }
+
+    if ((m_xGrid > 0.0) && (timeSpan > 0.0))
+    {
+        for (double i = 0.0; i < (timeSpan / m_xGrid); i += 1.0)
+        {
+            double x = (i * m_xGrid) / timeSpan * width();
+            lines.append(QLineF(x, 0.0, x, height()));
+        }
+    }
+
+    QSGGeometry *geometry = node->geometry();
+    geometry->allocate(lines.size() * 2);
+    geometry->setLineWidth(m_gridLineWidth);
+    QSGGeometry::Point2D *vertices = geometry->vertexDataAsPoint2D();
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        vertices[i * 2].set(lines.at(i).x1(), lines.at(i).y1());
+        vertices[i * 2 + 1].set(lines.at(i).x2(), lines.at(i).y2());
+    }
+    node->markDirty(QSGNode::DirtyGeometry);
+}
+
+void QValueChartItem::updateTargetNode(QSGGeometryNode *node)
+{
+    QSGGeometry *geometry = node->geometry();
+    double valueRange = m_maximumValue - m_minimumValue;
+
+    if (m_valueModel.isNull() || (valueRange <= 0.0))
+    {
+        geometry->allocate(0);
+    }
+    else
+    {
+        double y = height() - (m_valueModel->targetValue() - m_minimumValue) / valueRange * height();
+        geometry->allocate(2);
+        geometry->vertexDataAsPoint2D()[0].set(0.0, y);
+        geometry->vertexDataAsPoint2D()[1].set(width(), y);
+    }
+    geometry->setLineWidth(m_signalLineWidth);
+    node->markDirty(QSGNode::DirtyGeometry);
+}
+
+/** The signal and the change graph keep one slot of vertices per column.
+ *  The slots are preallocated for twice the columns of the chart, new
+ *  columns are written behind the last one and the slots of scrolled out
+ *  columns are cleared, so an update only writes the changed columns.
+ *  All slots are written again when the columns reach the last slot,
+ *  the columns were rebuilt or the change graph settings changed.
+ **/
+void QValueChartItem::updateColumnNodes(QSGGeometryNode *signalNode, QSGGeometryNode *changeNode)
+{
+    int firstColumn = qMax(m_writtenColumns - m_droppedColumns - 1, 0);  // merged samples change the last column
+
+    if (m_slotsDirty || ((m_slotOffset + m_droppedColumns + m_columns.size()) > m_slotCapacity))
+    {
+        m_slotCapacity = qMax(2 * (qCeil(width()) + 2), m_columns.size());
+        m_slotOffset = 0;
+        signalNode->geometry()->allocate(m_slotCapacity * signalSlotVertices);
+        changeNode->geometry()->allocate(m_slotCapacity * changeSlotVertices);
+        clearSlots(signalNode, changeNode, m_columns.size(), m_slotCapacity - m_columns.size());
+        writeSignalSlots(signalNode, 0, m_columns.size());
+        writeChangeSlots(changeNode, 0, m_columns.size());
+    }
+    else
+    {
+        if (m_droppedColumns > 0)   // the new first column has no predecessor anymore
+        {
+            clearSlots(signalNode, changeNode, m_slotOffset, m_droppedColumns);
+            m_slotOffset += m_droppedColumns;
+            writeSignalSlots(signalNode, 0, qMin(1, m_columns.size()));
+            writeChangeSlots(changeNode, 0, qMin(1, m_columns.size()));
+        }
+        writeSignalSlots(signalNode, firstColumn, m_columns.size());
+        writeChangeSlots(changeNode, m_changeDirty ? 0 : firstColumn, m_columns.size());
+    }
+
+    m_writtenColumns = m_columns.size();
+    m_droppedColumns = 0;
+    m_slotsDirty = false;
+    m_changeDirty = false;
+    signalNode->markDirty(QSGNode::DirtyGeometry);
+    changeNode->markDirty(QSGNode::DirtyGeometry);
+}
+
+/** Every column is drawn as line from the last value of the previous
+ *  column to its first value and over the lowest and highest value,
+ *  in the order they were sampled, to its last value.
+ **/
+void QValueChartItem::writeSignalSlots(QSGGeometryNode *node, int firstColumn, int lastColumn)
+{
+    QSGGeometry::Point2D *vertices = node->geometry()->vertexDataAsPoint2D();
+
+    for (int i = firstColumn; i < lastColumn; ++i)
+    {
+        const Column &column = m_columns.at(i);
+        QSGGeometry::Point2D *slot = &vertices[(m_slotOffset + i) * signalSlotVertices];
+        float x = (float)(column.column - m_baseColumn) + 0.5f;
+        float a = column.minimumFirst ? column.minimum : column.maximum;
+        float b = column.minimumFirst ? column.maximum : column.minimum;
+
+        if (i > 0)
+        {
+            const Column &previous = m_columns.at(i - 1);
+            slot[0].set((float)(previous.column - m_baseColumn) + 0.5f, previous.last);
+            slot[1].set(x, column.first);
+        }
+        else
+        {
+            slot[0].set(unusedSlotX, 0.0f);
+            slot[1].set(unusedSlotX, 0.0f);
+        }
+        slot[2].set(x, column.first);
+        slot[3].set(x, a);
+        slot[4].set(x, a);
+        slot[5].set(x, b);
+        slot[6].set(x, b);
+        slot[7].set(x, column.last);
+    }
+}
+
+/** Draws a bar for the change of the last value of every column
+ *  to the previous column at the bottom of the chart.
+ **/
+void QValueChartItem::writeChangeSlots(QSGGeometryNode *node, int firstColumn, int lastColumn)
+{
+    QSGGeometry::ColoredPoint2D *vertices = node->geometry()->vertexDataAsColoredPoint2D();
+
+    for (int i = firstColumn; i < lastColumn; ++i)
+    {
+        QSGGeometry::ColoredPoint2D *bar = &vertices[(m_slotOffset + i) * changeSlotVertices];
+
+        if (!m_changeGraphEnabled || (i == 0))
+        {
+            for (int j = 0; j < changeSlotVertices; ++j) {
+                bar[j].set(unusedSlotX, 0.0f, 0, 0, 0, 0);
+            }
+            continue;
+        }
+
+        const Column &column = m_columns.at(i);
+        float change = column.last - m_columns.at(i - 1).last;
+        QColor color = (change >= 0.0f) ? m_positiveChangeColor : m_negativeChangeColor;
+        float alpha = 0.2f * color.alphaF();    // the material expects premultiplied colors
+        uchar r = (uchar)(color.redF() * alpha * 255.0f);
+        uchar g = (uchar)(color.greenF() * alpha * 255.0f);
+        uchar b = (uchar)(color.blueF() * alpha * 255.0f);
+        uchar a = (uchar)(alpha * 255.0f);
+        float left = (float)(column.column - m_baseColumn);
+        float right = left + 1.0f;
+        float bottom = (float)m_minimumValue;
+        float top = (float)qMin(m_minimumValue + qAbs(change) * m_changeGraphScale, m_maximumValue);
+
+        bar[0].set(left, bottom, r, g, b, a);
+        bar[1].set(right, bottom, r, g, b, a);
+        bar[2].set(left, top, r, g, b, a);
+        bar[3].set(left, top, r, g, b, a);
+        bar[4].set(right, bottom, r, g, b, a);
+        bar[5].set(right, top, r, g, b, a);
+    }
+}
+
+/** Collapses the vertices of unused slots far left of the chart */
+void QValueChartItem::clearSlots(QSGGeometryNode *signalNode, QSGGeometryNode *changeNode, int firstSlot, int count)
+{
+    QSGGeometry::Point2D *signalVertices = signalNode->geometry()->vertexDataAsPoint2D();
+    QSGGeometry::ColoredPoint2D *changeVertices = changeNode->geometry()->vertexDataAsColoredPoint2D();
+
+    for (int i = firstSlot * signalSlotVertices; i < ((firstSlot + count) * signalSlotVertices); ++i)
+    {
+        signalVertices[i].set(unusedSlotX, 0.0f);
+    }
+    for (int i = firstSlot * changeSlotVertices; i < ((firstSlot + count) * changeSlotVertices); ++i)
+    {
+        changeVertices[i].set(unusedSlotX, 0.0f, 0, 0, 0, 0);
+    }
+}
+
+/** Maps column and value coordinates to item coordinates */
+void QValueChartItem::updateTransform(QSGTransformNode *node)
+{
+    QMatrix4x4 matrix;
+    double valueRange = m_maximumValue - m_minimumValue;
+
+    if ((m_columnWidth > 0.0) && (valueRange > 0.0))
+    {
+        double scaleY = height() / valueRange;
+        matrix.translate((float)((double)m_baseColumn - m_startTimestamp / m_columnWidth),
+                         (float)(height() + m_minimumValue * scaleY));
+        matrix.scale(1.0f, (float)-scaleY);
+    }
+
+    node->setMatrix(matrix);
+    node->markDirty(QSGNode::DirtyMatrix);
+}
+
+void QValueChartItem::updateStyle(QSGNode *root)
+{
+    QSGSimpleRectNode *background = static_cast<QSGSimpleRectNode*>(root);
+
+    if (background->color() != m_backgroundColor)
+    {
+        background->setColor(m_backgroundColor);
+    }
+    setNodeColor(root->childAtIndex(0), m_gridColor);
+    setNodeColor(root->childAtIndex(2), m_hLineColor);
+    setNodeColor(root->childAtIndex(3)->firstChild(), m_signalColor);
+}
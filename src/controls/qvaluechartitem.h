@@ -0,0 +1,256 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#ifndef QVALUECHARTITEM_H
+#define QVALUECHARTITEM_H
+
+#include <QQuickItem>
+#include <QPointer>
+#include <QColor>
+#include <QVector>
+#include "qvaluemodel.h"
+
+class QSGNode;
+class QSGGeometryNode;
+class QSGTransformNode;
+
+/** Draws the values of a QValueModel with the scene graph.
+ *  The samples are reduced to the first, lowest, highest and last value
+ *  of every pixel column. The columns are keyed by their absolute time,
+ *  so they stay valid while the chart scrolls and only newly appended
+ *  samples have to be folded in on an update. Scrolling and scaling
+ *  the value range only changes the transformation of the signal nodes.
+ *  The vertices of the signal and the change graph are kept in slots per
+ *  column, an update only writes the slots of changed columns. The grid
+ *  and the target line are only rebuilt when their inputs change.
+ **/
+class QValueChartItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QObject *valueModel READ valueModel WRITE setValueModel NOTIFY valueModelChanged)
+    Q_PROPERTY(double startTimestamp READ startTimestamp WRITE setStartTimestamp NOTIFY startTimestampChanged)
+    Q_PROPERTY(double endTimestamp READ endTimestamp WRITE setEndTimestamp NOTIFY endTimestampChanged)
+    Q_PROPERTY(double minimumValue READ minimumValue WRITE setMinimumValue NOTIFY minimumValueChanged)
+    Q_PROPERTY(double maximumValue READ maximumValue WRITE setMaximumValue NOTIFY maximumValueChanged)
+    Q_PROPERTY(double xGrid READ xGrid WRITE setXGrid NOTIFY xGridChanged)
+    Q_PROPERTY(double yGrid READ yGrid WRITE setYGrid NOTIFY yGridChanged)
+    Q_PROPERTY(QColor backgroundColor READ backgroundColor WRITE setBackgroundColor NOTIFY backgroundColorChanged)
+    Q_PROPERTY(QColor gridColor READ gridColor WRITE setGridColor NOTIFY gridColorChanged)
+    Q_PROPERTY(QColor signalColor READ signalColor WRITE setSignalColor NOTIFY signalColorChanged)
+    Q_PROPERTY(QColor hLineColor READ hLineColor WRITE setHLineColor NOTIFY hLineColorChanged)
+    Q_PROPERTY(QColor positiveChangeColor READ positiveChangeColor WRITE setPositiveChangeColor NOTIFY positiveChangeColorChanged)
+    Q_PROPERTY(QColor negativeChangeColor READ negativeChangeColor WRITE setNegativeChangeColor NOTIFY negativeChangeColorChanged)
+    Q_PROPERTY(int signalLineWidth READ signalLineWidth WRITE setSignalLineWidth NOTIFY signalLineWidthChanged)
+    Q_PROPERTY(int gridLineWidth READ gridLineWidth WRITE setGridLineWidth NOTIFY gridLineWidthChanged)
+    Q_PROPERTY(double changeGraphScale READ changeGraphScale WRITE setChangeGraphScale NOTIFY changeGraphScaleChanged)
+    Q_PROPERTY(bool changeGraphEnabled READ isChangeGraphEnabled WRITE setChangeGraphEnabled NOTIFY changeGraphEnabledChanged)
+
+public:
+    explicit QValueChartItem(QQuickItem *parent = 0);
+
+    QObject *valueModel() const
+    {
+        return m_valueModel;
+    }
+
+    double startTimestamp() const
+    {
+        return m_startTimestamp;
+    }
+
+    double endTimestamp() const
+    {
+        return m_endTimestamp;
+    }
+
+    double minimumValue() const
+    {
+        return m_minimumValue;
+    }
+
+    double maximumValue() const
+    {
+        return m_maximumValue;
+    }
+
+    double xGrid() const
+    {
+        return m_xGrid;
+    }
+
+    double yGrid() const
+    {
+        return m_yGrid;
+    }
+
+    QColor backgroundColor() const
+    {
+        return m_backgroundColor;
+    }
+
+    QColor gridColor() const
+    {
+        return m_gridColor;
+    }
+
+    QColor signalColor() const
+    {
+        return m_signalColor;
+    }
+
+    QColor hLineColor() const
+    {
+        return m_hLineColor;
+    }
+
+    QColor positiveChangeColor() const
+    {
+        return m_positiveChangeColor;
+    }
+
+    QColor negativeChangeColor() const
+    {
+        return m_negativeChangeColor;
+    }
+
+    int signalLineWidth() const
+    {
+        return m_signalLineWidth;
+    }
+
+    int gridLineWidth() const
+    {
+        return m_gridLineWidth;
+    }
+
+    double changeGraphScale() const
+    {
+        return m_changeGraphScale;
+    }
+
+    bool isChangeGraphEnabled() const
+    {
+        return m_changeGraphEnabled;
+    }
+
+public slots:
+    void setValueModel(QObject *arg);
+    void setStartTimestamp(double arg);
+    void setEndTimestamp(double arg);
+    void setMinimumValue(double arg);
+    void setMaximumValue(double arg);
+    void setXGrid(double arg);
+    void setYGrid(double arg);
+    void setBackgroundColor(const QColor &arg);
+    void setGridColor(const QColor &arg);
+    void setSignalColor(const QColor &arg);
+    void setHLineColor(const QColor &arg);
+    void setPositiveChangeColor(const QColor &arg);
+    void setNegativeChangeColor(const QColor &arg);
+    void setSignalLineWidth(int arg);
+    void setGridLineWidth(int arg);
+    void setChangeGraphScale(double arg);
+    void setChangeGraphEnabled(bool arg);
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *updatePaintNodeData);
+    void geometryChanged(const QRectF &newGeometry, const QRectF &oldGeometry);
+
+private:
+    typedef struct {
+        qint64 column;      // absolute column, timestamp / column width
+        float first;
+        float minimum;
+        float maximum;
+        float last;
+        bool minimumFirst;
+    } Column;
+
+    QPointer<QValueModel> m_valueModel;
+    double m_startTimestamp;
+    double m_endTimestamp;
+    double m_minimumValue;
+    double m_maximumValue;
+    double m_xGrid;
+    double m_yGrid;
+    QColor m_backgroundColor;
+    QColor m_gridColor;
+    QColor m_signalColor;
+    QColor m_hLineColor;
+    QColor m_positiveChangeColor;
+    QColor m_negativeChangeColor;
+    int m_signalLineWidth;
+    int m_gridLineWidth;
+    double m_changeGraphScale;
+    bool m_changeGraphEnabled;
+
+    QVector<Column> m_columns;
+    double m_columnWidth;       // ms per column
+    qint64 m_baseColumn;        // column at vertex x = 0
+    double m_coveredFrom;       // timestamp from which on the columns are complete
+    qint64 m_nextSequence;      // sequence number of the next sample to fold in
+    bool m_columnsDirty;        // all columns have to be rebuilt
+    int m_droppedColumns;       // columns scrolled out since the last update of the slots
+    int m_writtenColumns;       // columns written to the slots
+    int m_slotOffset;           // slot of the first column
+    int m_slotCapacity;         // number of slots allocated in the signal and change nodes
+    bool m_slotsDirty;          // all slots have to be rewritten
+    bool m_changeDirty;         // the change graph has to be rewritten
+    bool m_gridDirty;
+    bool m_targetDirty;
+    double m_gridTimeSpan;
+
+    bool updateColumns();
+    void addSample(double timestamp, double value);
+    void updateGridNode(QSGGeometryNode *node);
+    void updateTargetNode(QSGGeometryNode *node);
+    void updateColumnNodes(QSGGeometryNode *signalNode, QSGGeometryNode *changeNode);
+    void writeSignalSlots(QSGGeometryNode *node, int firstColumn, int lastColumn);
+    void writeChangeSlots(QSGGeometryNode *node, int firstColumn, int lastColumn);
+    void clearSlots(QSGGeometryNode *signalNode, QSGGeometryNode *changeNode, int firstSlot, int count);
+    void updateTransform(QSGTransformNode *node);
+    void updateStyle(QSGNode *root);
+
+private slots:
+    void invalidateColumns();
+    void invalidateTarget();
+
+signals:
+    void valueModelChanged(QObject *arg);
+    void startTimestampChanged(double arg);
+    void endTimestampChanged(double arg);
+    void minimumValueChanged(double arg);
+    void maximumValueChanged(double arg);
+    void xGridChanged(double arg);
+    void yGridChanged(double arg);
+    void backgroundColorChanged(const QColor &arg);
+    void gridColorChanged(const QColor &arg);
+    void signalColorChanged(const QColor &arg);
+    void hLineColorChanged(const QColor &arg);
+    void positiveChangeColorChanged(const QColor &arg);
+    void negativeChangeColorChanged(const QColor &arg);
+    void signalLineWidthChanged(int arg);
+    void gridLineWidthChanged(int arg);
+    void changeGraphScaleChanged(double arg);
+    void changeGraphEnabledChanged(bool arg);
+};
+
+#endif // QVALUECHARTITEM_H
@@ -0,0 +1,596 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#include "qvaluemodel.h"
+#include <QDateTime>
+#include <QMetaMethod>
+
+/*!
+    \qmltype ValueModel
+    \instantiates QValueModel
+    \inqmlmodule Machinekit.Controls
+    \brief Provides a model to store values in combination with timestamps.
+    \ingroup machinekitcontrols
+
+    The value model may be used in combination with the \l{ValueChart}.
+    The values are kept in a ring buffer of \l maximumSize entries, the
+    oldest entry is overwritten when more data is added.
+
+    Values can be added with \l addData or sampled from a property of a
+    \l source object, either periodically or whenever the property changes.
+
+    \qml
+    ValueModel {
+        id: valueModel
+        name: "My value model"
+        source: halPin
+        sourceProperty: "value"
+        samplingMode: ValueModel.ChangeSampling
+    }
+    \endqml
+
+    \sa ValueChart, LogChart
+*/
+
+/*! \qmlproperty string ValueModel::name
+
+    This property holds the name of the value model.
+*/
+
+/*! \qmlproperty real ValueModel::startTimestamp
+
+    This property holds the timestamp of the first stored value.
+*/
+
+/*! \qmlproperty real ValueModel::endTimestamp
+
+    This property holds the timestamp of the last stored value.
+*/
+
+/*! \qmlproperty double ValueModel::highestValue
+
+    This property holds the highest value in the value model.
+*/
+
+/*! \qmlproperty double ValueModel::lowestValue
+
+    This property holds the lowest value in the value model.
+*/
+
+/*! \qmlproperty double ValueModel::currentValue
+
+    This property holds the current value of the value model.
+*/
+
+/*! \qmlproperty double ValueModel::targetValue
+
+    This property holds the target value of the value model (e.g. for PID loops).
+
+    The default value is \c{0}.
+*/
+
+/*! \qmlproperty bool ValueModel::ready
+
+    This property holds wether the value model contains data or not.
+*/
+
+/*! \qmlproperty int ValueModel::maximumSize
+
+    This property holds how many value entries should be stored as maximum.
+    The model will remove the oldest entries if more data is added.
+
+    The default value is \c{5000}.
+*/
+
+/*! \qmlproperty int ValueModel::count
+
+    This property holds the number of stored values.
+*/
+
+/*! \qmlproperty QtObject ValueModel::source
+
+    This property holds the object that is sampled.
+*/
+
+/*! \qmlproperty string ValueModel::sourceProperty
+
+    This property holds the name of the property of \l source that is sampled.
+*/
+
+/*! \qmlproperty enumeration ValueModel::samplingMode
+
+    This property holds how the \l source is sampled.
+
+    \list
+    \li ValueModel.ManualSampling - values are only added with \l addData (default)
+    \li ValueModel.ChangeSampling - a value is added whenever the property changes.
+        If the source has a signal \c{<property>Sampled(double value, double timestamp)},
+        like \l HalPin, the value is added with the timestamp of that signal.
+    \li ValueModel.TimerSampling - the property is sampled every \l sampleInterval ms
+    \endlist
+*/
+
+/*! \qmlproperty int ValueModel::sampleInterval
+
+    This property holds the interval the source is sampled with in ms
+    when using timer sampling.
+
+    The default value is \c{10}.
+*/
+
+/*! \qmlsignal ValueModel::dataReady()
+
+    This signal is emitted when new data is ready.
+*/
+
+QValueModel::QValueModel(QObject *parent) :
+    QAbstractListModel(parent),
+    m_name(""),
+    m_targetValue(0.0),
+    m_samples(5000),
+    m_first(0),
+    m_count(0),
+    m_added(0),
+    m_source(NULL),
+    m_sourceProperty(""),
+    m_samplingMode(ManualSampling),
+    m_sampleTimer(new QTimer(this))
+{
+    m_sampleTimer->setInterval(10);
+    m_sampleTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_sampleTimer, SIGNAL(timeout()),
+            this, SLOT(sampleSource()));
+
+    m_maxima.reset(m_samples.size());
+    m_minima.reset(m_samples.size());
+}
+
+QVariant QValueModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || (index.row() >= m_count))
+    {
+        return QVariant();
+    }
+
+    switch (role)
+    {
+    case TimestampRole: return sample(index.row()).timestamp;
+    case ValueRole: return sample(index.row()).value;
+    default: return QVariant();
+    }
+}
+
+int QValueModel::rowCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent)
+    return m_count;
+}
+
+QHash<int, QByteArray> QValueModel::roleNames() const
+{
+    QHash<int, QByteArray> roles;
+    roles[TimestampRole] = "timestamp";
+    roles[ValueRole] = "value";
+    return roles;
+}
+
+double QValueModel::startTimestamp() const
+{
+    return (m_count > 0) ? sample(0).timestamp : 0.0;
+}
+
+double QValueModel::endTimestamp() const
+{
+    return (m_count > 0) ? sample(m_count - 1).timestamp : 0.0;
+}
+
+double QValueModel::highestValue() const
+{
+    return (m_count > 0) ? sampleAt(m_maxima.first()).value : 0.0;
+}
+
+double QValueModel::lowestValue() const
+{
+    return (m_count > 0) ? sampleAt(m_minima.first()).value : 0.0;
+}
+
+double QValueModel::currentValue() const
+{
+    return (m_count > 0) ? sample(m_count - 1).value : 0.0;
+}
+
+void QValueModel::setName(const QString &arg)
+{
+    if (m_name != arg) {
+        m_name = arg;
+        emit nameChanged(arg);
+    }
+}
+
+void QValueModel::setTargetValue(double arg)
+{
+    if (m_targetValue != arg) {
+        m_targetValue = arg;
+        emit targetValueChanged(arg);
+    }
+}
+
+/** Resizes the ring buffer, the newest values are kept */
+void QValueModel::setMaximumSize(int arg)
+{
+    arg = qMax(arg, 1);
+    if (m_samples.size() == arg)
+    {
+        return;
+    }
+
+    QVector<Sample> samples(arg);
+    int count = qMin(m_count, arg);
+    int offset = m_count - count;
+
+    for (int i = 0; i < count; ++i)
+    {
+        samples[i] = sample(offset + i);
+    }
+
+    beginResetModel();
+    m_samples = samples;
+    m_first = 0;
+    m_count = count;
+    resetExtrema();
+    endResetModel();
+
+    emit maximumSizeChanged(arg);
+    emit dataReady();
+}
+
+void QValueModel::setSource(QObject *arg)
+{
+    if (m_source != arg) {
+        m_source = arg;
+        updateProperty();
+        emit sourceChanged(arg);
+    }
+}
+
+void QValueModel::setSourceProperty(const QString &arg)
+{
+    if (m_sourceProperty != arg) {
+        m_sourceProperty = arg;
+        updateProperty();
+        emit sourcePropertyChanged(arg);
+    }
+}
+
+void QValueModel::setSamplingMode(QValueModel::SamplingMode arg)
+{
+    if (m_samplingMode != arg) {
+        m_samplingMode = arg;
+        updateSampling();
+        emit samplingModeChanged(arg);
+    }
+}
+
+void QValueModel::setSampleInterval(int arg)
+{
+    if (m_sampleTimer->interval() != arg) {
+        m_sampleTimer->setInterval(arg);
+        emit sampleIntervalChanged(arg);
+    }
+}
+
+/*! \qmlmethod ValueModel::addData(double value)
+
+    Adds one entry with the current time as timestamp to the value model.
+*/
+void QValueModel::addData(double value)
+{
+    addData(value, (double)QDateTime::currentMSecsSinceEpoch());
+}
+
+/*! \qmlmethod ValueModel::addData(double value, real timestamp)
+
+    Adds one entry with the given timestamp to the value model.
+    The timestamps have to be added in ascending order.
+*/
+void QValueModel::addData(double value, double timestamp)
+{
+    bool wasReady = isReady();
+
+    if (m_count == m_samples.size()) // overwrite the oldest sample
+    {
+        qint64 oldest = m_added - m_count;
+        if (m_maxima.first() == oldest)
+        {
+            m_maxima.removeFirst();
+        }
+        if (m_minima.first() == oldest)
+        {
+            m_minima.removeFirst();
+        }
+
+        beginRemoveRows(QModelIndex(), 0, 0);
+        m_first = (m_first + 1) % m_samples.size();
+        m_count--;
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), m_count, m_count);
+    Sample &newSample = m_samples[(m_first + m_count) % m_samples.size()];
+    newSample.timestamp = timestamp;
+    newSample.value = value;
+    m_count++;
+    m_added++;
+    pushExtrema(m_added - 1);
+    endInsertRows();
+
+    if (!wasReady)
+    {
+        emit readyChanged(true);
+    }
+    emit dataReady();
+}
+
+/*! \qmlmethod ValueModel::clearData()
+
+    Clears all the data in the value model.
+*/
+void QValueModel::clearData()
+{
+    if (m_count == 0)
+    {
+        return;
+    }
+
+    beginResetModel();
+    m_first = 0;
+    m_count = 0;
+    m_maxima.clear();
+    m_minima.clear();
+    endResetModel();
+
+    emit readyChanged(false);
+    emit dataReady();
+}
+
+/*! \qmlmethod int ValueModel::indexOf(real timestamp)
+
+    Returns the index of the last entry with a timestamp not greater than
+    \a timestamp. Returns \c{0} for timestamps before the first entry and
+    \c{-1} if the model is empty.
+*/
+int QValueModel::indexOf(double timestamp) const
+{
+    if (m_count == 0)
+    {
+        return -1;
+    }
+
+    if (sample(m_count - 1).timestamp <= timestamp)
+    {
+        return m_count - 1;
+    }
+
+    if (sample(0).timestamp >= timestamp)
+    {
+        return 0;
+    }
+
+    int low = 0;                // timestamp(low) < timestamp
+    int high = m_count - 1;     // timestamp(high) > timestamp
+    while ((high - low) > 1)
+    {
+        int middle = low + (high - low) / 2;
+        if (sample(middle).timestamp > timestamp)
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle;
+        }
+    }
+
+    return low;
+}
+
+/*! \qmlmethod object ValueModel::get(int index)
+
+    Returns the entry at \a index as object with the properties
+    \c timestamp and \c value.
+*/
+QVariantMap QValueModel::get(int index) const
+{
+    QVariantMap map;
+
+    if ((index >= 0) && (index < m_count))
+    {
+        map.insert("timestamp", sample(index).timestamp);
+        map.insert("value", sample(index).value);
+    }
+
+    return map;
+}
+
+/*! \qmlmethod list ValueModel::window(real startTimestamp, real endTimestamp, int maximumPoints)
+
+    Returns the entries between \a startTimestamp and \a endTimestamp including
+    the entries right before and after the window as list of objects with the
+    properties \c timestamp and \c value.
+
+    If \a maximumPoints is greater than \c{0} and the window contains more entries,
+    the entries are reduced to the lowest and highest value of equally sized
+    buckets, so peaks stay visible in the reduced data.
+*/
+QVariantList QValueModel::window(double startTimestamp, double endTimestamp, int maximumPoints) const
+{
+    QVariantList list;
+
+    if (m_count == 0)
+    {
+        return list;
+    }
+
+    int first = indexOf(startTimestamp);
+    int last = indexOf(endTimestamp);
+    if ((last < (m_count - 1)) && (sample(last).timestamp < endTimestamp))
+    {
+        last++;
+    }
+
+    int count = last - first + 1;
+    if ((maximumPoints <= 0) || (count <= maximumPoints))
+    {
+        for (int i = first; i <= last; ++i)
+        {
+            list.append(get(i));
+        }
+        return list;
+    }
+
+    int buckets = qMax(maximumPoints / 2, 1);
+    for (int bucket = 0; bucket < buckets; ++bucket)
+    {
+        int begin = first + (int)((qint64)count * bucket / buckets);
+        int end = first + (int)((qint64)count * (bucket + 1) / buckets);
+        int minimum = begin;
+        int maximum = begin;
+
+        for (int i = begin + 1; i < end; ++i)
+        {
+            double value = sample(i).value;
+            if (value < sample(minimum).value)
+            {
+                minimum = i;
+            }
+            if (value > sample(maximum).value)
+            {
+                maximum = i;
+            }
+        }
+
+        list.append(get(qMin(minimum, maximum)));
+        if (minimum != maximum)
+        {
+            list.append(get(qMax(minimum, maximum)));
+        }
+    }
+
+    return list;
+}
+
+void QValueModel::updateProperty()
+{
+    m_property = QMetaProperty();
+
+    if (!m_source.isNull() && !m_sourceProperty.isEmpty())
+    {
+        const QMetaObject *metaObject = m_source->metaObject();
+        int index = metaObject->indexOfProperty(m_sourceProperty.toLocal8Bit().constData());
+        if (index != -1)
+        {
+            m_property = metaObject->property(index);
+        }
+    }
+
+    updateSampling();
+}
+
+void QValueModel::updateSampling()
+{
+    disconnect(m_sourceConnection);
+    m_sampleTimer->stop();
+
+    if (m_source.isNull() || !m_property.isValid())
+    {
+        return;
+    }
+
+    if (m_samplingMode == TimerSampling)
+    {
+        m_sampleTimer->start();
+    }
+    else if (m_samplingMode == ChangeSampling)
+    {
+        // sources can deliver the value with its receive time, e.g. HalPin::valueSampled
+        QByteArray signature = QByteArray(m_property.name()) + "Sampled(double,double)";
+        int signalIndex = m_source->metaObject()->indexOfSignal(signature.constData());
+
+        if (signalIndex != -1)
+        {
+            QMetaMethod slot = metaObject()->method(metaObject()->indexOfSlot("addData(double,double)"));
+            m_sourceConnection = connect(m_source.data(), m_source->metaObject()->method(signalIndex), this, slot);
+        }
+        else if (m_property.hasNotifySignal())
+        {
+            QMetaMethod slot = metaObject()->method(metaObject()->indexOfSlot("sampleSource()"));
+            m_sourceConnection = connect(m_source.data(), m_property.notifySignal(), this, slot);
+        }
+    }
+}
+
+/** Appends the sample with the sequence number to the monotonic queues
+ *  of maxima and minima. The front of each queue is the extremum of the
+ *  stored samples, so highestValue and lowestValue are updated in amortized
+ *  constant time as the ring buffer is overwritten.
+ **/
+void QValueModel::pushExtrema(qint64 sequence)
+{
+    double value = sampleAt(sequence).value;
+
+    while (!m_maxima.isEmpty() && (sampleAt(m_maxima.last()).value <= value))
+    {
+        m_maxima.removeLast();
+    }
+    m_maxima.append(sequence);
+
+    while (!m_minima.isEmpty() && (sampleAt(m_minima.last()).value >= value))
+    {
+        m_minima.removeLast();
+    }
+    m_minima.append(sequence);
+}
+
+void QValueModel::resetExtrema()
+{
+    m_maxima.reset(m_samples.size());
+    m_minima.reset(m_samples.size());
+
+    for (qint64 sequence = firstSequence(); sequence < m_added; ++sequence)
+    {
+        pushExtrema(sequence);
+    }
+}
+
+void QValueModel::sampleSource()
+{
+    if (m_source.isNull() || !m_property.isValid())
+    {
+        return;
+    }
+
+    bool ok;
+    double value = m_property.read(m_source.data()).toDouble(&ok);
+    if (ok)
+    {
+        addData(value);
+    }
+}
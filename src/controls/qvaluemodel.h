@@ -0,0 +1,254 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#ifndef QVALUEMODEL_H
+#define QVALUEMODEL_H
+
+#include <QAbstractListModel>
+#include <QVector>
+#include <QMetaProperty>
+#include <QPointer>
+#include <QTimer>
+#include <QVariantList>
+
+class QValueModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_PROPERTY(QString name READ name WRITE setName NOTIFY nameChanged)
+    Q_PROPERTY(double startTimestamp READ startTimestamp NOTIFY dataReady)
+    Q_PROPERTY(double endTimestamp READ endTimestamp NOTIFY dataReady)
+    Q_PROPERTY(double highestValue READ highestValue NOTIFY dataReady)
+    Q_PROPERTY(double lowestValue READ lowestValue NOTIFY dataReady)
+    Q_PROPERTY(double currentValue READ currentValue NOTIFY dataReady)
+    Q_PROPERTY(double targetValue READ targetValue WRITE setTargetValue NOTIFY targetValueChanged)
+    Q_PROPERTY(bool ready READ isReady NOTIFY readyChanged)
+    Q_PROPERTY(int maximumSize READ maximumSize WRITE setMaximumSize NOTIFY maximumSizeChanged)
+    Q_PROPERTY(int count READ count NOTIFY dataReady)
+    Q_PROPERTY(QObject *source READ source WRITE setSource NOTIFY sourceChanged)
+    Q_PROPERTY(QString sourceProperty READ sourceProperty WRITE setSourceProperty NOTIFY sourcePropertyChanged)
+    Q_PROPERTY(SamplingMode samplingMode READ samplingMode WRITE setSamplingMode NOTIFY samplingModeChanged)
+    Q_PROPERTY(int sampleInterval READ sampleInterval WRITE setSampleInterval NOTIFY sampleIntervalChanged)
+    Q_ENUMS(SamplingMode)
+
+public:
+    enum SamplingMode {
+        ManualSampling = 0,
+        ChangeSampling = 1,
+        TimerSampling = 2
+    };
+
+    enum ValueRoles {
+        TimestampRole = Qt::UserRole,
+        ValueRole
+    };
+
+    explicit QValueModel(QObject *parent = 0);
+
+    QVariant data(const QModelIndex &index, int role) const;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    QHash<int, QByteArray> roleNames() const;
+
+    QString name() const
+    {
+        return m_name;
+    }
+
+    double startTimestamp() const;
+    double endTimestamp() const;
+    double highestValue() const;
+    double lowestValue() const;
+    double currentValue() const;
+
+    double targetValue() const
+    {
+        return m_targetValue;
+    }
+
+    bool isReady() const
+    {
+        return m_count > 0;
+    }
+
+    int maximumSize() const
+    {
+        return m_samples.size();
+    }
+
+    int count() const
+    {
+        return m_count;
+    }
+
+    QObject *source() const
+    {
+        return m_source;
+    }
+
+    QString sourceProperty() const
+    {
+        return m_sourceProperty;
+    }
+
+    SamplingMode samplingMode() const
+    {
+        return m_samplingMode;
+    }
+
+    int sampleInterval() const
+    {
+        return m_sampleTimer->interval();
+    }
+
+    double timestampAt(int index) const
+    {
+        return sample(index).timestamp;
+    }
+
+    double valueAt(int index) const
+    {
+        return sample(index).value;
+    }
+
+    /** Returns the sequence number of the first stored sample. Every added
+     *  sample gets the next sequence number, so views can tell which samples
+     *  were appended since they last looked at the model.
+     **/
+    qint64 firstSequence() const
+    {
+        return m_added - m_count;
+    }
+
+public slots:
+    void setName(const QString &arg);
+    void setTargetValue(double arg);
+    void setMaximumSize(int arg);
+    void setSource(QObject *arg);
+    void setSourceProperty(const QString &arg);
+    void setSamplingMode(SamplingMode arg);
+    void setSampleInterval(int arg);
+
+    void addData(double value);
+    void addData(double value, double timestamp);
+    void clearData();
+    int indexOf(double timestamp) const;
+    QVariantMap get(int index) const;
+    QVariantList window(double startTimestamp, double endTimestamp, int maximumPoints = 0) const;
+
+private:
+    typedef struct {
+        double timestamp;
+        double value;
+    } Sample;
+
+    /** Double ended queue of sequence numbers in a preallocated ring,
+     *  never holds more entries than the ring buffer of samples.
+     **/
+    class SequenceQueue {
+    public:
+        SequenceQueue() : m_first(0), m_count(0) {}
+
+        void reset(int capacity)
+        {
+            m_items.resize(capacity);
+            clear();
+        }
+        void clear()
+        {
+            m_first = 0;
+            m_count = 0;
+        }
+        bool isEmpty() const
+        {
+            return m_count == 0;
+        }
+        qint64 first() const
+        {
+            return m_items.at(m_first);
+        }
+        qint64 last() const
+        {
+            return m_items.at((m_first + m_count - 1) % m_items.size());
+        }
+        void append(qint64 sequence)
+        {
+            m_items[(m_first + m_count) % m_items.size()] = sequence;
+            m_count++;
+        }
+        void removeFirst()
+        {
+            m_first = (m_first + 1) % m_items.size();
+            m_count--;
+        }
+        void removeLast()
+        {
+            m_count--;
+        }
+
+    private:
+        QVector<qint64> m_items;
+        int m_first;
+        int m_count;
+    };
+
+    QString m_name;
+    double m_targetValue;
+    QVector<Sample> m_samples;  // ring buffer
+    int m_first;
+    int m_count;
+    qint64 m_added;             // sequence number of the next sample
+    SequenceQueue m_maxima;     // sequence numbers of decreasing values
+    SequenceQueue m_minima;     // sequence numbers of increasing values
+    QPointer<QObject> m_source;
+    QString m_sourceProperty;
+    QMetaProperty m_property;
+    QMetaObject::Connection m_sourceConnection;
+    SamplingMode m_samplingMode;
+    QTimer *m_sampleTimer;
+
+    const Sample &sample(int index) const
+    {
+        return m_samples.at((m_first + index) % m_samples.size());
+    }
+    const Sample &sampleAt(qint64 sequence) const
+    {
+        return sample((int)(sequence - (m_added - m_count)));
+    }
+    void updateProperty();
+    void updateSampling();
+    void pushExtrema(qint64 sequence);
+    void resetExtrema();
+
+private slots:
+    void sampleSource();
+
+signals:
+    void nameChanged(const QString &arg);
+    void targetValueChanged(double arg);
+    void readyChanged(bool arg);
+    void maximumSizeChanged(int arg);
+    void sourceChanged(QObject *arg);
+    void sourcePropertyChanged(const QString &arg);
+    void samplingModeChanged(SamplingMode arg);
+    void sampleIntervalChanged(int arg);
+    void dataReady();
+};
+
+#endif // QVALUEMODEL_H
@@ -15,6 +15,9 @@ SOURCES += \
     qhalremotecomponent.cpp \
     qhalgroup.cpp \
     qhalsignal.cpp \
+    qhalvalue.cpp \
+    qhalconnection.cpp \
+    qhaltracerecorder.cpp \
 
 HEADERS += \
     plugin.h \
@@ -22,6 +25,12 @@ HEADERS += \
     qhalremotecomponent.h \
     qhalgroup.h \
     qhalsignal.h \
+    qhalhandletable.h \
+    qhalvalue.h \
+    qhalobjectregistry.h \
+    qhalconnection.h \
+    qhaltracerecorder.h \
+    qhaltraceformat.h \
     debughelper.h
 
 QML_INFRA_FILES = \
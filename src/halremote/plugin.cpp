@@ -24,6 +24,7 @@
 #include "qhalsignal.h"
 #include "qhalgroup.h"
 #include "qhalremotecomponent.h"
+#include "qhaltracerecorder.h"
 
 void MachinekitHalRemotePlugin::registerTypes(const char *uri)
 {
@@ -37,6 +38,7 @@ void MachinekitHalRemotePlugin::registerTypes(const char *uri)
     qmlRegisterType<QHalPin>(uri, 1, 0, "HalPin");
     qmlRegisterType<QHalGroup>(uri, 1, 0, "HalGroup");
     qmlRegisterType<QHalSignal>(uri, 1, 0, "HalSignal");
+    qmlRegisterType<QHalTraceRecorder>(uri, 1, 0, "HalTraceRecorder");
 }
 
 void MachinekitHalRemotePlugin::initializeEngine(QQmlEngine *engine, const char *uri)
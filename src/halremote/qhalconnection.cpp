@@ -0,0 +1,475 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#include "qhalconnection.h"
+#include "qhalremotecomponent.h"
+#include "debughelper.h"
+
+QHalConnection::QHalConnection(const QString &halrcmdUri, const QString &halrcompUri) :
+    QObject(NULL),
+    m_halrcmdUri(halrcmdUri),
+    m_halrcompUri(halrcompUri),
+    m_uuid(QUuid::createUuid()),
+    m_halrcmdSocket(NULL),
+    m_halrcompSocket(NULL),
+    m_halrcompDecoder(NULL),
+    m_heartbeatTimer(new QTimer(this)),
+    m_pingTimer(new QTimer(this)),
+    m_bindTimer(new QTimer(this)),
+    m_pingOutstanding(false),
+    m_lastSetSender(NULL)
+{
+    m_pingTimer->setSingleShot(true);
+    m_bindTimer->setSingleShot(true);
+
+    connect(m_heartbeatTimer, SIGNAL(timeout()),
+            this, SLOT(heartbeatTimerTick()));
+    connect(m_pingTimer, SIGNAL(timeout()),
+            this, SLOT(sendPing()));
+    connect(m_bindTimer, SIGNAL(timeout()),
+            this, SLOT(sendBinds()));
+}
+
+QHalConnection::~QHalConnection()
+{
+    disconnectSockets();
+}
+
+QHash<QHalConnection::UriPair, QHalConnection*> &QHalConnection::connections()
+{
+    static QHash<UriPair, QHalConnection*> hash;
+    return hash;
+}
+
+/** Attaches a component to the connection for its uris, the connection
+ *  is created if no other component uses these uris yet.
+ *  Returns NULL and sets errorString if the sockets cannot be connected.
+ **/
+QHalConnection *QHalConnection::attach(QHalRemoteComponent *component, QString *errorString)
+{
+    UriPair uris(component->halrcmdUri(), component->halrcompUri());
+    QHalConnection *connection = connections().value(uris, NULL);
+
+    if (connection == NULL)
+    {
+        connection = new QHalConnection(uris.first, uris.second);
+        if (!connection->connectSockets(errorString))
+        {
+            delete connection;
+            return NULL;
+        }
+        connections().insert(uris, connection);
+    }
+
+    connection->m_components.append(component);
+    connect(component, SIGNAL(destroyed(QObject*)),
+            connection, SLOT(componentDestroyed(QObject*)));
+    connection->updateHeartbeat();
+    connection->m_pingTimer->start(0);  // one ping for all components attaching in this event loop cycle
+
+    return connection;
+}
+
+/** Detaches a component, the last component closes the connection */
+void QHalConnection::detach(QHalRemoteComponent *component)
+{
+    disconnect(component, SIGNAL(destroyed(QObject*)),
+               this, SLOT(componentDestroyed(QObject*)));
+    removeComponent(component);
+
+    if (!m_components.isEmpty())
+    {
+        updateHeartbeat();
+        return;
+    }
+
+    connections().remove(UriPair(m_halrcmdUri, m_halrcompUri));
+    disconnectSockets();
+    deleteLater();
+}
+
+/** Detaches a component that was destroyed without detaching */
+void QHalConnection::componentDestroyed(QObject *component)
+{
+    detach(static_cast<QHalRemoteComponent*>(component));   // only compared, never dereferenced
+}
+
+/** Removes all references to a component, the component is only
+ *  compared since it may be in destruction already */
+void QHalConnection::removeComponent(QObject *component)
+{
+    QMutableHashIterator<QByteArray, QHalRemoteComponent*> it(m_subscriptions);
+
+    while (it.hasNext())
+    {
+        it.next();
+        if (it.value() == component)
+        {
+            if (m_halrcompSocket != NULL) {
+                m_halrcompSocket->unsubscribeFrom(it.key());
+            }
+            it.remove();
+        }
+    }
+
+    m_components.removeAll(static_cast<QHalRemoteComponent*>(component));
+    m_pendingBinds.removeAll(static_cast<QHalRemoteComponent*>(component));
+    for (int i = 0; i < m_outstandingBinds.size(); ++i)
+    {
+        m_outstandingBinds[i].removeAll(static_cast<QHalRemoteComponent*>(component));
+    }
+    if (m_lastSetSender == component)
+    {
+        m_lastSetSender = NULL;
+    }
+}
+
+/** Queues the bind of a component, the binds of all components
+ *  queued in this event loop cycle are sent in one message */
+void QHalConnection::bind(QHalRemoteComponent *component)
+{
+    if (!m_pendingBinds.contains(component))
+    {
+        m_pendingBinds.append(component);
+    }
+    m_bindTimer->start(0);
+}
+
+void QHalConnection::subscribe(QHalRemoteComponent *component)
+{
+    QByteArray topic = component->name().toLocal8Bit();
+
+    m_subscriptions.insert(topic, component);
+    m_halrcompSocket->subscribeTo(topic);
+}
+
+void QHalConnection::unsubscribe(QHalRemoteComponent *component)
+{
+    QByteArray topic = component->name().toLocal8Bit();
+
+    if (m_subscriptions.remove(topic, component) > 0)
+    {
+        m_halrcompSocket->unsubscribeFrom(topic);
+    }
+}
+
+/** Sends tx with the given type and clears it.
+ *  The sender of a set is remembered to report a set reject to it.
+ **/
+bool QHalConnection::sendHalrcmdMessage(pb::ContainerType type, pb::Container &tx, QHalRemoteComponent *sender)
+{
+    if (m_halrcmdSocket == NULL) {  // disallow sending messages when not connected
+        tx.Clear();
+        return false;
+    }
+
+    try {
+        tx.set_type(type);
+        m_halrcmdSocket->sendMessage(tx);
+        tx.Clear();
+        if (type == pb::MT_HALRCOMP_SET)
+        {
+            m_lastSetSender = sender;
+        }
+    }
+    catch (const zmq::error_t &e) {
+        QString errorString;
+        errorString = QString("Error %1: ").arg(e.num()) + QString(e.what());
+        tx.Clear();
+        reportError(errorString);
+        return false;
+    }
+
+    return true;
+}
+
+bool QHalConnection::connectSockets(QString *errorString)
+{
+    m_halrcmdSocket = TransportManager::instance()->createSocket(nzmqt::ZMQSocket::TYP_DEALER, QString("halrcmd:%1").arg(m_halrcmdUri), this);
+    connect(m_halrcmdSocket, SIGNAL(receiveError(int,QString)),
+            this, SLOT(pollError(int,QString)));
+    m_halrcmdSocket->setLinger(0);
+    m_halrcmdSocket->setIdentity(QString("halrcmd-%1").arg(m_uuid.toString()).toLocal8Bit());
+
+    m_halrcompSocket = TransportManager::instance()->createSocket(nzmqt::ZMQSocket::TYP_SUB, QString("halrcomp:%1").arg(m_halrcompUri), this);
+    connect(m_halrcompSocket, SIGNAL(receiveError(int,QString)),
+            this, SLOT(pollError(int,QString)));
+    m_halrcompSocket->setLinger(0);
+
+    try {
+        m_halrcmdSocket->connectTo(m_halrcmdUri);
+        m_halrcompSocket->connectTo(m_halrcompUri);
+    }
+    catch (const zmq::error_t &e) {
+        *errorString = QString("Error %1: ").arg(e.num()) + QString(e.what());
+        return false;
+    }
+
+    m_halrcompDecoder = new MessageDecoder();
+    connect(m_halrcompDecoder, SIGNAL(messageDecoded(QByteArray,ContainerPointer)),
+            this, SLOT(halrcompMessageDecoded(QByteArray,ContainerPointer)));
+    TransportManager::instance()->attachDecoder(m_halrcompSocket, m_halrcompDecoder);
+    connect(m_halrcmdSocket, SIGNAL(framesReceived(ThreadedZMQFrameList)),
+            this, SLOT(halrcmdMessageReceived(ThreadedZMQFrameList)));
+
+#ifdef QT_DEBUG
+    DEBUG_TAG(1, "halconnection", "sockets connected" << m_halrcompUri << m_halrcmdUri)
+#endif
+
+    return true;
+}
+
+void QHalConnection::disconnectSockets()
+{
+    m_heartbeatTimer->stop();
+    m_pingTimer->stop();
+    m_bindTimer->stop();
+
+    if (m_halrcmdSocket != NULL)
+    {
+        m_halrcmdSocket->close();
+        m_halrcmdSocket->deleteLater();
+        m_halrcmdSocket = NULL;
+    }
+
+    if (m_halrcompSocket != NULL)
+    {
+        m_halrcompSocket->close();
+        m_halrcompSocket->deleteLater();
+        m_halrcompSocket = NULL;
+        m_halrcompDecoder = NULL; // deleted with the socket
+    }
+}
+
+/** Pings with the shortest heartbeat period of the attached components */
+void QHalConnection::updateHeartbeat()
+{
+    int period = 0;
+
+    foreach (QHalRemoteComponent *component, m_components)
+    {
+        if ((component->heartbeatPeriod() > 0)
+            && ((period == 0) || (component->heartbeatPeriod() < period)))
+        {
+            period = component->heartbeatPeriod();
+        }
+    }
+
+    if (period == 0)
+    {
+        m_heartbeatTimer->stop();
+    }
+    else if (!m_heartbeatTimer->isActive() || (m_heartbeatTimer->interval() != period))
+    {
+        m_pingOutstanding = false;
+        m_heartbeatTimer->start(period);
+    }
+}
+
+void QHalConnection::reportError(const QString &errorString)
+{
+    foreach (QHalRemoteComponent *component, m_components) // components detach on error
+    {
+        component->socketError(errorString);
+    }
+}
+
+void QHalConnection::pollError(int errorNum, const QString &errorMsg)
+{
+    QString errorString;
+    errorString = QString("Error %1: ").arg(errorNum) + errorMsg;
+    reportError(errorString);
+}
+
+void QHalConnection::heartbeatTimerTick()
+{
+    if (m_pingOutstanding)
+    {
+        foreach (QHalRemoteComponent *component, m_components)
+        {
+            component->halrcmdTimeout();
+        }
+
+#ifdef QT_DEBUG
+        DEBUG_TAG(1, "halconnection", "halcmd timeout")
+#endif
+    }
+
+    sendPing();
+
+    m_pingOutstanding = true;
+}
+
+void QHalConnection::sendPing()
+{
+    m_pingTimer->stop();
+    sendHalrcmdMessage(pb::MT_PING, m_tx);
+
+#ifdef QT_DEBUG
+    DEBUG_TAG(2, "halconnection", "ping")
+#endif
+}
+
+/** Sends the queued binds as one message with a component each */
+void QHalConnection::sendBinds()
+{
+    if (m_pendingBinds.isEmpty())
+    {
+        return;
+    }
+
+    QList<QHalRemoteComponent*> components = m_pendingBinds;
+    m_pendingBinds.clear();
+    sendBind(components);
+}
+
+/** Sends one bind message with a component each */
+void QHalConnection::sendBind(const QList<QHalRemoteComponent*> &components)
+{
+    foreach (QHalRemoteComponent *component, components)
+    {
+        component->addBindComponent(m_tx.add_comp());
+    }
+    m_outstandingBinds.append(components);
+
+#ifdef QT_DEBUG
+    std::string s;
+    gpb::TextFormat::PrintToString(m_tx, &s);
+    DEBUG_TAG(1, "halconnection", "bind" << m_outstandingBinds.last().size() << "components")
+    DEBUG_TAG(3, "halconnection", QString::fromStdString(s))
+#endif
+
+    sendHalrcmdMessage(pb::MT_HALRCOMP_BIND, m_tx);
+}
+
+/** Processes all message received on the command 0MQ socket */
+void QHalConnection::halrcmdMessageReceived(const ThreadedZMQFrameList &messageList)
+{
+    m_rx.ParseFromArray(messageList.at(0).data(), messageList.at(0).size());
+
+#ifdef QT_DEBUG
+    std::string s;
+    gpb::TextFormat::PrintToString(m_rx, &s);
+    DEBUG_TAG(3, "halconnection", "server message" << QString::fromStdString(s))
+#endif
+
+    if (m_rx.type() == pb::MT_PING_ACKNOWLEDGE)
+    {
+        m_pingOutstanding = false;
+
+        foreach (QHalRemoteComponent *component, m_components)
+        {
+            component->halrcmdPingAcknowledged();
+        }
+
+#ifdef QT_DEBUG
+        DEBUG_TAG(2, "halconnection", "ping ack")
+#endif
+
+        return;
+    }
+    else if ((m_rx.type() == pb::MT_HALRCOMP_BIND_CONFIRM)
+             || (m_rx.type() == pb::MT_HALRCOMP_BIND_REJECT))
+    {
+        QList<QHalRemoteComponent*> components;
+        QString errorString;
+
+        if (!m_outstandingBinds.isEmpty())  // binds are answered in order
+        {
+            components = m_outstandingBinds.takeFirst();
+        }
+
+        for (int i = 0; i < m_rx.note_size(); ++i)
+        {
+            errorString.append(QString::fromStdString(m_rx.note(i)) + "\n");
+        }
+
+        if ((m_rx.type() == pb::MT_HALRCOMP_BIND_REJECT) && (components.size() > 1))
+        {
+            // rebind the components of the batch one by one to find the rejected one
+            foreach (QHalRemoteComponent *component, components)
+            {
+                sendBind(QList<QHalRemoteComponent*>() << component);
+            }
+        }
+        else
+        {
+            foreach (QHalRemoteComponent *component, components)
+            {
+                if (m_rx.type() == pb::MT_HALRCOMP_BIND_CONFIRM)
+                {
+                    component->bindConfirmed();
+                }
+                else
+                {
+                    component->halrcmdError(QHalRemoteComponent::BindError, errorString);
+                }
+            }
+        }
+
+#ifdef QT_DEBUG
+        DEBUG_TAG(1, "halconnection", ((m_rx.type() == pb::MT_HALRCOMP_BIND_CONFIRM) ? "bind confirmed" : "bind rejected") << errorString)
+#endif
+
+        return;
+    }
+    else if (m_rx.type() == pb::MT_HALRCOMP_SET_REJECT)
+    {
+        QString errorString;
+
+        for (int i = 0; i < m_rx.note_size(); ++i)
+        {
+            errorString.append(QString::fromStdString(m_rx.note(i)) + "\n");
+        }
+
+        // the reject does not tell which component sent the set, the
+        // last sender is the best guess, no other component is affected
+        if (m_lastSetSender != NULL)
+        {
+            m_lastSetSender->pinChangeRejected(errorString);
+        }
+
+#ifdef QT_DEBUG
+        DEBUG_TAG(1, "halconnection", "pin change rejected" << errorString)
+#endif
+
+        return;
+    }
+    else
+    {
+#ifdef QT_DEBUG
+        DEBUG_TAG(1, "halconnection", "UNKNOWN server message type")
+#endif
+    }
+}
+
+/** Routes the halrcomp messages to the components subscribed to the topic */
+void QHalConnection::halrcompMessageDecoded(const QByteArray &topic, const ContainerPointer &container)
+{
+    if (sender() != m_halrcompDecoder) {  // decoded before the socket was disconnected
+        return;
+    }
+
+    foreach (QHalRemoteComponent *component, m_subscriptions.values(topic))
+    {
+        component->halrcompMessageReceived(topic, *container, container.receiveTime());
+    }
+}
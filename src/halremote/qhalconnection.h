@@ -0,0 +1,104 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#ifndef QHALCONNECTION_H
+#define QHALCONNECTION_H
+
+#include <QObject>
+#include <QHash>
+#include <QTimer>
+#include <QUuid>
+#include <nzmqt/nzmqt.hpp>
+#include <transportmanager.h>
+#include <machinetalk/protobuf/message.pb.h>
+#include <google/protobuf/text_format.h>
+
+#if defined(Q_OS_IOS)
+namespace gpb = google_public::protobuf;
+#else
+namespace gpb = google::protobuf;
+#endif
+
+class QHalRemoteComponent;
+
+/** The halrcmd and halrcomp connection shared by all remote components
+ *  using the same service uris. The connection pings the halrcmd
+ *  service for all components, batches their binds into one message
+ *  and routes the halrcomp updates to the components by topic.
+ *  It is created by the first component attaching and deleted when
+ *  the last component detaches.
+ **/
+class QHalConnection : public QObject
+{
+    Q_OBJECT
+
+public:
+    static QHalConnection *attach(QHalRemoteComponent *component, QString *errorString);
+    void detach(QHalRemoteComponent *component);
+
+    void bind(QHalRemoteComponent *component);
+    void subscribe(QHalRemoteComponent *component);
+    void unsubscribe(QHalRemoteComponent *component);
+    bool sendHalrcmdMessage(pb::ContainerType type, pb::Container &tx, QHalRemoteComponent *sender = NULL);
+    void updateHeartbeat();
+
+private:
+    QHalConnection(const QString &halrcmdUri, const QString &halrcompUri);
+    ~QHalConnection();
+
+    typedef QPair<QString, QString> UriPair;
+    static QHash<UriPair, QHalConnection*> &connections();
+
+    QString             m_halrcmdUri;
+    QString             m_halrcompUri;
+    QUuid               m_uuid;
+    ThreadedZMQSocket   *m_halrcmdSocket;
+    ThreadedZMQSocket   *m_halrcompSocket;
+    MessageDecoder      *m_halrcompDecoder;
+    QTimer      *m_heartbeatTimer;
+    QTimer      *m_pingTimer;
+    QTimer      *m_bindTimer;
+    bool        m_pingOutstanding;
+    QList<QHalRemoteComponent*> m_components;
+    QMultiHash<QByteArray, QHalRemoteComponent*> m_subscriptions;
+    QList<QHalRemoteComponent*> m_pendingBinds;
+    QList<QList<QHalRemoteComponent*> > m_outstandingBinds;   // binds sent, in order of sending
+    QHalRemoteComponent *m_lastSetSender;   // a set reject does not tell which component sent the set
+    pb::Container   m_rx;
+    pb::Container   m_tx;
+
+    bool connectSockets(QString *errorString);
+    void disconnectSockets();
+    void reportError(const QString &errorString);
+    void sendBind(const QList<QHalRemoteComponent*> &components);
+    void removeComponent(QObject *component);
+
+private slots:
+    void halrcmdMessageReceived(const ThreadedZMQFrameList &messageList);
+    void halrcompMessageDecoded(const QByteArray &topic, const ContainerPointer &container);
+    void pollError(int errorNum, const QString &errorMsg);
+    void heartbeatTimerTick();
+    void sendPing();
+    void sendBinds();
+    void componentDestroyed(QObject *component);
+};
+
+#endif // QHALCONNECTION_H
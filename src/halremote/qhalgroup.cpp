@@ -22,6 +22,8 @@
 
 #include "qhalgroup.h"
 #include "debughelper.h"
+#include "qhalobjectregistry.h"
+#include "qhaltracerecorder.h"
 
 /*! \qmlproperty bool HalGroup::connected
 
@@ -39,35 +41,36 @@ QHalGroup::QHalGroup(QObject *parent) :
     m_error(NoError),
     m_errorString(""),
     m_containerItem(this),
-    m_context(NULL),
     m_halgroupSocket(NULL),
-    m_halgroupHeartbeatTimer(new QTimer(this))
+    m_halgroupDecoder(NULL),
+    m_halgroupHeartbeatTimer(new QTimer(this)),
+    m_traceSource(QHalTraceRecorder::createSource())
 {
     connect(m_halgroupHeartbeatTimer, SIGNAL(timeout()),
             this, SLOT(halgroupHeartbeatTimerTick()));
+
+    QHalObjectRegistry<QHalSignal>::addContainer(m_containerItem);
 }
 
-/** Recurses through a list of objects */
-QList<QHalSignal *> QHalGroup::recurseObjects(const QObjectList &list) const
+QHalGroup::~QHalGroup()
 {
-    QList<QHalSignal*> halSignals;
+    if (m_containerItem != NULL) {
+        QHalObjectRegistry<QHalSignal>::removeContainer(m_containerItem);
+    }
+}
 
-    foreach (QObject *object, list)
-    {
-        QHalSignal *halSignal;
-        halSignal = qobject_cast<QHalSignal*>(object);
-        if (halSignal != NULL)
-        {
-            halSignals.append(halSignal);
+void QHalGroup::setContainerItem(QObject *arg)
+{
+    if (m_containerItem != arg) {
+        if (m_containerItem != NULL) {
+            QHalObjectRegistry<QHalSignal>::removeContainer(m_containerItem);
         }
-
-        if (object->children().size() > 0)
-        {
-            halSignals.append(recurseObjects(object->children()));
+        m_containerItem = arg;
+        if (m_containerItem != NULL) {
+            QHalObjectRegistry<QHalSignal>::addContainer(m_containerItem);
         }
+        emit containerItemChanged(arg);
     }
-
-    return halSignals;
 }
 
 void QHalGroup::start()
@@ -184,10 +187,14 @@ void QHalGroup::updateError(QHalGroup::ConnectionError error, const QString &err
     }
 }
 
-/** Updates a local signal with the value of a remote signal */
-void QHalGroup::signalUpdate(const pb::Signal &remoteSignal, QHalSignal *localSignal)
+/** Updates a local signal with the value of a remote signal.
+ *  Returns true if the values have changed, valuesChanged is
+ *  emitted once per message by the caller.
+ */
+bool QHalGroup::signalUpdate(const pb::Signal &remoteSignal, QHalSignal *localSignal)
 {
     bool updated;
+    QJsonValue value;
 #ifdef QT_DEBUG
     DEBUG_TAG(2, m_name,  "signal update" << localSignal->name() << remoteSignal.halfloat() << remoteSignal.halbit() << remoteSignal.hals32() << remoteSignal.halu32())
 #endif
@@ -197,79 +204,103 @@ void QHalGroup::signalUpdate(const pb::Signal &remoteSignal, QHalSignal *localSi
     if (remoteSignal.type() == pb::HAL_FLOAT)
     {
         localSignal->setType(QHalSignal::Float);
-        localSignal->setValue(QVariant(remoteSignal.halfloat()));
-        m_values[localSignal->name()] = remoteSignal.halfloat();
+        localSignal->setHalValue(QHalValue(remoteSignal.halfloat()));
+        value = remoteSignal.halfloat();
         updated =  true;
     }
     else if (remoteSignal.type() == pb::HAL_BIT)
     {
         localSignal->setType(QHalSignal::Bit);
-        localSignal->setValue(QVariant(remoteSignal.halbit()));
-        m_values[localSignal->name()] = remoteSignal.halbit();
+        localSignal->setHalValue(QHalValue(remoteSignal.halbit()));
+        value = remoteSignal.halbit();
         updated =  true;
     }
     else if (remoteSignal.type() == pb::HAL_S32)
     {
         localSignal->setType(QHalSignal::S32);
-        localSignal->setValue(QVariant(remoteSignal.hals32()));
-        m_values[localSignal->name()] = remoteSignal.hals32();
+        localSignal->setHalValue(QHalValue((qint32)remoteSignal.hals32()));
+        value = remoteSignal.hals32();
         updated =  true;
     }
     else if (remoteSignal.type() == pb::HAL_U32)
     {
         localSignal->setType(QHalSignal::U32);
-        localSignal->setValue(QVariant(remoteSignal.halu32()));
-        m_values[localSignal->name()] = (int)remoteSignal.halu32();
+        localSignal->setHalValue(QHalValue((quint32)remoteSignal.halu32()));
+        value = (int)remoteSignal.halu32();
         updated =  true;
     }
 
     if (updated)
     {
         localSignal->setSynced(true);   // when the signal is updated we are synced
-        emit valuesChanged(m_values);
+        QHalTraceRecorder::record(QHalTraceSignalUpdate, m_traceSource, localSignal->handle(), localSignal->halValue());
+
+        QJsonObject::iterator it = m_values.find(localSignal->name());
+        if (it == m_values.end())
+        {
+            m_values.insert(localSignal->name(), value);
+            return true;
+        }
+        else if (it.value() != value)
+        {
+            it.value() = value;
+            return true;
+        }
     }
+
+    return false;
 }
 
-void QHalGroup::halgroupMessageReceived(const QList<QByteArray> &messageList)
+void QHalGroup::halgroupMessageDecoded(const QByteArray &topic, const ContainerPointer &container)
 {
-    QByteArray topic;
+    const pb::Container &rx = *container;
 
-    topic = messageList.at(0);
-    m_rx.ParseFromArray(messageList.at(1).data(), messageList.at(1).size());
+    if (sender() != m_halgroupDecoder) {  // decoded before the socket was disconnected
+        return;
+    }
 
 #ifdef QT_DEBUG
     std::string s;
-    gpb::TextFormat::PrintToString(m_rx, &s);
+    gpb::TextFormat::PrintToString(rx, &s);
     DEBUG_TAG(3, m_name, "halgroup update" << topic << QString::fromStdString(s))
 #endif
 
-    if (m_rx.type() == pb::MT_HALGROUP_INCREMENTAL_UPDATE) // incremental update
+    if (rx.type() == pb::MT_HALGROUP_INCREMENTAL_UPDATE) // incremental update
     {
-        for (int i = 0; i < m_rx.signal_size(); ++i)
+        bool changed = false;
+
+        for (int i = 0; i < rx.signal_size(); ++i)
         {
-            pb::Signal remoteSignal = m_rx.signal(i);
-            QHalSignal *localSignal = m_signalsByHandle.value(remoteSignal.handle(), NULL);
+            const pb::Signal &remoteSignal = rx.signal(i);
+            QHalSignal *localSignal = m_signalTable.value(remoteSignal.handle());
             if (localSignal != NULL) // in case we received a wrong signal handle
             {
-                signalUpdate(remoteSignal, localSignal);
+                changed |= signalUpdate(remoteSignal, localSignal);
             }
         }
 
+        if (changed)
+        {
+            emit valuesChanged(m_values);
+        }
+
         refreshHalgroupHeartbeat();
 
         return;
     }
-    else if (m_rx.type() == pb::MT_HALGROUP_FULL_UPDATE) // full update
+    else if (rx.type() == pb::MT_HALGROUP_FULL_UPDATE) // full update
     {
-        for (int i = 0; i < m_rx.group_size(); ++i)
+        for (int i = 0; i < rx.group_size(); ++i)
         {
-            pb::Group group = m_rx.group(i);
+            const pb::Group &group = rx.group(i);
+            bool changed = false;
+
             for (int j = 0; j < group.member_size(); ++j)
             {
-                pb::Member member = group.member(j);
+                const pb::Member &member = group.member(j);
                 if (member.has_signal())
                 {
-                    pb::Signal remoteSignal = member.signal();
+                    const pb::Signal &remoteSignal = member.signal();
                     QString name = QString::fromStdString(remoteSignal.name());
                     int dotIndex = name.indexOf(".");
                     if (dotIndex != -1) // strip comp prefix
@@ -286,26 +317,33 @@ void QHalGroup::halgroupMessageReceived(const QList<QByteArray> &messageList)
                     }
                     localSignal->setHandle(remoteSignal.handle());
                     m_signalsByHandle.insert(remoteSignal.handle(), localSignal);
-                    signalUpdate(remoteSignal, localSignal);
+                    QHalTraceRecorder::recordName(QHalTraceSignalUpdate, m_traceSource, remoteSignal.handle(), m_name + "." + name);
+                    changed |= signalUpdate(remoteSignal, localSignal);
                 }
             }
 
+            if (changed)    // once per group, before the state changes
+            {
+                emit valuesChanged(m_values);
+            }
+
             if (m_halgroupSocketState != Up) // will be executed only once
             {
                 m_halgroupSocketState = Up;
                 updateState(Connected);
             }
         }
+        m_signalTable.build(m_signalsByHandle);
 
-        if (m_rx.has_pparams())
+        if (rx.has_pparams())
         {
-            pb::ProtocolParameters pparams = m_rx.pparams();
+            const pb::ProtocolParameters &pparams = rx.pparams();
             startHalgroupHeartbeat(pparams.keepalive_timer() * 2); // wait double the time of the hearbeat interval
         }
 
         return;
     }
-    else if (m_rx.type() == pb::MT_PING)
+    else if (rx.type() == pb::MT_PING)
     {
         if (m_halgroupSocketState == Up)
         {
@@ -320,13 +358,13 @@ void QHalGroup::halgroupMessageReceived(const QList<QByteArray> &messageList)
 
         return;
     }
-    else if (m_rx.type() == pb::MT_HALGROUP_ERROR) // error
+    else if (rx.type() == pb::MT_HALGROUP_ERROR) // error
     {
         QString errorString;
 
-        for (int i = 0; i < m_rx.note_size(); ++i)
+        for (int i = 0; i < rx.note_size(); ++i)
         {
-            errorString.append(QString::fromStdString(m_rx.note(i)) + "\n");
+            errorString.append(QString::fromStdString(rx.note(i)) + "\n");
         }
 
         m_halgroupSocketState = Down;
@@ -340,7 +378,7 @@ void QHalGroup::halgroupMessageReceived(const QList<QByteArray> &messageList)
     }
 
 #ifdef QT_DEBUG
-    gpb::TextFormat::PrintToString(m_rx, &s);
+    gpb::TextFormat::PrintToString(rx, &s);
     DEBUG_TAG(1, m_name, "halgroup_update: unknown message type: " << QString::fromStdString(s))
 #endif
 }
@@ -362,18 +400,15 @@ void QHalGroup::halgroupHeartbeatTimerTick()
 #endif
 }
 
-/** Scans all children of the container item for signals and adds them to a map */
+/** Adds the registered signals inside the container item to a map */
 void QHalGroup::addSignals()
 {
-    QList<QHalSignal*> halSignals;
-
     if (m_containerItem == NULL)
     {
         return;
     }
 
-    halSignals = recurseObjects(m_containerItem->children());
-    foreach (QHalSignal *signal, halSignals)
+    foreach (QHalSignal *signal, QHalObjectRegistry<QHalSignal>::find(m_containerItem))
     {
         if (signal->name().isEmpty() || (signal->enabled() == false))   // ignore signals with empty name or disabled
         {
@@ -390,6 +425,7 @@ void QHalGroup::addSignals()
 void QHalGroup::removeSignals()
 {
     m_signalsByHandle.clear();
+    m_signalTable.clear();
     m_signalsByName.clear();
 
     qDeleteAll(m_localSignals.begin(), m_localSignals.end());
@@ -416,12 +452,9 @@ void QHalGroup::unsyncSignals()
 /** Connects the 0MQ sockets */
 bool QHalGroup::connectSockets()
 {
-    m_context = new PollingZMQContext(this, 1);
-    connect(m_context, SIGNAL(pollError(int,QString)),
+    m_halgroupSocket = TransportManager::instance()->createSocket(ZMQSocket::TYP_SUB, QString("halgroup:%1").arg(m_name), this);
+    connect(m_halgroupSocket, SIGNAL(receiveError(int,QString)),
             this, SLOT(pollError(int,QString)));
-    m_context->start();
-
-    m_halgroupSocket = m_context->createSocket(ZMQSocket::TYP_SUB, this);
     m_halgroupSocket->setLinger(0);
 
     try {
@@ -434,8 +467,10 @@ bool QHalGroup::connectSockets()
         return false;
     }
 
-    connect(m_halgroupSocket, SIGNAL(messageReceived(QList<QByteArray>)),
-            this, SLOT(halgroupMessageReceived(QList<QByteArray>)));
+    m_halgroupDecoder = new MessageDecoder();
+    connect(m_halgroupDecoder, SIGNAL(messageDecoded(QByteArray,ContainerPointer)),
+            this, SLOT(halgroupMessageDecoded(QByteArray,ContainerPointer)));
+    TransportManager::instance()->attachDecoder(m_halgroupSocket, m_halgroupDecoder);
 
 #ifdef QT_DEBUG
     DEBUG_TAG(1, m_name, "socket connected" << m_halgroupUri)
@@ -454,13 +489,7 @@ void QHalGroup::disconnectSockets()
         m_halgroupSocket->close();
         m_halgroupSocket->deleteLater();
         m_halgroupSocket = NULL;
-    }
-
-    if (m_context != NULL)
-    {
-        m_context->stop();
-        m_context->deleteLater();
-        m_context = NULL;
+        m_halgroupDecoder = NULL; // deleted with the socket
     }
 }
 
@@ -28,7 +28,9 @@
 #include <QTimer>
 #include <QJsonObject>
 #include "qhalsignal.h"
+#include "qhalhandletable.h"
 #include <nzmqt/nzmqt.hpp>
+#include <transportmanager.h>
 #include <google/protobuf/text_format.h>
 #include <machinetalk/protobuf/message.pb.h>
 
@@ -55,6 +57,7 @@ class QHalGroup : public AbstractServiceImplementation
 
 public:
     explicit QHalGroup(QObject *parent = 0);
+    ~QHalGroup();
 
     enum SocketState {
         Down = 1,
@@ -134,13 +137,7 @@ public slots:
         }
     }
 
-    void setContainerItem(QObject * arg)
-    {
-        if (m_containerItem != arg) {
-            m_containerItem = arg;
-            emit containerItemChanged(arg);
-        }
-    }
+    void setContainerItem(QObject * arg);
 
 private:
     QString     m_halgroupUri;
@@ -153,17 +150,17 @@ private:
     QObject     *m_containerItem;
     QJsonObject m_values;
 
-    PollingZMQContext *m_context;
-    ZMQSocket   *m_halgroupSocket;
+    ThreadedZMQSocket   *m_halgroupSocket;
+    MessageDecoder      *m_halgroupDecoder;
     QTimer      *m_halgroupHeartbeatTimer;
+    quint16     m_traceSource;
     // more efficient to reuse a protobuf Message
-    pb::Container   m_rx;
     pb::Container   m_tx;
     QMap<QString, QHalSignal*> m_signalsByName;
     QHash<int, QHalSignal*>    m_signalsByHandle;
+    QHalHandleTable<QHalSignal> m_signalTable;
     QList<QHalSignal*>         m_localSignals;
 
-    QList<QHalSignal*> recurseObjects(const QObjectList &list) const;
     void start();
     void stop();
     void cleanup();
@@ -175,9 +172,9 @@ private:
     void updateError(ConnectionError error, const QString &errorString);
 
 private slots:
-    void signalUpdate(const pb::Signal &remoteSignal, QHalSignal *localSignal);
+    bool signalUpdate(const pb::Signal &remoteSignal, QHalSignal *localSignal);
 
-    void halgroupMessageReceived(const QList<QByteArray> &messageList);
+    void halgroupMessageDecoded(const QByteArray &topic, const ContainerPointer &container);
     void pollError(int errorNum, const QString &errorMsg);
     void halgroupHeartbeatTimerTick();
 
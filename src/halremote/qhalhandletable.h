@@ -0,0 +1,94 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#ifndef QHALHANDLETABLE_H
+#define QHALHANDLETABLE_H
+
+#include <QHash>
+#include <QVector>
+
+/** Maps the handles of remote HAL objects to the local objects.
+ *  The handles are assigned by the remote side and are usually close
+ *  to each other, so they are looked up in a dense table indexed
+ *  by the handle offset. Sparse handles fall back to a hash.
+ **/
+template <class T>
+class QHalHandleTable
+{
+public:
+    QHalHandleTable() :
+        m_base(0)
+    {
+    }
+
+    /** Builds the table from the handle hash after a full update */
+    void build(const QHash<int, T*> &objects)
+    {
+        clear();
+
+        if (objects.isEmpty()) {
+            return;
+        }
+
+        qint64 min = objects.constBegin().key();
+        qint64 max = min;
+        for (typename QHash<int, T*>::const_iterator it = objects.constBegin(); it != objects.constEnd(); ++it) {
+            min = qMin(min, (qint64)it.key());
+            max = qMax(max, (qint64)it.key());
+        }
+
+        if ((max - min + 1) > (objects.size() * 4 + 64)) { // too sparse
+            m_sparse = objects;
+            return;
+        }
+
+        m_base = min;
+        m_table.fill(NULL, (int)(max - min + 1));
+        for (typename QHash<int, T*>::const_iterator it = objects.constBegin(); it != objects.constEnd(); ++it) {
+            m_table[(int)(it.key() - m_base)] = it.value();
+        }
+    }
+
+    void clear()
+    {
+        m_base = 0;
+        m_table.clear();
+        m_sparse.clear();
+    }
+
+    T *value(int handle) const
+    {
+        quint64 index = (quint64)((qint64)handle - m_base);
+
+        if (index < (quint64)m_table.size()) {
+            return m_table.at((int)index);
+        }
+
+        return m_sparse.value(handle, NULL);
+    }
+
+private:
+    qint64 m_base;
+    QVector<T*> m_table;
+    QHash<int, T*> m_sparse;
+};
+
+#endif // QHALHANDLETABLE_H
@@ -0,0 +1,140 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#ifndef QHALOBJECTREGISTRY_H
+#define QHALOBJECTREGISTRY_H
+
+#include <QObject>
+#include <QHash>
+#include <QMap>
+#include <QList>
+
+/** Keeps track of all pins or signals of the process.
+ *  The objects register themselves on construction, so the remote
+ *  components can find their objects without walking the whole
+ *  QObject tree of their container item. Only used from the GUI thread.
+ *
+ *  The objects are indexed by their nearest registered container the
+ *  first time they are looked up, find only returns the objects of one
+ *  container. Adding or removing a container indexes all objects again.
+ *  Objects are returned in the order they were registered.
+ **/
+template <class T>
+class QHalObjectRegistry
+{
+public:
+    static void add(T *object)
+    {
+        Registry &r = registry();
+        quint64 sequence = r.nextSequence++;
+        r.sequences.insert(object, sequence);
+        r.objects.insert(sequence, object);
+        r.unindexed.insert(sequence, object);
+    }
+
+    static void remove(T *object)
+    {
+        Registry &r = registry();
+        quint64 sequence = r.sequences.take(object);
+        r.objects.remove(sequence);
+        r.unindexed.remove(sequence);
+
+        typename QHash<T*, const QObject*>::iterator owner = r.owners.find(object);
+        if (owner != r.owners.end())
+        {
+            r.index[owner.value()].remove(sequence);
+            r.owners.erase(owner);
+        }
+    }
+
+    static QList<T*> all()
+    {
+        return registry().objects.values();
+    }
+
+    /** Registers a container, objects belong to their nearest container */
+    static void addContainer(const QObject *container)
+    {
+        Registry &r = registry();
+        r.containers[container]++;
+        invalidate();
+    }
+
+    static void removeContainer(const QObject *container)
+    {
+        Registry &r = registry();
+        if (--r.containers[container] <= 0) {
+            r.containers.remove(container);
+        }
+        invalidate();
+    }
+
+    /** Returns the registered objects whose nearest container is container */
+    static QList<T*> find(const QObject *container)
+    {
+        Registry &r = registry();
+
+        if (!r.unindexed.isEmpty())
+        {
+            foreach (T *object, r.unindexed)
+            {
+                const QObject *owner = object->parent();
+                while ((owner != NULL) && !r.containers.contains(owner)) {
+                    owner = owner->parent();
+                }
+                r.owners.insert(object, owner);
+                r.index[owner].insert(r.sequences.value(object), object);
+            }
+            r.unindexed.clear();
+        }
+
+        return r.index.value(container).values();
+    }
+
+private:
+    struct Registry {
+        Registry() : nextSequence(0) {}
+
+        quint64 nextSequence;
+        QHash<T*, quint64> sequences;
+        QMap<quint64, T*> objects;
+        QMap<quint64, T*> unindexed;
+        QHash<const QObject*, int> containers;
+        QHash<const QObject*, QMap<quint64, T*> > index;    // objects by nearest container, NULL if none
+        QHash<T*, const QObject*> owners;
+    };
+
+    static Registry &registry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    static void invalidate()
+    {
+        Registry &r = registry();
+        r.index.clear();
+        r.owners.clear();
+        r.unindexed = r.objects;
+    }
+};
+
+#endif // QHALOBJECTREGISTRY_H
@@ -20,6 +20,11 @@
 **
 ****************************************************************************/
 #include "qhalpin.h"
+#include "qhalobjectregistry.h"
+#include <QDateTime>
+#include <QMetaMethod>
+
+static const int settleInterval = 100;  // ms without changes until a value within the deadband is sent anyway
 
 /*!
     \qmltype HalPin
@@ -122,6 +127,48 @@
     to \c true when the echo from the \l HalRemoteComponent is received.
 */
 
+/*! \qmlproperty real HalPin::deadband
+
+    This property holds the absolute deadband of a \c Float pin. Value
+    changes smaller than the deadband compared to the last value sent to
+    the remote pin are held back, the latest value is sent once the value
+    did not change for 100 ms so the remote pin always ends up with the
+    final value.
+
+    The default value is \c{0.0}.
+*/
+
+/*! \qmlproperty real HalPin::relativeDeadband
+
+    This property holds the deadband of a \c Float pin relative to the
+    last value sent to the remote pin, e.g. \c{0.01} holds back changes
+    smaller than 1%. Held back changes are sent like with \l deadband.
+
+    The default value is \c{0.0}.
+*/
+
+/*! \qmlproperty real HalPin::maxRate
+
+    This property holds the maximum number of value changes per second
+    sent to the remote pin. Changes in between are held back, the latest
+    value is sent when the interval has passed. Set this property to
+    \c{0} to disable the limit.
+
+    The default value is \c{0.0}.
+*/
+
+/*! \qmlproperty int HalPin::sentUpdates
+
+    This property holds the number of local value changes passed on to
+    the \l HalRemoteComponent.
+*/
+
+/*! \qmlproperty int HalPin::suppressedUpdates
+
+    This property holds the number of local value changes held back by
+    \l deadband, \l relativeDeadband or \l maxRate.
+*/
+
 QHalPin::QHalPin(QObject *parent) :
     QObject(parent),
     m_name("default"),
@@ -131,8 +178,21 @@ QHalPin::QHalPin(QObject *parent) :
     m_syncValue(false),
     m_handle(0),
     m_enabled(true),
-    m_synced(false)
+    m_synced(false),
+    m_deadband(0.0),
+    m_relativeDeadband(0.0),
+    m_maxRate(0.0),
+    m_sentUpdates(0),
+    m_suppressedUpdates(0),
+    m_submitted(false),
+    m_submitTimer(NULL)
 {
+    QHalObjectRegistry<QHalPin>::add(this);
+}
+
+QHalPin::~QHalPin()
+{
+    QHalObjectRegistry<QHalPin>::remove(this);
 }
 
 void QHalPin::setType(QHalPin::ValueType arg)
@@ -141,21 +201,10 @@ void QHalPin::setType(QHalPin::ValueType arg)
         m_type = arg;
         emit typeChanged(arg);
 
-        switch (m_type) {
-        case Bit:
-            m_value = m_value.toBool();
-            break;
-        case Float:
-            m_value = m_value.toDouble();
-            break;
-        case S32:
-            m_value = m_value.toInt();
-            break;
-        case U32:
-            m_value = m_value.toUInt();
-            break;
-        }
-        emit valueChanged(m_value);
+        m_value = m_value.converted((pb::ValueType)m_type);
+        m_syncValue = m_syncValue.converted((pb::ValueType)m_type);
+        m_submittedValue = m_submittedValue.converted((pb::ValueType)m_type);
+        emitValueChanged();
     }
 }
 
@@ -177,14 +226,44 @@ void QHalPin::setDirection(QHalPin::HalPinDirection arg)
 
 void QHalPin::setValue(QVariant arg, bool synced)
 {
-    if ((m_value != arg) || (m_value.type() != arg.type())) {
-        m_value = arg;
-        emit valueChanged(arg);
+    setHalValue(QHalValue::fromVariant((pb::ValueType)m_type, arg), synced);
+}
+
+/** Sets the value without going through a QVariant,
+ *  the value is converted to the type of the pin. timestamp is
+ *  the time the value was received in ms since epoch, 0 for now.
+ **/
+void QHalPin::setHalValue(const QHalValue &arg, bool synced, qint64 timestamp)
+{
+    QHalValue value = arg.converted((pb::ValueType)m_type);
+
+    if (synced && isSubmitPending() && (value == m_submittedValue)) {
+        // echo of the value submitted before, the newer local value is still sent
+        m_syncValue = value;
+        if (m_synced) {
+            m_synced = false;
+            emit syncedChanged(false);
+        }
+        return;
+    }
+
+    if (m_value != value) {
+        m_value = value;
+        emitValueChanged(timestamp);
+
+        if (synced == false) {
+            submitValue();
+        }
     }
 
     if (synced == true) {
-        m_syncValue = arg;  // save the sync point
-    } else if (arg == m_syncValue) {
+        m_syncValue = value;  // save the sync point
+        m_submittedValue = value;
+        m_submitted = true;
+        if (m_submitTimer != NULL) {
+            m_submitTimer->stop();
+        }
+    } else if (value == m_syncValue) {
         synced = true;  // if value is same as sync point synced is always true
     }
 
@@ -217,3 +296,149 @@ void QHalPin::setSynced(bool arg)
         emit syncedChanged(arg);
     }
 }
+
+void QHalPin::setDeadband(double arg)
+{
+    if (m_deadband != arg) {
+        m_deadband = arg;
+        emit deadbandChanged(arg);
+    }
+}
+
+void QHalPin::setRelativeDeadband(double arg)
+{
+    if (m_relativeDeadband != arg) {
+        m_relativeDeadband = arg;
+        emit relativeDeadbandChanged(arg);
+    }
+}
+
+void QHalPin::setMaxRate(double arg)
+{
+    if (m_maxRate != arg) {
+        m_maxRate = arg;
+        emit maxRateChanged(arg);
+    }
+}
+
+void QHalPin::resetUpdateCounters()
+{
+    if (m_sentUpdates != 0) {
+        m_sentUpdates = 0;
+        emit sentUpdatesChanged(m_sentUpdates);
+    }
+
+    if (m_suppressedUpdates != 0) {
+        m_suppressedUpdates = 0;
+        emit suppressedUpdatesChanged(m_suppressedUpdates);
+    }
+}
+
+/** Emits the typed change signal of the pin type and valueChanged for QML.
+ *  valueSampled carries the value with the time it was received, so
+ *  samples are not skewed by the time the event loop needs to deliver them.
+ **/
+void QHalPin::emitValueChanged(qint64 timestamp)
+{
+    double sample = 0.0;
+
+    switch (m_type) {
+    case Bit:
+        emit bitValueChanged(m_value.toBit());
+        sample = m_value.toBit() ? 1.0 : 0.0;
+        break;
+    case Float:
+        emit floatValueChanged(m_value.toFloat());
+        sample = m_value.toFloat();
+        break;
+    case S32:
+        emit s32ValueChanged(m_value.toS32());
+        sample = m_value.toS32();
+        break;
+    case U32:
+        emit u32ValueChanged(m_value.toU32());
+        sample = m_value.toU32();
+        break;
+    }
+    emit valueChanged(m_value.toVariant());
+
+    if (isSignalConnected(QMetaMethod::fromSignal(&QHalPin::valueSampled))) {
+        if (timestamp == 0) {
+            timestamp = QDateTime::currentMSecsSinceEpoch();
+        }
+        emit valueSampled(sample, (double)timestamp);
+    }
+}
+
+/** Passes a local value change on to the remote component
+ *  unless it is filtered by the deadband or the rate limit.
+ *  A filtered value is sent later, so the remote pin always
+ *  ends up with the final value. force skips the deadband.
+ **/
+void QHalPin::submitValue(bool force)
+{
+    if (!force && (m_type == Float) && m_submitted) {
+        double last = m_submittedValue.toFloat();
+        double delta = qAbs(m_value.toFloat() - last);
+
+        if ((delta < m_deadband) || (delta < (m_relativeDeadband * qAbs(last)))) {
+            scheduleSubmit(settleInterval, true);  // a jittering value is sent once it settles
+            m_suppressedUpdates++;
+            emit suppressedUpdatesChanged(m_suppressedUpdates);
+            return;
+        }
+    }
+
+    if ((m_maxRate > 0.0) && m_lastSubmit.isValid()) {
+        int remaining = qRound(1000.0 / m_maxRate) - (int)m_lastSubmit.elapsed();
+
+        if (remaining > 0) {
+            scheduleSubmit(remaining, false);
+            m_suppressedUpdates++;
+            emit suppressedUpdatesChanged(m_suppressedUpdates);
+            return;
+        }
+    }
+
+    if (m_submitTimer != NULL) {
+        m_submitTimer->stop();
+    }
+
+    m_submittedValue = m_value;
+    m_submitted = true;
+    m_lastSubmit.start();
+    m_sentUpdates++;
+    emit sentUpdatesChanged(m_sentUpdates);
+    emit valueSubmitted(m_value.toVariant());
+}
+
+/** Starts the submit timer. If restart is false, a timer that
+ *  fires earlier already is kept running.
+ **/
+void QHalPin::scheduleSubmit(int delay, bool restart)
+{
+    if (m_submitTimer == NULL) {
+        m_submitTimer = new QTimer(this);
+        m_submitTimer->setSingleShot(true);
+        connect(m_submitTimer, SIGNAL(timeout()),
+                this, SLOT(submitPendingValue()));
+    }
+
+    if (restart || !m_submitTimer->isActive() || (m_submitTimer->remainingTime() > delay)) {
+        m_submitTimer->start(delay);
+    }
+}
+
+/** Returns true if a local value is held back to be sent later */
+bool QHalPin::isSubmitPending() const
+{
+    return (m_submitTimer != NULL) && m_submitTimer->isActive() && (m_value != m_submittedValue);
+}
+
+/** Sends the value held back by the deadband or the rate limit */
+void QHalPin::submitPendingValue()
+{
+    if (m_value != m_submittedValue) {
+        submitValue(true);
+    }
+}
@@ -24,6 +24,9 @@
 
 #include <QObject>
 #include <QVariant>
+#include <QTimer>
+#include <QElapsedTimer>
+#include "qhalvalue.h"
 #include <machinetalk/protobuf/message.pb.h>
 
 class QHalPin : public QObject
@@ -36,11 +39,17 @@ class QHalPin : public QObject
     Q_PROPERTY(int handle READ handle NOTIFY handleChanged)
     Q_PROPERTY(bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged)
     Q_PROPERTY(bool synced READ synced NOTIFY syncedChanged)
+    Q_PROPERTY(double deadband READ deadband WRITE setDeadband NOTIFY deadbandChanged)
+    Q_PROPERTY(double relativeDeadband READ relativeDeadband WRITE setRelativeDeadband NOTIFY relativeDeadbandChanged)
+    Q_PROPERTY(double maxRate READ maxRate WRITE setMaxRate NOTIFY maxRateChanged)
+    Q_PROPERTY(int sentUpdates READ sentUpdates NOTIFY sentUpdatesChanged)
+    Q_PROPERTY(int suppressedUpdates READ suppressedUpdates NOTIFY suppressedUpdatesChanged)
     Q_ENUMS(ValueType)
     Q_ENUMS(HalPinDirection)
 
 public:
     explicit QHalPin(QObject *parent = 0);
+    ~QHalPin();
 
     enum ValueType {
         Bit = pb::HAL_BIT,
@@ -71,10 +80,35 @@ public:
     }
 
     QVariant value() const
+    {
+        return m_value.toVariant();
+    }
+
+    QHalValue halValue() const
     {
         return m_value;
     }
 
+    bool bitValue() const
+    {
+        return m_value.toBit();
+    }
+
+    double floatValue() const
+    {
+        return m_value.toFloat();
+    }
+
+    qint32 s32Value() const
+    {
+        return m_value.toS32();
+    }
+
+    quint32 u32Value() const
+    {
+        return m_value.toU32();
+    }
+
     int handle() const
     {
         return m_handle;
@@ -90,15 +124,53 @@ public:
         return m_synced;
     }
 
+    double deadband() const
+    {
+        return m_deadband;
+    }
+
+    double relativeDeadband() const
+    {
+        return m_relativeDeadband;
+    }
+
+    double maxRate() const
+    {
+        return m_maxRate;
+    }
+
+    int sentUpdates() const
+    {
+        return m_sentUpdates;
+    }
+
+    int suppressedUpdates() const
+    {
+        return m_suppressedUpdates;
+    }
+
+    Q_INVOKABLE void resetUpdateCounters();
+
 signals:
 
     void nameChanged(QString arg);
     void typeChanged(ValueType arg);
     void directionChanged(HalPinDirection arg);
     void valueChanged(QVariant arg);
+    void bitValueChanged(bool arg);
+    void floatValueChanged(double arg);
+    void s32ValueChanged(qint32 arg);
+    void u32ValueChanged(quint32 arg);
     void handleChanged(int arg);
     void enabledChanged(bool arg);
     void syncedChanged(bool arg);
+    void deadbandChanged(double arg);
+    void relativeDeadbandChanged(double arg);
+    void maxRateChanged(double arg);
+    void sentUpdatesChanged(int arg);
+    void suppressedUpdatesChanged(int arg);
+    void valueSubmitted(QVariant arg);
+    void valueSampled(double value, double timestamp);
 
 public slots:
 
@@ -106,19 +178,40 @@ void setType(ValueType arg);
 void setName(QString arg);
 void setDirection(HalPinDirection arg);
 void setValue(QVariant arg, bool synced = false);
+void setHalValue(const QHalValue &arg, bool synced = false, qint64 timestamp = 0);
 void setHandle(int arg);
 void setEnabled(bool arg);
 void setSynced(bool arg);
+void setDeadband(double arg);
+void setRelativeDeadband(double arg);
+void setMaxRate(double arg);
 
 private:
     QString         m_name;
     ValueType       m_type;
     HalPinDirection m_direction;
-    QVariant        m_value;
-    QVariant        m_syncValue;
+    QHalValue       m_value;
+    QHalValue       m_syncValue;
     int             m_handle;
     bool            m_enabled;
     bool            m_synced;
+    double          m_deadband;
+    double          m_relativeDeadband;
+    double          m_maxRate;
+    int             m_sentUpdates;
+    int             m_suppressedUpdates;
+    QHalValue       m_submittedValue;
+    bool            m_submitted;
+    QElapsedTimer   m_lastSubmit;
+    QTimer         *m_submitTimer;  // sends the value held back by the deadband or the rate limit
+
+    void emitValueChanged(qint64 timestamp = 0);
+    void submitValue(bool force = false);
+    void scheduleSubmit(int delay, bool restart);
+    bool isSubmitPending() const;
+
+private slots:
+    void submitPendingValue();
 };
 
 
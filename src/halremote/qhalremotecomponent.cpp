@@ -21,6 +21,8 @@
 ****************************************************************************/
 #include "qhalremotecomponent.h"
 #include "debughelper.h"
+#include "qhalobjectregistry.h"
+#include "qhaltracerecorder.h"
 
 /*!
     \qmltype HalRemoteComponent
@@ -41,7 +43,8 @@
 
     The HalRemoteComponent scans the \l containerItem
     and its children for \l{HalPin}s when \l ready is set
-    to \c true.
+    to \c true. Pins inside the \l containerItem of a nested
+    HalRemoteComponent belong to the nested component only.
 
     The following example creates a HAL remote component
     \c myComponent with one pin \c myPin. The resulting
@@ -163,6 +166,26 @@
     The default value is \c{true}.
 */
 
+/*! \qmlproperty int HalRemoteComponent::transmitInterval
+
+    This property holds the minimum time between two pin change
+    messages in ms. Pin changes are collected in the meantime and
+    sent together in one message, only the latest value of a pin is
+    transmitted. With \c{0} the changes are still collected until
+    control returns to the event loop.
+
+    The default value is \c{0}.
+*/
+
+/*! \qmlproperty bool HalRemoteComponent::immediateBits
+
+    This property holds whether changes of bit pins are sent
+    immediately regardless of the \l transmitInterval, so that
+    button edges are not delayed.
+
+    The default value is \c{true}.
+*/
+
 /** Remote HAL Component implementation for use with C++ and QML */
 QHalRemoteComponent::QHalRemoteComponent(QObject *parent) :
     AbstractServiceImplementation(parent),
@@ -178,41 +201,50 @@ QHalRemoteComponent::QHalRemoteComponent(QObject *parent) :
     m_errorString(""),
     m_containerItem(this),
     m_create(true),
-    m_context(NULL),
-    m_halrcompSocket(NULL),
-    m_halrcmdSocket(NULL),
-    m_halrcmdHeartbeatTimer(new QTimer(this)),
+    m_transmitInterval(0),
+    m_immediateBits(true),
+    m_traceSource(QHalTraceRecorder::createSource()),
+    m_connection(NULL),
     m_halrcompHeartbeatTimer(new QTimer(this)),
-    m_halrcmdPingOutstanding(false)
+    m_transmitTimer(new QTimer(this))
 {
-    m_uuid = QUuid::createUuid();
+    m_transmitTimer->setSingleShot(true);
+    connect(m_transmitTimer, SIGNAL(timeout()),
+            this, SLOT(transmitPinChanges()));
 
-    connect(m_halrcmdHeartbeatTimer, SIGNAL(timeout()),
-            this, SLOT(halrcmdHeartbeatTimerTick()));
     connect(m_halrcompHeartbeatTimer, SIGNAL(timeout()),
             this, SLOT(halrcompHeartbeatTimerTick()));
+
+    QHalObjectRegistry<QHalPin>::addContainer(m_containerItem);
 }
 
-/** Scans all children of the container item for pins and adds them to a map */
-void QHalRemoteComponent::addPins()
+/** Detaches from the shared connection, the destructor of the
+ *  base class cannot reach cleanup of this class anymore */
+QHalRemoteComponent::~QHalRemoteComponent()
 {
-    QObjectList halObjects;
+    disconnectSockets();
 
+    if (m_containerItem != NULL) {
+        QHalObjectRegistry<QHalPin>::removeContainer(m_containerItem);
+    }
+}
+
+/** Adds the registered pins inside the container item to a map */
+void QHalRemoteComponent::addPins()
+{
     if (m_containerItem == NULL)
     {
         return;
     }
 
-    halObjects = recurseObjects(m_containerItem->children());
-    foreach (QObject *object, halObjects)
+    foreach (QHalPin *pin, QHalObjectRegistry<QHalPin>::find(m_containerItem))
     {
-        QHalPin *pin = static_cast<QHalPin *>(object);
         if (pin->name().isEmpty()  || (pin->enabled() == false))    // ignore pins with empty name and disabled pins
         {
             continue;
         }
         m_pinsByName[pin->name()] = pin;
-        connect(pin, SIGNAL(valueChanged(QVariant)),
+        connect(pin, SIGNAL(valueSubmitted(QVariant)),
                 this, SLOT(pinChange(QVariant)));
 #ifdef QT_DEBUG
         DEBUG_TAG(1, m_name, "pin added: " << pin->name())
@@ -225,11 +257,14 @@ void QHalRemoteComponent::removePins()
 {
     foreach (QHalPin *pin, m_pinsByName)
     {
-        disconnect(pin, SIGNAL(valueChanged(QVariant)),
+        disconnect(pin, SIGNAL(valueSubmitted(QVariant)),
                 this, SLOT(pinChange(QVariant)));
     }
 
+    m_transmitTimer->stop();
+    m_changedPins.clear();
     m_pinsByHandle.clear();
+    m_pinTable.clear();
     m_pinsByName.clear();
 }
 
@@ -243,79 +278,74 @@ void QHalRemoteComponent::unsyncPins()
     }
 }
 
-/** Connects the 0MQ sockets */
+/** Attaches to the connection shared by all components using the same uris */
 bool QHalRemoteComponent::connectSockets()
 {
-    m_context = new PollingZMQContext(this, 1);
-    connect(m_context, SIGNAL(pollError(int,QString)),
-            this, SLOT(pollError(int,QString)));
-    m_context->start();
-
-    m_halrcmdSocket = m_context->createSocket(ZMQSocket::TYP_DEALER, this);
-    m_halrcmdSocket->setLinger(0);
-    m_halrcmdSocket->setIdentity(QString("%1-%2").arg(m_name).arg(m_uuid.toString()).toLocal8Bit());
-
-
-    m_halrcompSocket = m_context->createSocket(ZMQSocket::TYP_SUB, this);
-    m_halrcompSocket->setLinger(0);
+    QString errorString;
 
-    try {
-        m_halrcmdSocket->connectTo(m_halrcmdUri);
-        m_halrcompSocket->connectTo(m_halrcompUri);
-    }
-    catch (const zmq::error_t &e) {
-        QString errorString;
-        errorString = QString("Error %1: ").arg(e.num()) + QString(e.what());
+    m_connection = QHalConnection::attach(this, &errorString);
+    if (m_connection == NULL)
+    {
         updateState(Error, SocketError, errorString);
         return false;
     }
 
-    connect(m_halrcompSocket, SIGNAL(messageReceived(QList<QByteArray>)),
-            this, SLOT(halrcompMessageReceived(QList<QByteArray>)));
-    connect(m_halrcmdSocket, SIGNAL(messageReceived(QList<QByteArray>)),
-            this, SLOT(halrcmdMessageReceived(QList<QByteArray>)));
-
 #ifdef QT_DEBUG
-    DEBUG_TAG(1, m_name, "sockets connected" << m_halrcompUri << m_halrcmdUri)
+    DEBUG_TAG(1, m_name, "attached to connection" << m_halrcompUri << m_halrcmdUri)
 #endif
 
     return true;
 }
 
-/** Disconnects the 0MQ sockets */
-void QHalRemoteComponent::disconnectSockets()
+/** The connection pings with the shortest period of its components */
+void QHalRemoteComponent::heartbeatPeriod(int arg)
 {
-    m_halrcmdSocketState = Down;
-    m_halrcompSocketState = Down;
+    if (m_heartbeatPeriod != arg) {
+        m_heartbeatPeriod = arg;
+        emit heartbeatPeriodChanged(arg);
 
-    if (m_halrcmdSocket != NULL)
-    {
-        m_halrcmdSocket->close();
-        m_halrcmdSocket->deleteLater();
-        m_halrcmdSocket = NULL;
+        if (m_connection != NULL) {
+            m_connection->updateHeartbeat();
+        }
     }
+}
 
-    if (m_halrcompSocket != NULL)
-    {
-        m_halrcompSocket->close();
-        m_halrcompSocket->deleteLater();
-        m_halrcompSocket = NULL;
+void QHalRemoteComponent::setContainerItem(QObject *arg)
+{
+    if (m_containerItem != arg) {
+        if (m_containerItem != NULL) {
+            QHalObjectRegistry<QHalPin>::removeContainer(m_containerItem);
+        }
+        m_containerItem = arg;
+        if (m_containerItem != NULL) {
+            QHalObjectRegistry<QHalPin>::addContainer(m_containerItem);
+        }
+        emit containerItemChanged(arg);
     }
+}
+
+/** Detaches from the shared connection */
+void QHalRemoteComponent::disconnectSockets()
+{
+    m_halrcmdSocketState = Down;
+    m_halrcompSocketState = Down;
 
-    if (m_context != NULL)
+    if (m_connection != NULL)
     {
-        m_context->stop();
-        m_context->deleteLater();
-        m_context = NULL;
+        m_connection->detach(this);
+        m_connection = NULL;
     }
 }
 
-/** Generates a Bind messages and sends it over the suitable 0MQ socket */
+/** Requests a bind, the connection batches the binds of all components */
 void QHalRemoteComponent::bind()
 {
-    pb::Component *component;
+    m_connection->bind(this);
+}
 
-    component = m_tx.add_comp();
+/** Fills the bind message part of the component */
+void QHalRemoteComponent::addBindComponent(pb::Component *component) const
+{
     component->set_name(m_name.toStdString());
     component->set_no_create(!m_create);
     foreach (QHalPin *pin, m_pinsByName)
@@ -326,46 +356,37 @@ void QHalRemoteComponent::bind()
         halPin->set_dir((pb::HalPinDirection)pin->direction());
         if (pin->type() == QHalPin::Float)
         {
-            halPin->set_halfloat(pin->value().toDouble());
+            halPin->set_halfloat(pin->floatValue());
         }
         else if (pin->type() == QHalPin::Bit)
         {
-            halPin->set_halbit(pin->value().toBool());
+            halPin->set_halbit(pin->bitValue());
         }
         else if (pin->type() == QHalPin::S32)
         {
-            halPin->set_hals32(pin->value().toInt());
+            halPin->set_hals32(pin->s32Value());
         }
         else if (pin->type() == QHalPin::U32)
         {
-            halPin->set_halu32(pin->value().toUInt());
+            halPin->set_halu32(pin->u32Value());
         }
     }
-
-#ifdef QT_DEBUG
-    std::string s;
-    gpb::TextFormat::PrintToString(m_tx, &s);
-    DEBUG_TAG(1, m_name, "bind")
-    DEBUG_TAG(3, m_name, QString::fromStdString(s))
-#endif
-
-    sendHalrcmdMessage(pb::MT_HALRCOMP_BIND);
 }
 
 void QHalRemoteComponent::subscribe()
 {
     m_halrcompSocketState = Trying;
-    m_halrcompSocket->subscribeTo(m_name.toLocal8Bit());
+    m_connection->subscribe(this);
 }
 
 void QHalRemoteComponent::unsubscribe()
 {
     m_halrcompSocketState = Down;
-    m_halrcompSocket->unsubscribeFrom(m_name.toLocal8Bit());
+    m_connection->unsubscribe(this);
 }
 
 /** Updates a local pin with the value of a remote pin */
-void QHalRemoteComponent::pinUpdate(const pb::Pin &remotePin, QHalPin *localPin)
+void QHalRemoteComponent::pinUpdate(const pb::Pin &remotePin, QHalPin *localPin, qint64 receiveTime)
 {
 #ifdef QT_DEBUG
     DEBUG_TAG(2, m_name,  "pin update" << localPin->name() << remotePin.halfloat() << remotePin.halbit() << remotePin.hals32() << remotePin.halu32())
@@ -373,28 +394,33 @@ void QHalRemoteComponent::pinUpdate(const pb::Pin &remotePin, QHalPin *localPin)
 
     if (remotePin.has_halfloat())
     {
-        localPin->setValue(QVariant(remotePin.halfloat()), true);
+        localPin->setHalValue(QHalValue(remotePin.halfloat()), true, receiveTime);
     }
     else if (remotePin.has_halbit())
     {
-        localPin->setValue(QVariant(remotePin.halbit()), true);
+        localPin->setHalValue(QHalValue(remotePin.halbit()), true, receiveTime);
     }
     else if (remotePin.has_hals32())
     {
-        localPin->setValue(QVariant(remotePin.hals32()), true);
+        localPin->setHalValue(QHalValue((qint32)remotePin.hals32()), true, receiveTime);
     }
     else if (remotePin.has_halu32())
     {
-        localPin->setValue(QVariant(remotePin.halu32()), true);
+        localPin->setHalValue(QHalValue((quint32)remotePin.halu32()), true, receiveTime);
     }
+    else
+    {
+        return;
+    }
+
+    QHalTraceRecorder::record(QHalTracePinUpdate, m_traceSource, localPin->handle(), localPin->halValue());
 }
 
-/** Updates a remote pin witht the value of a local pin */
+/** Queues the value of a local pin for transmission to the remote pin */
 void QHalRemoteComponent::pinChange(QVariant value)
 {
     Q_UNUSED(value)
     QHalPin *pin;
-    pb::Pin *halPin;
 
     if (m_connectionState != Connected) // only accept pin changes if we are connected
     {
@@ -412,35 +438,91 @@ void QHalRemoteComponent::pinChange(QVariant value)
     DEBUG_TAG(2, m_name,  "pin change" << pin->name() << pin->value())
 #endif
 
-    // This message MUST carry a Pin message for each pin which has
-    // changed value since the last message of this type.
-    // Each Pin message MUST carry the handle field.
-    // Each Pin message MAY carry the name field.
-    // Each Pin message MUST carry the type field
-    // Each Pin message MUST - depending on pin type - carry a halbit,
-    // halfloat, hals32, or halu32 field.
-    halPin = m_tx.add_pin();
+    if (!m_changedPins.contains(pin))   // the latest value is read on transmit
+    {
+        m_changedPins.append(pin);
+    }
 
-    halPin->set_handle(pin->handle());
-    halPin->set_type((pb::ValueType)pin->type());
-    if (pin->type() == QHalPin::Float)
+    if (m_immediateBits && (pin->type() == QHalPin::Bit))
     {
-        halPin->set_halfloat(pin->value().toDouble());
+        transmitPinChanges();
     }
-    else if (pin->type() == QHalPin::Bit)
+    else
     {
-        halPin->set_halbit(pin->value().toBool());
+        scheduleTransmit();
+    }
+}
+
+/** Starts the transmit timer so that at least transmitInterval
+ *  lies between two pin change messages */
+void QHalRemoteComponent::scheduleTransmit()
+{
+    int delay = 0;
+
+    if (m_transmitTimer->isActive())
+    {
+        return;
+    }
+
+    if ((m_transmitInterval > 0) && m_lastTransmit.isValid())
+    {
+        delay = qMax(m_transmitInterval - (int)m_lastTransmit.elapsed(), 0);
+    }
+
+    m_transmitTimer->start(delay);
+}
+
+/** Sends the changed pins in one set message */
+void QHalRemoteComponent::transmitPinChanges()
+{
+    m_transmitTimer->stop();
+
+    if (m_changedPins.isEmpty())
+    {
+        return;
     }
-    else if (pin->type() == QHalPin::S32)
+
+    if (m_connectionState != Connected) // pins are synced again on reconnect
     {
-        halPin->set_hals32(pin->value().toInt());
+        m_changedPins.clear();
+        return;
     }
-    else if (pin->type() == QHalPin::U32)
+
+    // This message MUST carry a Pin message for each pin which has
+    // changed value since the last message of this type.
+    // Each Pin message MUST carry the handle field.
+    // Each Pin message MAY carry the name field.
+    // Each Pin message MUST carry the type field
+    // Each Pin message MUST - depending on pin type - carry a halbit,
+    // halfloat, hals32, or halu32 field.
+    foreach (QHalPin *pin, m_changedPins)
     {
-        halPin->set_halu32(pin->value().toUInt());
+        pb::Pin *halPin = m_tx.add_pin();
+
+        halPin->set_handle(pin->handle());
+        halPin->set_type((pb::ValueType)pin->type());
+        if (pin->type() == QHalPin::Float)
+        {
+            halPin->set_halfloat(pin->floatValue());
+        }
+        else if (pin->type() == QHalPin::Bit)
+        {
+            halPin->set_halbit(pin->bitValue());
+        }
+        else if (pin->type() == QHalPin::S32)
+        {
+            halPin->set_hals32(pin->s32Value());
+        }
+        else if (pin->type() == QHalPin::U32)
+        {
+            halPin->set_halu32(pin->u32Value());
+        }
+        QHalTraceRecorder::record(QHalTracePinSet, m_traceSource, pin->handle(), pin->halValue());
     }
+    m_changedPins.clear();
 
     sendHalrcmdMessage(pb::MT_HALRCOMP_SET);
+    m_lastTransmit.start();
 }
 
 void QHalRemoteComponent::start()
@@ -451,12 +533,8 @@ void QHalRemoteComponent::start()
     m_halrcmdSocketState = Trying;
     updateState(Connecting);
 
-    if (connectSockets())
-    {
-        addPins();
-        startHalrcmdHeartbeat();
-        sendHalrcmdMessage(pb::MT_PING);
-    }
+    addPins();
+    connectSockets();   // the ping acknowledge of the connection triggers the bind
 }
 
 void QHalRemoteComponent::stop()
@@ -476,27 +554,10 @@ void QHalRemoteComponent::cleanup()
     {
         unsubscribe();
     }
-    stopHalrcmdHeartbeat();
     disconnectSockets();
     removePins();
 }
 
-void QHalRemoteComponent::startHalrcmdHeartbeat()
-{
-    m_halrcmdPingOutstanding = false;
-
-    if (m_heartbeatPeriod > 0)
-    {
-        m_halrcmdHeartbeatTimer->setInterval(m_heartbeatPeriod);
-        m_halrcmdHeartbeatTimer->start();
-    }
-}
-
-void QHalRemoteComponent::stopHalrcmdHeartbeat()
-{
-    m_halrcmdHeartbeatTimer->stop();
-}
-
 void QHalRemoteComponent::startHalrcompHeartbeat(int interval)
 {
     m_halrcompHeartbeatTimer->stop();
@@ -578,59 +639,79 @@ void QHalRemoteComponent::updateError(QHalRemoteComponent::ConnectionError error
     }
 }
 
-void QHalRemoteComponent::pollError(int errorNum, const QString &errorMsg)
+/** Called by the connection when the halrcmd service answered a ping */
+void QHalRemoteComponent::halrcmdPingAcknowledged()
 {
-    QString errorString;
-    errorString = QString("Error %1: ").arg(errorNum) + errorMsg;
-    updateState(Error, SocketError, errorString);
+    if (m_halrcmdSocketState == Trying)
+    {
+        updateState(Connecting);
+        bind();
+    }
 }
 
-/** Recurses through a list of objects */
-QObjectList QHalRemoteComponent::recurseObjects(const QObjectList &list)
+void QHalRemoteComponent::halrcmdTimeout()
 {
-    QObjectList halObjects;
+    m_halrcmdSocketState = Trying;
+    updateState(Timeout);
+}
 
-    foreach (QObject *object, list)
-    {
-        QHalPin *halPin;
-        halPin = qobject_cast<QHalPin *>(object);
-        if (halPin != NULL)
-        {
-            halObjects.append(object);
-        }
+void QHalRemoteComponent::halrcmdError(ConnectionError error, const QString &errorString)
+{
+    m_halrcmdSocketState = Down;
+    updateState(Error, error, errorString);
+}
 
-        if (object->children().size() > 0)
-        {
-            halObjects.append(recurseObjects(object->children()));
-        }
-    }
+void QHalRemoteComponent::socketError(const QString &errorString)
+{
+    updateState(Error, SocketError, errorString);
+}
 
-    return halObjects;
+void QHalRemoteComponent::bindConfirmed()
+{
+#ifdef QT_DEBUG
+    DEBUG_TAG(1, m_name,  "bind confirmed")
+#endif
+    m_halrcmdSocketState = Up;
+    unsubscribe();  // clear previous subscription
+    subscribe();    // trigger full update
 }
 
-/** Processes all message received on the update 0MQ socket */
-void QHalRemoteComponent::halrcompMessageReceived(QList<QByteArray> messageList)
+/** Called by the connection when a pin change was rejected.
+ *  The bind stays valid, so the error is reported without disconnecting.
+ **/
+void QHalRemoteComponent::pinChangeRejected(const QString &errorString)
 {
-    QByteArray topic;
+    if (m_errorString != errorString)
+    {
+        m_errorString = errorString;
+        emit errorStringChanged(m_errorString);
+    }
 
-    topic = messageList.at(0);
-    m_rx.ParseFromArray(messageList.at(1).data(), messageList.at(1).size());
+    if (m_error != PinChangeError)
+    {
+        m_error = PinChangeError;
+        emit errorChanged(m_error);
+    }
+}
 
+/** Processes the messages of the connection with the topic of the component */
+void QHalRemoteComponent::halrcompMessageReceived(const QByteArray &topic, const pb::Container &rx, qint64 receiveTime)
+{
 #ifdef QT_DEBUG
     std::string s;
-    gpb::TextFormat::PrintToString(m_rx, &s);
+    gpb::TextFormat::PrintToString(rx, &s);
     DEBUG_TAG(3, m_name, "status update" << topic << QString::fromStdString(s))
 #endif
 
-    if (m_rx.type() == pb::MT_HALRCOMP_INCREMENTAL_UPDATE) //incremental update
+    if (rx.type() == pb::MT_HALRCOMP_INCREMENTAL_UPDATE) //incremental update
     {
-        for (int i = 0; i < m_rx.pin_size(); ++i)
+        for (int i = 0; i < rx.pin_size(); ++i)
         {
-            pb::Pin remotePin = m_rx.pin(i);
-            QHalPin *localPin = m_pinsByHandle.value(remotePin.handle(), NULL);
+            const pb::Pin &remotePin = rx.pin(i);
+            QHalPin *localPin = m_pinTable.value(remotePin.handle());
             if (localPin != NULL) // in case we received a wrong pin handle
             {
-                pinUpdate(remotePin, localPin);
+                pinUpdate(remotePin, localPin, receiveTime);
             }
         }
 
@@ -638,18 +719,19 @@ void QHalRemoteComponent::halrcompMessageReceived(QList<QByteArray> messageList)
 
         return;
     }
-    else if (m_rx.type() == pb::MT_HALRCOMP_FULL_UPDATE)
+    else if (rx.type() == pb::MT_HALRCOMP_FULL_UPDATE)
     {
 #ifdef QT_DEBUG
         DEBUG_TAG(1, m_name, "full update")
 #endif
-        for (int i = 0; i < m_rx.comp_size(); ++i)
+        for (int i = 0; i < rx.comp_size(); ++i)
         {
-            pb::Component component = m_rx.comp(i);
+            const pb::Component &component = rx.comp(i);
             for (int j = 0; j < component.pin_size(); j++)
             {
-                pb::Pin remotePin = component.pin(j);
-                QString name = QString::fromStdString(remotePin.name());
+                const pb::Pin &remotePin = component.pin(j);
+                QString fullName = QString::fromStdString(remotePin.name());
+                QString name = fullName;
                 int dotIndex = name.indexOf(".");
                 if (dotIndex != -1)    // strip comp prefix
                 {
@@ -658,7 +740,8 @@ void QHalRemoteComponent::halrcompMessageReceived(QList<QByteArray> messageList)
                 QHalPin *localPin = m_pinsByName.value(name);
                 localPin->setHandle(remotePin.handle());
                 m_pinsByHandle.insert(remotePin.handle(), localPin);
-                pinUpdate(remotePin, localPin);
+                QHalTraceRecorder::recordName(QHalTracePinUpdate, m_traceSource, remotePin.handle(), fullName);
+                pinUpdate(remotePin, localPin, receiveTime);
             }
 
             if (m_halrcompSocketState != Up) // will be executed only once
@@ -667,16 +750,17 @@ void QHalRemoteComponent::halrcompMessageReceived(QList<QByteArray> messageList)
                 updateState(Connected);
             }
         }
+        m_pinTable.build(m_pinsByHandle);
 
-        if (m_rx.has_pparams())
+        if (rx.has_pparams())
         {
-            pb::ProtocolParameters pparams = m_rx.pparams();
+            const pb::ProtocolParameters &pparams = rx.pparams();
             startHalrcompHeartbeat(pparams.keepalive_timer() * 2);  // wait double the time of the hearbeat interval
         }
 
         return;
     }
-    else if (m_rx.type() == pb::MT_PING)
+    else if (rx.type() == pb::MT_PING)
     {
         if (m_halrcompSocketState == Up)
         {
@@ -691,13 +775,13 @@ void QHalRemoteComponent::halrcompMessageReceived(QList<QByteArray> messageList)
 
         return;
     }
-    else if (m_rx.type() == pb::MT_HALRCOMMAND_ERROR)
+    else if (rx.type() == pb::MT_HALRCOMMAND_ERROR)
     {
         QString errorString;
 
-        for (int i = 0; i < m_rx.note_size(); ++i)
+        for (int i = 0; i < rx.note_size(); ++i)
         {
-            errorString.append(QString::fromStdString(m_rx.note(i)) + "\n");
+            errorString.append(QString::fromStdString(rx.note(i)) + "\n");
         }
 
         m_halrcompSocketState = Down;
@@ -711,125 +795,19 @@ void QHalRemoteComponent::halrcompMessageReceived(QList<QByteArray> messageList)
     }
 
 #ifdef QT_DEBUG
-    gpb::TextFormat::PrintToString(m_rx, &s);
+    gpb::TextFormat::PrintToString(rx, &s);
     DEBUG_TAG(1, m_name, "status_update: unknown message type: " << QString::fromStdString(s))
 #endif
 }
 
-/** Processes all message received on the command 0MQ socket */
-void QHalRemoteComponent::halrcmdMessageReceived(QList<QByteArray> messageList)
-{
-    m_rx.ParseFromArray(messageList.at(0).data(), messageList.at(0).size());
-
-#ifdef QT_DEBUG
-    std::string s;
-    gpb::TextFormat::PrintToString(m_rx, &s);
-    DEBUG_TAG(3, m_name, "server message" << QString::fromStdString(s))
-#endif
-
-    if (m_rx.type() == pb::MT_PING_ACKNOWLEDGE)
-    {
-        m_halrcmdPingOutstanding = false;
-
-        if (m_halrcmdSocketState == Trying)
-        {
-            updateState(Connecting);
-            bind();
-        }
-
-#ifdef QT_DEBUG
-        DEBUG_TAG(2, m_name, "ping ack")
-#endif
-
-        return;
-    }
-    else if (m_rx.type() == pb::MT_HALRCOMP_BIND_CONFIRM)
-    {
-#ifdef QT_DEBUG
-        DEBUG_TAG(1, m_name,  "bind confirmed")
-#endif
-        m_halrcmdSocketState = Up;
-        unsubscribe();  // clear previous subscription
-        subscribe();    // trigger full update
-
-        return;
-    }
-    else if ((m_rx.type() == pb::MT_HALRCOMP_BIND_REJECT)
-             || (m_rx.type() == pb::MT_HALRCOMP_SET_REJECT))
-    {
-        QString errorString;
-
-        for (int i = 0; i < m_rx.note_size(); ++i)
-        {
-            errorString.append(QString::fromStdString(m_rx.note(i)) + "\n");
-        }
-
-        m_halrcmdSocketState = Down;
-
-        if (m_rx.type() == pb::MT_HALRCOMP_BIND_REJECT)
-        {
-            updateState(Error, BindError, errorString);
-        }
-        else
-        {
-            updateState(Error, PinChangeError, errorString);
-        }
-
-#ifdef QT_DEBUG
-        if (m_rx.type() == pb::MT_HALRCOMP_BIND_REJECT) {
-            DEBUG_TAG(1, m_name, "bind rejected" << errorString)
-        }
-        else {
-            DEBUG_TAG(1, m_name, "pin change rejected" << QString::fromStdString(m_rx.note(0)))
-        }
-#endif
-        return;
-    }
-    else
-    {
-#ifdef QT_DEBUG
-        DEBUG_TAG(1, m_name, "UNKNOWN server message type")
-#endif
-    }
-}
-
 void QHalRemoteComponent::sendHalrcmdMessage(pb::ContainerType type)
 {
-    if (m_halrcmdSocket == NULL) {  // disallow sending messages when not connected
-        return;
-    }
-
-    try {
-        m_tx.set_type(type);
-        m_halrcmdSocket->sendMessage(QByteArray(m_tx.SerializeAsString().c_str(), m_tx.ByteSize()));
+    if (m_connection == NULL) {  // disallow sending messages when not connected
         m_tx.Clear();
+        return;
     }
-    catch (const zmq::error_t &e) {
-        QString errorString;
-        errorString = QString("Error %1: ").arg(e.num()) + QString(e.what());
-        updateState(Error, SocketError, errorString);
-    }
-}
-
-void QHalRemoteComponent::halrcmdHeartbeatTimerTick()
-{
-    if (m_halrcmdPingOutstanding)
-    {
-        m_halrcmdSocketState = Trying;
-        updateState(Timeout);
-
-#ifdef QT_DEBUG
-        DEBUG_TAG(1, m_name, "halcmd timeout")
-#endif
-    }
-
-    sendHalrcmdMessage(pb::MT_PING);
 
-    m_halrcmdPingOutstanding = true;
-
-#ifdef QT_DEBUG
-    DEBUG_TAG(2, m_name, "ping")
-#endif
+    m_connection->sendHalrcmdMessage(type, m_tx, this);
 }
 
 void QHalRemoteComponent::halrcompHeartbeatTimerTick()
@@ -26,9 +26,12 @@
 #include <QCoreApplication>
 #include <QHash>
 #include <QTimer>
-#include <QUuid>
+#include <QElapsedTimer>
 #include "qhalpin.h"
+#include "qhalhandletable.h"
+#include "qhalconnection.h"
 #include <nzmqt/nzmqt.hpp>
+#include <transportmanager.h>
 #include <machinetalk/protobuf/message.pb.h>
 #include <google/protobuf/text_format.h>
 
@@ -43,6 +46,7 @@ using namespace nzmqt;
 class QHalRemoteComponent : public AbstractServiceImplementation
 {
     Q_OBJECT
+    friend class QHalConnection;
     Q_INTERFACES(QQmlParserStatus)
     Q_PROPERTY(QString halrcmdUri READ halrcmdUri WRITE setHalrcmdUri NOTIFY halrcmdUriChanged)
     Q_PROPERTY(QString halrcompUri READ halrcompUri WRITE setHalrcompUri NOTIFY halrcompUriChanged)
@@ -54,12 +58,15 @@ class QHalRemoteComponent : public AbstractServiceImplementation
     Q_PROPERTY(QString errorString READ errorString NOTIFY errorStringChanged)
     Q_PROPERTY(QObject *containerItem READ containerItem WRITE setContainerItem NOTIFY containerItemChanged)
     Q_PROPERTY(bool create READ create WRITE setCreate NOTIFY createChanged)
+    Q_PROPERTY(int transmitInterval READ transmitInterval WRITE setTransmitInterval NOTIFY transmitIntervalChanged)
+    Q_PROPERTY(bool immediateBits READ immediateBits WRITE setImmediateBits NOTIFY immediateBitsChanged)
     Q_ENUMS(SocketState)
     Q_ENUMS(State)
     Q_ENUMS(ConnectionError)
 
 public:
     explicit QHalRemoteComponent(QObject *parent = 0);
+    ~QHalRemoteComponent();
 
     enum SocketState {
         Down = 1,
@@ -133,6 +140,16 @@ public:
         return m_create;
     }
 
+    int transmitInterval() const
+    {
+        return m_transmitInterval;
+    }
+
+    bool immediateBits() const
+    {
+        return m_immediateBits;
+    }
+
 public slots:
     void pinChange(QVariant value);
 
@@ -163,21 +180,9 @@ public slots:
         }
     }
 
-    void heartbeatPeriod(int arg)
-    {
-        if (m_heartbeatPeriod != arg) {
-            m_heartbeatPeriod = arg;
-            emit heartbeatPeriodChanged(arg);
-        }
-    }
+    void heartbeatPeriod(int arg);
 
-    void setContainerItem(QObject *arg)
-    {
-        if (m_containerItem != arg) {
-            m_containerItem = arg;
-            emit containerItemChanged(arg);
-        }
-    }
+    void setContainerItem(QObject *arg);
 
     void setCreate(bool arg)
     {
@@ -188,6 +193,24 @@ public slots:
         emit createChanged(arg);
     }
 
+    void setTransmitInterval(int arg)
+    {
+        if (m_transmitInterval == arg)
+            return;
+
+        m_transmitInterval = arg;
+        emit transmitIntervalChanged(arg);
+    }
+
+    void setImmediateBits(bool arg)
+    {
+        if (m_immediateBits == arg)
+            return;
+
+        m_immediateBits = arg;
+        emit immediateBitsChanged(arg);
+    }
+
 private:
     QString     m_halrcmdUri;
     QString     m_halrcompUri;
@@ -201,27 +224,25 @@ private:
     QString     m_errorString;
     QObject     *m_containerItem;
     bool        m_create;
+    int         m_transmitInterval;
+    bool        m_immediateBits;
+    quint16     m_traceSource;
 
-    PollingZMQContext *m_context;
-    ZMQSocket  *m_halrcompSocket;
-    ZMQSocket  *m_halrcmdSocket;
-    QTimer     *m_halrcmdHeartbeatTimer;
+    QHalConnection *m_connection;
     QTimer     *m_halrcompHeartbeatTimer;
-    bool        m_halrcmdPingOutstanding;
-    QUuid       m_uuid;
     // more efficient to reuse a protobuf Message
-    pb::Container   m_rx;
     pb::Container   m_tx;
     QMap<QString, QHalPin*> m_pinsByName;
     QHash<int, QHalPin*>    m_pinsByHandle;
+    QHalHandleTable<QHalPin> m_pinTable;
+    QList<QHalPin*> m_changedPins;
+    QTimer     *m_transmitTimer;
+    QElapsedTimer   m_lastTransmit;
 
 
-    QObjectList recurseObjects(const QObjectList &list);
     void start();
     void stop();
     void cleanup();
-    void startHalrcmdHeartbeat();
-    void stopHalrcmdHeartbeat();
     void startHalrcompHeartbeat(int interval);
     void stopHalrcompHeartbeat();
     void refreshHalrcompHeartbeat();
@@ -229,14 +250,21 @@ private:
     void updateState(State state, ConnectionError error, QString errorString);
     void updateError(ConnectionError error, QString errorString);
     void sendHalrcmdMessage(pb::ContainerType type);
+    void scheduleTransmit();
+
+    // called by the connection
+    void halrcmdPingAcknowledged();
+    void halrcmdTimeout();
+    void halrcmdError(ConnectionError error, const QString &errorString);
+    void socketError(const QString &errorString);
+    void bindConfirmed();
+    void pinChangeRejected(const QString &errorString);
+    void addBindComponent(pb::Component *component) const;
+    void halrcompMessageReceived(const QByteArray &topic, const pb::Container &rx, qint64 receiveTime);
 
 private slots:
-    void pinUpdate(const pb::Pin &remotePin, QHalPin *localPin);
+    void pinUpdate(const pb::Pin &remotePin, QHalPin *localPin, qint64 receiveTime);
 
-    void halrcompMessageReceived(QList<QByteArray> messageList);
-    void halrcmdMessageReceived(QList<QByteArray> messageList);
-    void pollError(int errorNum, const QString& errorMsg);
-    void halrcmdHeartbeatTimerTick();
     void halrcompHeartbeatTimerTick();
 
     void addPins();
@@ -247,6 +275,7 @@ private slots:
     void bind();
     void subscribe();
     void unsubscribe();
+    void transmitPinChanges();
 
 signals:
     void halrcmdUriChanged(QString arg);
@@ -259,6 +288,8 @@ signals:
     void errorStringChanged(QString arg);
     void connectedChanged(bool arg);
     void createChanged(bool arg);
+    void transmitIntervalChanged(int arg);
+    void immediateBitsChanged(bool arg);
 };
 
 #endif // QCOMPONENT_H
@@ -21,6 +21,7 @@
 ****************************************************************************/
 
 #include "qhalsignal.h"
+#include "qhalobjectregistry.h"
 
 QHalSignal::QHalSignal(QObject *parent) :
     QObject(parent),
@@ -31,6 +32,12 @@ QHalSignal::QHalSignal(QObject *parent) :
     m_enabled(true),
     m_synced(false)
 {
+    QHalObjectRegistry<QHalSignal>::add(this);
+}
+
+QHalSignal::~QHalSignal()
+{
+    QHalObjectRegistry<QHalSignal>::remove(this);
 }
 
 void QHalSignal::setName(QString arg)
@@ -47,29 +54,25 @@ void QHalSignal::setType(QHalSignal::ValueType arg)
         m_type = arg;
         emit typeChanged(arg);
 
-        switch (m_type) {
-        case Bit:
-            m_value = m_value.toBool();
-            break;
-        case Float:
-            m_value = m_value.toDouble();
-            break;
-        case S32:
-            m_value = m_value.toInt();
-            break;
-        case U32:
-            m_value = m_value.toUInt();
-            break;
-        }
-        emit valueChanged(m_value);
+        m_value = m_value.converted((pb::ValueType)m_type);
+        emitValueChanged();
     }
 }
 
 void QHalSignal::setValue(QVariant arg)
 {
-    if ((m_value != arg) || (m_value.type() != arg.type())) {
-        m_value = arg;
-        emit valueChanged(arg);
+    setHalValue(QHalValue::fromVariant((pb::ValueType)m_type, arg));
+}
+
+/** Sets the value without going through a QVariant,
+ *  the value is converted to the type of the signal */
+void QHalSignal::setHalValue(const QHalValue &arg)
+{
+    QHalValue value = arg.converted((pb::ValueType)m_type);
+
+    if (m_value != value) {
+        m_value = value;
+        emitValueChanged();
     }
 }
 
@@ -96,3 +99,23 @@ void QHalSignal::setSynced(bool arg)
         emit syncedChanged(arg);
     }
 }
+
+/** Emits the typed change signal of the signal type and valueChanged for QML */
+void QHalSignal::emitValueChanged()
+{
+    switch (m_type) {
+    case Bit:
+        emit bitValueChanged(m_value.toBit());
+        break;
+    case Float:
+        emit floatValueChanged(m_value.toFloat());
+        break;
+    case S32:
+        emit s32ValueChanged(m_value.toS32());
+        break;
+    case U32:
+        emit u32ValueChanged(m_value.toU32());
+        break;
+    }
+    emit valueChanged(m_value.toVariant());
+}
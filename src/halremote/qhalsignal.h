@@ -25,6 +25,7 @@
 
 #include <QObject>
 #include <QVariant>
+#include "qhalvalue.h"
 #include <machinetalk/protobuf/message.pb.h>
 
 class QHalSignal : public QObject
@@ -40,6 +41,7 @@ class QHalSignal : public QObject
 
 public:
     explicit QHalSignal(QObject *parent = 0);
+    ~QHalSignal();
 
     enum ValueType {
         Bit = pb::HAL_BIT,
@@ -59,10 +61,35 @@ public:
     }
 
     QVariant value() const
+    {
+        return m_value.toVariant();
+    }
+
+    QHalValue halValue() const
     {
         return m_value;
     }
 
+    bool bitValue() const
+    {
+        return m_value.toBit();
+    }
+
+    double floatValue() const
+    {
+        return m_value.toFloat();
+    }
+
+    qint32 s32Value() const
+    {
+        return m_value.toS32();
+    }
+
+    quint32 u32Value() const
+    {
+        return m_value.toU32();
+    }
+
     int handle() const
     {
         return m_handle;
@@ -82,6 +109,7 @@ public slots:
     void setName(QString arg);
     void setType(ValueType arg);
     void setValue(QVariant arg);
+    void setHalValue(const QHalValue &arg);
     void setHandle(int arg);
     void setEnabled(bool arg);
     void setSynced(bool arg);
@@ -90,6 +118,10 @@ signals:
     void nameChanged(QString arg);
     void typeChanged(ValueType arg);
     void valueChanged(QVariant arg);
+    void bitValueChanged(bool arg);
+    void floatValueChanged(double arg);
+    void s32ValueChanged(qint32 arg);
+    void u32ValueChanged(quint32 arg);
     void handleChanged(int arg);
     void enabledChanged(bool arg);
     void syncedChanged(bool arg);
@@ -97,10 +129,12 @@ signals:
 private:
     QString m_name;
     ValueType m_type;
-    QVariant m_value;
+    QHalValue m_value;
     int m_handle;
     bool m_enabled;
     bool m_synced;
+
+    void emitValueChanged();
 };
 
 #endif // QHALSIGNAL_H
@@ -0,0 +1,89 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#ifndef QHALTRACEFORMAT_H
+#define QHALTRACEFORMAT_H
+
+#include <QtGlobal>
+
+/** File format of the HAL trace recorder.
+ *  A trace file is a header followed by a table of pin and signal names
+ *  and a ring of fixed size records. The records are written in place,
+ *  the oldest record is at recordsWritten % recordCapacity once the ring
+ *  has wrapped. A dump has the same layout with the records in order.
+ *  All values are stored in host byte order.
+ *  This header is shared with the haltrace2csv tool and must not depend
+ *  on anything but QtCore.
+ **/
+
+#define QHAL_TRACE_MAGIC    Q_UINT64_C(0x45434152544c4148)    // "HALTRACE"
+#define QHAL_TRACE_VERSION  2
+#define QHAL_TRACE_NAME_LENGTH  56
+
+enum QHalTraceKind {
+    QHalTracePinUpdate = 0,     // value received from a remote component
+    QHalTracePinSet = 1,        // value of a local pin sent to a remote component
+    QHalTraceSignalUpdate = 2   // value received from a HAL group
+};
+
+enum QHalTraceType {            // same numbers as pb::ValueType
+    QHalTraceBit = 1,
+    QHalTraceFloat = 2,
+    QHalTraceS32 = 3,
+    QHalTraceU32 = 4
+};
+
+struct QHalTraceHeader {
+    quint64 magic;
+    quint32 version;
+    quint32 headerSize;
+    quint32 nameSize;
+    quint32 recordSize;
+    quint32 nameCapacity;
+    quint32 namesWritten;
+    quint64 recordCapacity;
+    quint64 recordsWritten;
+    qint64 startTime;           // ms since epoch, reference of the record timestamps
+};
+
+struct QHalTraceName {
+    quint32 handle;
+    quint8 kind;                // QHalTracePinUpdate for pins, QHalTraceSignalUpdate for signals
+    quint8 reserved;
+    quint16 source;             // component or group, handles are only unique per Haltalk instance
+    char name[QHAL_TRACE_NAME_LENGTH];  // zero terminated, with the component or group name
+};
+
+struct QHalTraceRecord {
+    qint64 timestamp;           // ns since startTime
+    quint32 handle;
+    quint8 kind;
+    quint8 type;
+    quint16 source;
+    union {
+        double floating;
+        qint32 s32;
+        quint32 u32;
+        quint8 bit;
+    } value;
+};
+
+#endif // QHALTRACEFORMAT_H
@@ -0,0 +1,368 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#include "qhaltracerecorder.h"
+#include <QDir>
+#include <QDateTime>
+#include <cstring>
+
+/*!
+    \qmltype HalTraceRecorder
+    \instantiates QHalTraceRecorder
+    \inqmlmodule Machinekit.HalRemote
+    \brief Records HAL pin and signal values for post-mortem analysis.
+    \ingroup halremote
+
+    While the recorder is active every value received by a \l HalRemoteComponent
+    or \l HalGroup and every pin value sent to the remote component is written
+    into a preallocated, memory mapped ring file. The file always holds the last
+    \l recordCapacity values and survives a crash of the application.
+
+    Use \l dump to save a snapshot of the recorded values. The ring file and
+    the dumps can be converted to CSV with the \c haltrace2csv tool.
+
+    \qml
+    HalTraceRecorder {
+        id: traceRecorder
+        fileName: "/tmp/machine.haltrace"
+        active: true
+    }
+    \endqml
+*/
+
+/*! \qmlproperty string HalTraceRecorder::fileName
+
+    This property holds the name of the ring file.
+
+    The default value is \c{haltrace.bin} in the temporary directory.
+*/
+
+/*! \qmlproperty int HalTraceRecorder::recordCapacity
+
+    This property holds how many values the ring file can hold. Each value
+    takes 24 bytes. Changes take effect the next time the recorder is activated.
+
+    The default value is \c{1000000}.
+*/
+
+/*! \qmlproperty int HalTraceRecorder::nameCapacity
+
+    This property holds how many pin and signal names the ring file can hold.
+    Changes take effect the next time the recorder is activated.
+
+    The default value is \c{4096}.
+*/
+
+/*! \qmlproperty bool HalTraceRecorder::active
+
+    This property holds whether the recorder is recording. Only one recorder
+    is recording at a time, activating a recorder deactivates the previous one.
+    Activating a recorder starts a new ring file.
+
+    The default value is \c{false}.
+*/
+
+/*! \qmlproperty string HalTraceRecorder::errorString
+
+    This property holds a text describing the last error.
+*/
+
+QHalTraceRecorder *QHalTraceRecorder::m_current = NULL;
+quint16 QHalTraceRecorder::m_nextSource = 0;
+
+QHalTraceRecorder::QHalTraceRecorder(QObject *parent) :
+    QObject(parent),
+    QQmlParserStatus(),
+    m_fileName(QDir::temp().filePath("haltrace.bin")),
+    m_recordCapacity(1000000),
+    m_nameCapacity(4096),
+    m_active(false),
+    m_errorString(""),
+    m_componentCompleted(false),
+    m_mapping(NULL),
+    m_header(NULL),
+    m_names(NULL),
+    m_records(NULL),
+    m_nextRecord(0)
+{
+}
+
+QHalTraceRecorder::~QHalTraceRecorder()
+{
+    stop();
+}
+
+/** componentComplete is executed when the QML component is fully loaded */
+void QHalTraceRecorder::componentComplete()
+{
+    m_componentCompleted = true;
+
+    if (m_active && !start())  // the recorder was set to active before it was completed
+    {
+        m_active = false;
+        emit activeChanged(false);
+    }
+}
+
+void QHalTraceRecorder::setFileName(const QString &arg)
+{
+    if (m_fileName != arg) {
+        m_fileName = arg;
+        emit fileNameChanged(arg);
+    }
+}
+
+void QHalTraceRecorder::setRecordCapacity(int arg)
+{
+    if (m_recordCapacity != arg) {
+        m_recordCapacity = arg;
+        emit recordCapacityChanged(arg);
+    }
+}
+
+void QHalTraceRecorder::setNameCapacity(int arg)
+{
+    if (m_nameCapacity != arg) {
+        m_nameCapacity = arg;
+        emit nameCapacityChanged(arg);
+    }
+}
+
+void QHalTraceRecorder::setActive(bool arg)
+{
+    if (m_active == arg)
+    {
+        return;
+    }
+
+    if (m_componentCompleted)
+    {
+        if (arg)
+        {
+            if (!start())
+            {
+                return;
+            }
+        }
+        else
+        {
+            stop();
+        }
+    }
+
+    m_active = arg;
+    emit activeChanged(arg);
+}
+
+/*! \qmlmethod bool HalTraceRecorder::dump(string fileName)
+
+    Writes the recorded values in chronological order to \a fileName.
+    Returns \c false and sets \l errorString if the file could not be written.
+*/
+bool QHalTraceRecorder::dump(const QString &fileName)
+{
+    if (m_mapping == NULL)
+    {
+        updateError(tr("Recorder is not active"));
+        return false;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        updateError(file.errorString());
+        return false;
+    }
+
+    QHalTraceHeader header = *m_header;
+    quint64 count = qMin(header.recordsWritten, header.recordCapacity);
+    quint64 first = (header.recordsWritten > header.recordCapacity) ? m_nextRecord : 0;
+    header.recordCapacity = count;
+    header.recordsWritten = count;
+
+    bool ok = (file.write((const char*)&header, sizeof(header)) == (qint64)sizeof(header));
+    ok = ok && (file.write((const char*)m_names, sizeof(QHalTraceName) * header.nameCapacity)
+                == (qint64)(sizeof(QHalTraceName) * header.nameCapacity));
+    ok = ok && (file.write((const char*)&m_records[first], sizeof(QHalTraceRecord) * (count - first))
+                == (qint64)(sizeof(QHalTraceRecord) * (count - first)));
+    ok = ok && (file.write((const char*)m_records, sizeof(QHalTraceRecord) * first)
+                == (qint64)(sizeof(QHalTraceRecord) * first));
+
+    if (!ok)
+    {
+        updateError(file.errorString());
+        return false;
+    }
+
+    return true;
+}
+
+/** Creates and maps the ring file and makes this the active recorder */
+bool QHalTraceRecorder::start()
+{
+    if ((m_recordCapacity <= 0) || (m_nameCapacity < 0))
+    {
+        updateError(tr("Invalid capacity"));
+        return false;
+    }
+
+    qint64 size = sizeof(QHalTraceHeader)
+                  + (qint64)sizeof(QHalTraceName) * m_nameCapacity
+                  + (qint64)sizeof(QHalTraceRecord) * m_recordCapacity;
+
+    m_file.setFileName(m_fileName);
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Truncate)
+        || !m_file.resize(size)
+        || ((m_mapping = m_file.map(0, size)) == NULL))
+    {
+        updateError(m_file.errorString());
+        m_file.close();
+        return false;
+    }
+
+    memset(m_mapping, 0, size); // touches all pages, recording does not fault later
+    m_header = reinterpret_cast<QHalTraceHeader*>(m_mapping);
+    m_names = reinterpret_cast<QHalTraceName*>(m_mapping + sizeof(QHalTraceHeader));
+    m_records = reinterpret_cast<QHalTraceRecord*>(m_mapping + sizeof(QHalTraceHeader)
+                                                   + sizeof(QHalTraceName) * m_nameCapacity);
+    m_header->magic = QHAL_TRACE_MAGIC;
+    m_header->version = QHAL_TRACE_VERSION;
+    m_header->headerSize = sizeof(QHalTraceHeader);
+    m_header->nameSize = sizeof(QHalTraceName);
+    m_header->recordSize = sizeof(QHalTraceRecord);
+    m_header->nameCapacity = m_nameCapacity;
+    m_header->namesWritten = 0;
+    m_header->recordCapacity = m_recordCapacity;
+    m_header->recordsWritten = 0;
+    m_header->startTime = QDateTime::currentMSecsSinceEpoch();
+    m_timer.start();
+    m_nextRecord = 0;
+
+    if (m_current != NULL)
+    {
+        m_current->setActive(false);
+    }
+    m_current = this;
+
+    // pins and signals connected before the recorder was activated
+    QHashIterator<quint64, QByteArray> i(knownNames());
+    while (i.hasNext())
+    {
+        i.next();
+        appendName(i.key(), i.value());
+    }
+
+    updateError("");
+    return true;
+}
+
+void QHalTraceRecorder::stop()
+{
+    if (m_current == this)
+    {
+        m_current = NULL;
+    }
+
+    if (m_mapping != NULL)
+    {
+        m_file.unmap(m_mapping);
+        m_file.close();
+        m_mapping = NULL;
+        m_header = NULL;
+        m_names = NULL;
+        m_records = NULL;
+    }
+}
+
+void QHalTraceRecorder::updateError(const QString &errorString)
+{
+    if (m_errorString != errorString) {
+        m_errorString = errorString;
+        emit errorStringChanged(errorString);
+    }
+}
+
+/** Returns a new id for a component or group, stored with its
+ *  records because handles of different Haltalk instances collide.
+ **/
+quint16 QHalTraceRecorder::createSource()
+{
+    return m_nextSource++;
+}
+
+/** Stores the full name of a handle, including the component or group
+ *  name. Called on full updates only, the names are kept while no recorder
+ *  is active so a recorder activated later knows all connected handles.
+ *  Pin updates and sets share the name of the pin.
+ **/
+void QHalTraceRecorder::recordName(QHalTraceKind kind, quint16 source, int handle, const QString &name)
+{
+    quint8 nameKind = (kind == QHalTraceSignalUpdate) ? QHalTraceSignalUpdate : QHalTracePinUpdate;
+    quint64 key = ((quint64)source << 40) | ((quint64)nameKind << 32) | (quint32)handle;
+    QByteArray bytes = name.toUtf8().left(QHAL_TRACE_NAME_LENGTH - 1);
+
+    knownNames().insert(key, bytes);
+
+    if (m_current != NULL)
+    {
+        m_current->appendName(key, bytes);
+    }
+}
+
+QHash<quint64, QByteArray> &QHalTraceRecorder::knownNames()
+{
+    static QHash<quint64, QByteArray> names;
+    return names;
+}
+
+/** Stores the name of a handle in the name table of the file */
+void QHalTraceRecorder::appendName(quint64 key, const QByteArray &name)
+{
+    quint32 handle = (quint32)key;
+    quint8 kind = (quint8)(key >> 32);
+    quint16 source = (quint16)(key >> 40);
+    QHalTraceName *entry = NULL;
+
+    for (quint32 i = 0; i < m_header->namesWritten; ++i)
+    {
+        if ((m_names[i].handle == handle) && (m_names[i].kind == kind) && (m_names[i].source == source))
+        {
+            entry = &m_names[i];
+            break;
+        }
+    }
+
+    if (entry == NULL)
+    {
+        if (m_header->namesWritten == m_header->nameCapacity)
+        {
+            return;
+        }
+        entry = &m_names[m_header->namesWritten];
+        entry->handle = handle;
+        entry->kind = kind;
+        entry->source = source;
+        m_header->namesWritten++;
+    }
+
+    memset(entry->name, 0, QHAL_TRACE_NAME_LENGTH);
+    memcpy(entry->name, name.constData(), name.size());
+}
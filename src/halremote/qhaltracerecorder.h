@@ -0,0 +1,161 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#ifndef QHALTRACERECORDER_H
+#define QHALTRACERECORDER_H
+
+#include <QObject>
+#include <QQmlParserStatus>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QHash>
+#include "qhalvalue.h"
+#include "qhaltraceformat.h"
+
+/** Records the values of HAL pins and signals seen by the remote
+ *  components and groups into a memory mapped ring file, so the last
+ *  values before a fault can be analyzed after the fact. The file is
+ *  preallocated when the recorder is activated, recording a value only
+ *  writes one record into the mapping and never allocates.
+ *  The active recorder is process wide, only used from the GUI thread.
+ **/
+class QHalTraceRecorder : public QObject, public QQmlParserStatus
+{
+    Q_OBJECT
+    Q_INTERFACES(QQmlParserStatus)
+    Q_PROPERTY(QString fileName READ fileName WRITE setFileName NOTIFY fileNameChanged)
+    Q_PROPERTY(int recordCapacity READ recordCapacity WRITE setRecordCapacity NOTIFY recordCapacityChanged)
+    Q_PROPERTY(int nameCapacity READ nameCapacity WRITE setNameCapacity NOTIFY nameCapacityChanged)
+    Q_PROPERTY(bool active READ isActive WRITE setActive NOTIFY activeChanged)
+    Q_PROPERTY(QString errorString READ errorString NOTIFY errorStringChanged)
+
+public:
+    explicit QHalTraceRecorder(QObject *parent = 0);
+    ~QHalTraceRecorder();
+
+    void classBegin() {}
+    void componentComplete();
+
+    QString fileName() const
+    {
+        return m_fileName;
+    }
+
+    int recordCapacity() const
+    {
+        return m_recordCapacity;
+    }
+
+    int nameCapacity() const
+    {
+        return m_nameCapacity;
+    }
+
+    bool isActive() const
+    {
+        return m_active;
+    }
+
+    QString errorString() const
+    {
+        return m_errorString;
+    }
+
+    Q_INVOKABLE bool dump(const QString &fileName);
+
+    /** Records a value with the active recorder, if there is one */
+    static inline void record(QHalTraceKind kind, quint16 source, int handle, const QHalValue &value)
+    {
+        if (m_current != NULL)
+        {
+            m_current->append(kind, source, handle, value);
+        }
+    }
+
+    static quint16 createSource();
+    static void recordName(QHalTraceKind kind, quint16 source, int handle, const QString &name);
+
+public slots:
+    void setFileName(const QString &arg);
+    void setRecordCapacity(int arg);
+    void setNameCapacity(int arg);
+    void setActive(bool arg);
+
+private:
+    static QHalTraceRecorder *m_current;
+    static quint16 m_nextSource;
+
+    QString m_fileName;
+    int     m_recordCapacity;
+    int     m_nameCapacity;
+    bool    m_active;
+    QString m_errorString;
+    bool    m_componentCompleted;
+
+    QFile   m_file;
+    uchar   *m_mapping;
+    QHalTraceHeader *m_header;
+    QHalTraceName   *m_names;
+    QHalTraceRecord *m_records;
+    quint64 m_nextRecord;
+    QElapsedTimer   m_timer;
+
+    bool start();
+    void stop();
+    void updateError(const QString &errorString);
+    void appendName(quint64 key, const QByteArray &name);
+
+    static QHash<quint64, QByteArray> &knownNames();
+
+    void append(QHalTraceKind kind, quint16 source, int handle, const QHalValue &value)
+    {
+        QHalTraceRecord &record = m_records[m_nextRecord];
+
+        record.timestamp = m_timer.nsecsElapsed();
+        record.handle = (quint32)handle;
+        record.kind = (quint8)kind;
+        record.source = source;
+        record.type = (quint8)value.type();
+        switch (value.type())
+        {
+        case pb::HAL_FLOAT: record.value.floating = value.toFloat(); break;
+        case pb::HAL_BIT: record.value.bit = value.toBit() ? 1 : 0; break;
+        case pb::HAL_S32: record.value.s32 = value.toS32(); break;
+        case pb::HAL_U32: record.value.u32 = value.toU32(); break;
+        default: record.value.floating = 0.0;
+        }
+
+        if (++m_nextRecord == m_header->recordCapacity)
+        {
+            m_nextRecord = 0;
+        }
+        m_header->recordsWritten++;  // after the record, a crash leaves no half written record behind
+    }
+
+signals:
+    void fileNameChanged(const QString &arg);
+    void recordCapacityChanged(int arg);
+    void nameCapacityChanged(int arg);
+    void activeChanged(bool arg);
+    void errorStringChanged(const QString &arg);
+};
+
+#endif // QHALTRACERECORDER_H
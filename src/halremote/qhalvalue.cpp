@@ -0,0 +1,169 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#include "qhalvalue.h"
+
+QHalValue::QHalValue() :
+    m_type(pb::HAL_BIT)
+{
+    m_data.bit = false;
+}
+
+QHalValue::QHalValue(bool value) :
+    m_type(pb::HAL_BIT)
+{
+    m_data.bit = value;
+}
+
+QHalValue::QHalValue(double value) :
+    m_type(pb::HAL_FLOAT)
+{
+    m_data.floating = value;
+}
+
+QHalValue::QHalValue(qint32 value) :
+    m_type(pb::HAL_S32)
+{
+    m_data.s32 = value;
+}
+
+QHalValue::QHalValue(quint32 value) :
+    m_type(pb::HAL_U32)
+{
+    m_data.u32 = value;
+}
+
+/** Converts a value set from QML to the given HAL type */
+QHalValue QHalValue::fromVariant(pb::ValueType type, const QVariant &variant)
+{
+    switch (type) {
+    case pb::HAL_FLOAT:
+        return QHalValue(variant.toDouble());
+    case pb::HAL_S32:
+        return QHalValue((qint32)variant.toInt());
+    case pb::HAL_U32:
+        return QHalValue((quint32)variant.toUInt());
+    default:
+        return QHalValue(variant.toBool());
+    }
+}
+
+bool QHalValue::toBit() const
+{
+    switch (m_type) {
+    case pb::HAL_FLOAT:
+        return m_data.floating != 0.0;
+    case pb::HAL_S32:
+        return m_data.s32 != 0;
+    case pb::HAL_U32:
+        return m_data.u32 != 0u;
+    default:
+        return m_data.bit;
+    }
+}
+
+double QHalValue::toFloat() const
+{
+    switch (m_type) {
+    case pb::HAL_FLOAT:
+        return m_data.floating;
+    case pb::HAL_S32:
+        return m_data.s32;
+    case pb::HAL_U32:
+        return m_data.u32;
+    default:
+        return m_data.bit ? 1.0 : 0.0;
+    }
+}
+
+qint32 QHalValue::toS32() const
+{
+    switch (m_type) {
+    case pb::HAL_FLOAT:
+        return (qint32)m_data.floating;
+    case pb::HAL_S32:
+        return m_data.s32;
+    case pb::HAL_U32:
+        return (qint32)m_data.u32;
+    default:
+        return m_data.bit ? 1 : 0;
+    }
+}
+
+quint32 QHalValue::toU32() const
+{
+    switch (m_type) {
+    case pb::HAL_FLOAT:
+        return (quint32)m_data.floating;
+    case pb::HAL_S32:
+        return (quint32)m_data.s32;
+    case pb::HAL_U32:
+        return m_data.u32;
+    default:
+        return m_data.bit ? 1u : 0u;
+    }
+}
+
+QVariant QHalValue::toVariant() const
+{
+    switch (m_type) {
+    case pb::HAL_FLOAT:
+        return QVariant(m_data.floating);
+    case pb::HAL_S32:
+        return QVariant(m_data.s32);
+    case pb::HAL_U32:
+        return QVariant(m_data.u32);
+    default:
+        return QVariant(m_data.bit);
+    }
+}
+
+QHalValue QHalValue::converted(pb::ValueType type) const
+{
+    switch (type) {
+    case pb::HAL_FLOAT:
+        return QHalValue(toFloat());
+    case pb::HAL_S32:
+        return QHalValue(toS32());
+    case pb::HAL_U32:
+        return QHalValue(toU32());
+    default:
+        return QHalValue(toBit());
+    }
+}
+
+bool QHalValue::operator==(const QHalValue &other) const
+{
+    if (m_type != other.m_type) {
+        return false;
+    }
+
+    switch (m_type) {
+    case pb::HAL_FLOAT:
+        return m_data.floating == other.m_data.floating;
+    case pb::HAL_S32:
+        return m_data.s32 == other.m_data.s32;
+    case pb::HAL_U32:
+        return m_data.u32 == other.m_data.u32;
+    default:
+        return m_data.bit == other.m_data.bit;
+    }
+}
@@ -0,0 +1,72 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#ifndef QHALVALUE_H
+#define QHALVALUE_H
+
+#include <QVariant>
+#include <machinetalk/protobuf/message.pb.h>
+
+/** The value of a HAL pin or signal stored with its HAL type.
+ *  The value is kept unboxed, conversions to QVariant happen only
+ *  when the value is handed to QML.
+ **/
+class QHalValue
+{
+public:
+    QHalValue();
+    explicit QHalValue(bool value);
+    explicit QHalValue(double value);
+    explicit QHalValue(qint32 value);
+    explicit QHalValue(quint32 value);
+
+    static QHalValue fromVariant(pb::ValueType type, const QVariant &variant);
+
+    pb::ValueType type() const
+    {
+        return m_type;
+    }
+
+    bool toBit() const;
+    double toFloat() const;
+    qint32 toS32() const;
+    quint32 toU32() const;
+    QVariant toVariant() const;
+
+    QHalValue converted(pb::ValueType type) const;
+
+    bool operator==(const QHalValue &other) const;
+    bool operator!=(const QHalValue &other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    pb::ValueType m_type;
+    union {
+        bool bit;
+        double floating;
+        qint32 s32;
+        quint32 u32;
+    } m_data;
+};
+
+#endif // QHALVALUE_H
@@ -58,7 +58,8 @@ LogChart {
 
     id: main
 
-    autoSampling: false
+    samplingMode: ValueModel.ChangeSampling
+    sampleSource: pin
 
     HalPin {
         id: pin
@@ -66,11 +67,6 @@ LogChart {
         name: main.name
         type: HalPin.Float
         direction: HalPin.In
-
-        onValueChanged: {
-            if (!autoSampling)
-                main.addData(value)
-        }
     }
 
     Binding { target: main; property: "value"; value: pin.value}
@@ -25,11 +25,11 @@ import Machinekit.Application 1.0
 import Machinekit.PathView 1.0
 
 QtObject {
-    property var status: {"synced": false}
+    property var status: {"synced": false, "motionSynced": false, "taskSynced": false}
     property var model: undefined
 
     property int _lastLine: 1
-    property bool _ready: status.synced
+    property bool _ready: status.motionSynced && status.taskSynced
 
     on_ReadyChanged: {
         if (_ready) {
@@ -42,8 +42,8 @@ QtObject {
 
     function updateLine() {
         if (_ready) {
-            var file = status.task.file
-            var currentLine = status.motion.motionLine
+            var file = status.taskFields.file
+            var currentLine = status.motionFields.motionLine
             
             if (_lastLine > currentLine) {
                 for (var line = 1; line <= _lastLine; ++line) {
@@ -66,13 +66,14 @@ GLView3D {
         "backplotarc": Qt.rgba(0.75, 0.25, 0.5, 0.75),
         "backplotfeed": Qt.rgba(0.75, 0.25, 0.25, 0.75)
     }
-    property int axes: _ready ? status.config.axes : 3
+    property int axes: _ready ? status.configFields.axes : 3
     property string viewMode: "Perspective"
     property real cameraZoom: 0.95
     property vector3d cameraOffset: Qt.vector3d(0, 0, 0)
     property real cameraHeading: -135
     property real cameraPitch: 60
-    property real sizeFactor: _ready ? status.config.linearUnits: 1
+    property real sizeFactor: _ready ? status.configFields.linearUnits: 1
+    property real unitScale: _ready ? getUnitScale() : 1
 
     property bool programVisible: object.settings.initialized && object.settings.values.preview.showProgram
     property bool gridVisible: true
@@ -85,7 +86,7 @@ GLView3D {
     property bool coordinateVisible: object.settings.initialized && object.settings.values.preview.showCoordinate
     property bool offsetsVisible: object.settings.initialized && object.settings.values.dro.showOffsets
 
-    property bool _ready: status.synced
+    property bool _ready: status.motionSynced && status.configSynced && status.ioSynced
     property var _axisNames: ["x", "y", "z", "a", "b", "c", "u", "v", "w"]
 
     id: pathView
@@ -93,6 +94,17 @@ GLView3D {
     enabled: object.settings.initialized && object.settings.values.preview.enable
     visible: enabled
 
+    function getUnitScale() {
+        switch (status.configFields.programUnits) {
+        case ApplicationStatus.CanonUnitsMm:
+            return 25.4
+        case ApplicationStatus.CanonUnitsCm:
+            return 2.54
+        default:
+            return 1
+        }
+    }
+
     camera: Camera3D {
         property real heading: pathView.cameraHeading
         property real pitch: pathView.cameraPitch
@@ -282,9 +294,9 @@ GLView3D {
     Cylinder3D {
         id: tool
         visible: pathView.toolVisible
-        position.x: _ready ? status.motion.position.x - status.io.toolOffset.x : 0
-        position.y: _ready ? status.motion.position.y - status.io.toolOffset.y : 0
-        position.z: (_ready ? status.motion.position.z - status.io.toolOffset.z : 0) + height
+        position.x: _ready ? status.position.x - status.toolOffset.x : 0
+        position.y: _ready ? status.position.y - status.toolOffset.y : 0
+        position.z: (_ready ? status.position.z - status.toolOffset.z : 0) + height
 
         cone: true
         radius: 5 * pathView.sizeFactor
@@ -331,12 +343,12 @@ GLView3D {
         visible: pathView.machineLimitsVisible
         axes: pathView.axes
         lineStippleLength: (pathView.viewMode == "Perspective") ? 0.02 * camera.distance / pathView.cameraZoom : 0.02
-        minimum.x: _ready ? status.config.axis[0].minPositionLimit : 0
-        minimum.y: (_ready && status.config.axis.length > 1) ? status.config.axis[1].minPositionLimit : 0
-        minimum.z: (_ready && status.config.axis.length > 2) ? status.config.axis[2].minPositionLimit : 0
-        maximum.x: _ready ? status.config.axis[0].maxPositionLimit : 0
-        maximum.y: (_ready && status.config.axis.length > 1) ? status.config.axis[1].maxPositionLimit : 0
-        maximum.z: (_ready && status.config.axis.length > 2) ? status.config.axis[2].maxPositionLimit : 0
+        minimum.x: _ready ? status.configFields.axis[0].minPositionLimit : 0
+        minimum.y: (_ready && status.configFields.axis.length > 1) ? status.configFields.axis[1].minPositionLimit : 0
+        minimum.z: (_ready && status.configFields.axis.length > 2) ? status.configFields.axis[2].minPositionLimit : 0
+        maximum.x: _ready ? status.configFields.axis[0].maxPositionLimit : 0
+        maximum.y: (_ready && status.configFields.axis.length > 1) ? status.configFields.axis[1].maxPositionLimit : 0
+        maximum.z: (_ready && status.configFields.axis.length > 2) ? status.configFields.axis[2].maxPositionLimit : 0
     }
 
     ProgramExtents3D {
@@ -356,9 +368,9 @@ GLView3D {
     }
 
     Coordinate3D {
-        property var g5xOffset: status.synced ? status.motion.g5xOffset : {"x":0.12345, "y":0.234,"z":123.12,"a":324.3}
-        property var g92Offset: status.synced ? status.motion.g92Offset : {"x":0.12345, "y":0.234,"z":123.12,"a":324.3}
-        property int positionOffset: status.synced ? status.config.positionOffset : ApplicationStatus.RelativePositionOffset
+        property var g5xOffset: status.motionSynced ? status.motionFields.g5xOffset : {"x":0.12345, "y":0.234,"z":123.12,"a":324.3}
+        property var g92Offset: status.motionSynced ? status.motionFields.g92Offset : {"x":0.12345, "y":0.234,"z":123.12,"a":324.3}
+        property int positionOffset: status.configSynced ? status.configFields.positionOffset : ApplicationStatus.RelativePositionOffset
 
         id: coordinates
         visible: pathView.coordinateVisible
@@ -395,10 +407,10 @@ GLView3D {
         id: programOffsets
         textSize: 14 * sizeFactor
         color: pathView.colors["small_origin"]
-        g5xIndex: status.synced ? status.motion.g5xIndex : 1
-        g5xOffset: status.synced ? status.motion.g5xOffset : {"x":0.12345, "y":0.234,"z":123.12,"a":324.3}
-        g92Offset: status.synced ? status.motion.g92Offset : {"x":0.12345, "y":0.234,"z":123.12,"a":324.3}
-        visible: pathView.offsetsVisible && (status.config.positionOffset === ApplicationStatus.RelativePositionOffset)
+        g5xIndex: status.motionSynced ? status.motionFields.g5xIndex : 1
+        g5xOffset: status.motionSynced ? status.motionFields.g5xOffset : {"x":0.12345, "y":0.234,"z":123.12,"a":324.3}
+        g92Offset: status.motionSynced ? status.motionFields.g92Offset : {"x":0.12345, "y":0.234,"z":123.12,"a":324.3}
+        visible: pathView.offsetsVisible && (status.configFields.positionOffset === ApplicationStatus.RelativePositionOffset)
     }
 
     Sphere3D {
@@ -421,6 +433,7 @@ GLView3D {
         backplotTraverseColor: pathView.colors["backplottraverse"]
         selectedColor: pathView.colors["selected"]
         activeColor: pathView.colors["active"]
+        unitScale: pathView.unitScale
         model: (pathView.model !== undefined) ? pathView.model : tmpModel
     }
 
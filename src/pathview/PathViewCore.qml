@@ -28,9 +28,12 @@ import Machinekit.Application 1.0
 ApplicationItem {
     property alias gcodeProgramModel: gcodeProgramModel
     property alias gcodeProgramLoader: gcodeProgramLoader
+    property alias previewCache: previewCache
 
     property bool _ready: file.ready
     property bool _previewEnabled: settings.initialized && settings.values.preview.enable
+    property string _loadedFile: ""
+    property int _programUnits: status.configSynced ? status.configFields.programUnits : PreviewClient.CanonUnitsInches
 
     id: pathViewCore
 
@@ -42,19 +45,11 @@ ApplicationItem {
     }
 
     function fileUploadFinished() {
-        gcodeProgramModel.clear()
-        gcodeProgramLoader.load()
-        if (_previewEnabled) {
-            executePreview()
-        }
+        loadProgram()
     }
 
     function fileDownloadFinished() {
-        gcodeProgramModel.clear()
-        gcodeProgramLoader.load()
-        if (_previewEnabled) {
-            executePreview()
-        }
+        loadProgram()
     }
 
     on_PreviewEnabledChanged: {
@@ -65,17 +60,39 @@ ApplicationItem {
         {
             gcodeProgramModel.clear()
             gcodeProgramLoader.load()
-            executePreview()
+            executePreview(1)
+        }
+    }
+
+    function loadProgram() {
+        if (_loadedFile !== file.remoteFilePath) {  // a reloaded program is updated in place
+            gcodeProgramModel.clear()
+            _loadedFile = file.remoteFilePath
+        }
+        gcodeProgramLoader.load()
+        if (_previewEnabled) {
+            executePreview(gcodeProgramLoader.firstChangedLine)
         }
     }
 
-    function executePreview() {
+    function executePreview(firstLine) {
         if (file.remoteFilePath.split('.').pop() === 'ngc') {   // only open ngc files
-            command.openProgram('preview', file.remoteFilePath)
-            command.runProgram('preview', 0)
+            if ((firstLine <= 1) && previewCache.load(file.localFilePath, file.remoteFilePath)) {
+                previewInterpreter.invalidate()
+                return
+            }
+            previewInterpreter.interpret(file.localFilePath, file.remoteFilePath, firstLine)
         }
     }
 
+    function executeRemotePreview() {
+        previewInterpreter.invalidate()
+        gcodeProgramModel.clearPreview(file.remoteFilePath, 1)
+        previewClient._cachePending = true
+        command.openProgram('preview', file.remoteFilePath)
+        command.runProgram('preview', 0)
+    }
+
     Service {
         id: previewService
         type: "preview"
@@ -87,15 +104,28 @@ ApplicationItem {
 
     PreviewClient {
         property bool _connected: false
+        property bool _cachePending: false
+        property bool _previewRunning: false
 
         id: previewClient
         statusUri: previewStatusService.uri
         previewUri: previewService.uri
         ready: ((previewService.ready && previewStatusService.ready) || _connected)
         model: gcodeProgramModel
-        units: status.synced ? status.config.programUnits : PreviewClient.CanonUnitsInches
 
         onConnectedChanged: delayTimer.running = true
+        onInterpreterStateChanged: {
+            if (interpreterState === PreviewClient.InterpreterRunning) {
+                _previewRunning = true
+            }
+            else if ((interpreterState === PreviewClient.InterpreterIdle) && _previewRunning) {
+                _previewRunning = false
+                if (_cachePending) {
+                    _cachePending = false
+                    previewCache.store(pathViewCore.file.localFilePath, pathViewCore.file.remoteFilePath)
+                }
+            }
+        }
     }
 
     Timer { // workaround for binding loop
@@ -109,6 +139,39 @@ ApplicationItem {
         id: gcodeProgramModel
     }
 
+    PreviewCache {
+        id: previewCache
+        model: gcodeProgramModel
+        parameters: {
+            "units": pathViewCore._programUnits,
+            "g5xIndex": status.motionSynced ? status.motionFields.g5xIndex : 1,
+            "g5xOffset": status.motionSynced ? status.motionFields.g5xOffset : {},
+            "g92Offset": status.motionSynced ? status.motionFields.g92Offset : {},
+            "toolOffset": status.ioSynced ? status.ioFields.toolOffset : {}
+        }
+    }
+
+    PreviewInterpreter {
+        id: previewInterpreter
+        model: gcodeProgramModel
+        units: pathViewCore._programUnits
+        linearUnits: status.configSynced ? status.configFields.linearUnits : 1.0
+        g5xIndex: status.motionSynced ? status.motionFields.g5xIndex : 1
+        g5xOffset: status.motionSynced ? status.motionFields.g5xOffset : {}
+        g92Offset: status.motionSynced ? status.motionFields.g92Offset : {}
+        toolOffset: status.ioSynced ? status.ioFields.toolOffset : {}
+        toolTable: status.ioSynced ? status.ioFields.toolTable : []
+
+        onFinished: {
+            if (supported) {
+                previewCache.store(pathViewCore.file.localFilePath, pathViewCore.file.remoteFilePath)
+            }
+            else {
+                executeRemotePreview()
+            }
+        }
+    }
+
     GCodeProgramLoader {
         id: gcodeProgramLoader
         model: gcodeProgramModel
@@ -23,7 +23,9 @@ SOURCES += \
     qpreviewclient.cpp \
     qgcodeprogramitem.cpp \
     qgcodeprogrammodel.cpp \
-    qgcodeprogramloader.cpp
+    qgcodeprogramloader.cpp \
+    qpreviewcache.cpp \
+    qpreviewinterpreter.cpp
 
 HEADERS += \
     plugin.h \
@@ -40,7 +42,10 @@ HEADERS += \
     debughelper.h \
     qgcodeprogramitem.h \
     qgcodeprogrammodel.h \
-    qgcodeprogramloader.h
+    qgcodeprogramloader.h \
+    previewrecord.h \
+    qpreviewcache.h \
+    qpreviewinterpreter.h
 
 RESOURCES += \
     shaders.qrc \
@@ -32,6 +32,8 @@
 #include "qglcanvas.h"
 #include "qgcodeprogrammodel.h"
 #include "qgcodeprogramloader.h"
+#include "qpreviewcache.h"
+#include "qpreviewinterpreter.h"
 
 static void initResources()
 {
@@ -75,6 +77,8 @@ void MachinekitPathViewPlugin::registerTypes(const char *uri)
     qmlRegisterType<QPreviewClient>(uri, 1, 0, "PreviewClient");
     qmlRegisterType<QGCodeProgramModel>(uri, 1, 0, "GCodeProgramModel");
     qmlRegisterType<QGCodeProgramLoader>(uri, 1, 0, "GCodeProgramLoader");
+    qmlRegisterType<QPreviewCache>(uri, 1, 0, "PreviewCache");
+    qmlRegisterType<QPreviewInterpreter>(uri, 1, 0, "PreviewInterpreter");
 
     const QString filesLocation = fileLocation();
     for (int i = 0; i < int(sizeof(qmldir)/sizeof(qmldir[0])); i++) {
@@ -0,0 +1,72 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+
+#ifndef PREVIEWRECORD_H
+#define PREVIEWRECORD_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <QMetaType>
+
+/** Compact fixed layout representation of a single preview step.
+ *  Preview messages are decoded once into records by the preview client,
+ *  the path item reads the records without going through protobuf accessors.
+ *  Only the preview types relevant for drawing the path are stored.
+ **/
+struct PreviewRecord
+{
+    enum Type {
+        StraightTraverse = 0,
+        StraightFeed = 1,
+        ArcFeed = 2,
+        SetG5xOffset = 3,
+        SetG92Offset = 4,
+        UseToolOffset = 5,
+        SelectPlane = 6
+    };
+
+    enum Axis {
+        XAxis = 0x01,
+        YAxis = 0x02,
+        ZAxis = 0x04
+    };
+
+    quint8 type;        // Type of the preview step
+    quint8 axes;        // valid components of pos (Axis flags)
+    quint16 reserved;
+    qint32 lineNumber;
+    double pos[3];      // x, y, z; ArcFeed: first end, second end, axis end point
+    double center[2];   // ArcFeed: first axis, second axis
+    union {
+        qint32 rotation;    // ArcFeed: number of turns, the sign defines the direction
+        qint32 g5Index;     // SetG5xOffset: index of the offset
+        qint32 plane;       // SelectPlane: 1=XY 2=YZ 3=XZ 4=UV 5=VW 6=WU
+    };
+};
+
+Q_DECLARE_TYPEINFO(PreviewRecord, Q_PRIMITIVE_TYPE);
+Q_DECLARE_METATYPE(PreviewRecord)
+
+typedef QVector<PreviewRecord> PreviewRecordList;
+
+#endif // PREVIEWRECORD_H
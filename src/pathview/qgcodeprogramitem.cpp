@@ -35,6 +35,7 @@ QGCodeProgramItem::QGCodeProgramItem(const QString &fileName, int lineNumber):
 
 QGCodeProgramItem::~QGCodeProgramItem()
 {
+    delete m_previewList;
 }
 
 QString QGCodeProgramItem::fileName() const
@@ -64,14 +65,18 @@ void QGCodeProgramItem::setGcode(const QString &gcode)
 {
     m_gcode = gcode;
 }
-QList<pb::Preview> *QGCodeProgramItem::previewList() const
+PreviewRecordList *QGCodeProgramItem::previewList() const
 {
     return m_previewList;
 }
 
-void QGCodeProgramItem::setPreviewList(QList<pb::Preview> *previewList)
+void QGCodeProgramItem::setPreviewList(PreviewRecordList *previewList)
 {
-    m_previewList = previewList;
+    if (m_previewList != previewList)
+    {
+        delete m_previewList;
+        m_previewList = previewList;
+    }
 }
 bool QGCodeProgramItem::selected() const
 {
@@ -24,7 +24,7 @@
 #define QGCODEPROGRAMITEM_H
 #include <QVariant>
 #include <QList>
-#include <machinetalk/protobuf/preview.pb.h>
+#include "previewrecord.h"
 
 class QGCodeProgramItem
 {
@@ -41,8 +41,8 @@ public:
     QString gcode() const;
     void setGcode(const QString &gcode);
 
-    QList<pb::Preview> *previewList() const;
-    void setPreviewList(QList<pb::Preview> *previewList);
+    PreviewRecordList *previewList() const;
+    void setPreviewList(PreviewRecordList *previewList);
 
     bool selected() const;
     void setSelected(bool selected);
@@ -60,7 +60,7 @@ private:
     bool m_selected;
     bool m_active;
     bool m_executed;
-    QList<pb::Preview> *m_previewList;
+    PreviewRecordList *m_previewList;
 };
 
 #endif // QGCODEPROGRAMITEM_H
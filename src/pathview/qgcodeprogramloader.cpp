@@ -27,7 +27,8 @@ QGCodeProgramLoader::QGCodeProgramLoader(QObject *parent) :
     m_localFilePath(""),
     m_localPath(""),
     m_remotePath(""),
-    m_model(NULL)
+    m_model(NULL),
+    m_firstChangedLine(1)
 {
 }
 
@@ -61,26 +62,38 @@ void QGCodeProgramLoader::load()
         return;
     }
 
-    int lineNumber = 0;
-
+    QStringList lines;
     while (!file.atEnd()) {
-        file.readLine();
-        lineNumber++;
+        lines.append(QString(file.readLine()));
     }
 
-    m_model->beginUpdate();
-    m_model->prepareFile(remoteFilePath, lineNumber);
-
-    lineNumber = 0;
-    file.reset();
-    while (!file.atEnd()) {
-        QByteArray line = file.readLine();
-        lineNumber++;
-        m_model->setData(remoteFilePath, lineNumber, QString(line), QGCodeProgramModel::GCodeRole);
+    if (m_model->containsFile(remoteFilePath))
+    {
+        // reload of an already loaded file, only update the changed lines
+        updateFirstChangedLine(m_model->updateFile(remoteFilePath, lines));
     }
+    else
+    {
+        m_model->beginUpdate();
+        m_model->prepareFile(remoteFilePath, lines.size());
 
-    m_model->endUpdate();
+        for (int i = 0; i < lines.size(); ++i) {
+            m_model->setData(remoteFilePath, i + 1, lines.at(i), QGCodeProgramModel::GCodeRole);
+        }
+
+        m_model->endUpdate();
+        updateFirstChangedLine(1);
+    }
 
     file.close();
     emit loadingFinished();
 }
+
+void QGCodeProgramLoader::updateFirstChangedLine(int firstChangedLine)
+{
+    if (m_firstChangedLine == firstChangedLine)
+        return;
+
+    m_firstChangedLine = firstChangedLine;
+    emit firstChangedLineChanged(firstChangedLine);
+}
@@ -37,6 +37,7 @@ class QGCodeProgramLoader : public QObject
     Q_PROPERTY(QString localPath READ localPath WRITE setLocalPath NOTIFY localPathChanged)
     Q_PROPERTY(QString remotePath READ remotePath WRITE setRemotePath NOTIFY remotePathChanged)
     Q_PROPERTY(QGCodeProgramModel *model READ model WRITE setModel NOTIFY modelChanged)
+    Q_PROPERTY(int firstChangedLine READ firstChangedLine NOTIFY firstChangedLineChanged)
 
 public:
     explicit QGCodeProgramLoader(QObject *parent = 0);
@@ -61,11 +62,17 @@ public:
         return m_model;
     }
 
+    int firstChangedLine() const
+    {
+        return m_firstChangedLine;
+    }
+
 signals:
     void localFilePathChanged(QString arg);
     void localPathChanged(QString arg);
     void remotePathChanged(QString arg);
     void modelChanged(QGCodeProgramModel * arg);
+    void firstChangedLineChanged(int arg);
     void loadingFinished();
     void loadingFailed();
 
@@ -111,6 +118,9 @@ private:
     QString m_localPath;
     QString m_remotePath;
     QGCodeProgramModel * m_model;
+    int m_firstChangedLine;
+
+    void updateFirstChangedLine(int firstChangedLine);
 };
 
 #endif // QGCODEPROGRAMLOADER_H
@@ -100,6 +100,167 @@ QHash<int, QByteArray> QGCodeProgramModel::roleNames() const
     return roles;
 }
 
+/** Appends preview records to the lines of a file.
+ *  Consecutive records of the same line are appended in one go.
+ *  Should be called between beginUpdate and endUpdate.
+ **/
+void QGCodeProgramModel::addPreview(const QString &fileName, const PreviewRecord *records, int count)
+{
+    int i = 0;
+    while (i < count)
+    {
+        int lineNumber = records[i].lineNumber;
+        int j = i + 1;
+        while ((j < count) && (records[j].lineNumber == lineNumber))
+        {
+            ++j;
+        }
+
+        QModelIndex modelIndex = index(fileName, lineNumber);
+        if (modelIndex.isValid())
+        {
+            QGCodeProgramItem *item = m_items.at(modelIndex.row());
+            PreviewRecordList *previewList = item->previewList();
+            if (previewList == NULL)
+            {
+                previewList = new PreviewRecordList();
+                item->setPreviewList(previewList);
+            }
+
+            int size = previewList->size();
+            previewList->resize(size + (j - i));
+            memcpy(previewList->data() + size, records + i, (j - i) * sizeof(PreviewRecord));
+        }
+
+        i = j;
+    }
+}
+
+/** Updates the lines of a file that is already in the model.
+ *  Only the changed range of lines is touched, previews from the first
+ *  changed line on are outdated and removed.
+ *  Returns the first changed line, lineCount + 1 if nothing changed.
+ **/
+int QGCodeProgramModel::updateFile(const QString &fileName, const QStringList &lines)
+{
+    FileIndex fileIndex;
+
+    if (!m_fileIndices.contains(fileName))
+    {
+        prepareFile(fileName, lines.size());
+        for (int i = 0; i < lines.size(); ++i)
+        {
+            setData(fileName, i + 1, lines.at(i), GCodeRole);
+        }
+        return 1;
+    }
+
+    fileIndex = m_fileIndices.value(fileName);
+
+    int oldCount = fileIndex.count;
+    int newCount = lines.size();
+    int prefix = 0;
+    int suffix = 0;
+
+    while ((prefix < oldCount) && (prefix < newCount)
+           && (m_items.at(fileIndex.index + prefix)->gcode() == lines.at(prefix)))
+    {
+        prefix++;
+    }
+
+    if ((prefix == oldCount) && (prefix == newCount))
+    {
+        return newCount + 1;
+    }
+
+    while ((suffix < (oldCount - prefix)) && (suffix < (newCount - prefix))
+           && (m_items.at(fileIndex.index + oldCount - 1 - suffix)->gcode() == lines.at(newCount - 1 - suffix)))
+    {
+        suffix++;
+    }
+
+    int oldChanged = oldCount - prefix - suffix;
+    int newChanged = newCount - prefix - suffix;
+    int commonChanged = qMin(oldChanged, newChanged);
+    int firstRow = fileIndex.index + prefix;
+
+    for (int i = 0; i < commonChanged; ++i)
+    {
+        m_items.at(firstRow + i)->setGcode(lines.at(prefix + i));
+    }
+    if (commonChanged > 0)
+    {
+        QVector<int> changedRoles;
+        changedRoles.append(GCodeRole);
+        emit dataChanged(index(firstRow), index(firstRow + commonChanged - 1), changedRoles);
+    }
+
+    if (newChanged > oldChanged)
+    {
+        int first = firstRow + commonChanged;
+        int last = firstRow + newChanged - 1;
+        beginInsertRows(QModelIndex(), first, last);
+        for (int row = first; row <= last; ++row)
+        {
+            QGCodeProgramItem *item = new QGCodeProgramItem(fileName, (row - fileIndex.index + 1));
+            item->setGcode(lines.at(row - fileIndex.index));
+            m_items.insert(row, item);
+        }
+        endInsertRows();
+    }
+    else if (oldChanged > newChanged)
+    {
+        int first = firstRow + commonChanged;
+        int last = firstRow + oldChanged - 1;
+        beginRemoveRows(QModelIndex(), first, last);
+        for (int row = last; row >= first; --row)
+        {
+            delete m_items.takeAt(row);
+        }
+        endRemoveRows();
+    }
+
+    int delta = newCount - oldCount;
+    if (delta != 0)
+    {
+        int first = firstRow + newChanged;
+        int last = fileIndex.index + newCount - 1;
+        for (int row = first; row <= last; ++row)
+        {
+            m_items.at(row)->setLineNumber(row - fileIndex.index + 1);
+        }
+        if (last >= first)
+        {
+            QVector<int> changedRoles;
+            changedRoles.append(LineNumberRole);
+            emit dataChanged(index(first), index(last), changedRoles);
+        }
+
+        QHashIterator<QString, FileIndex> i(m_fileIndices);
+        while (i.hasNext()) {
+            i.next();
+            FileIndex currentFileIndex = i.value();
+            if (currentFileIndex.index > fileIndex.index)    // if file is after the changed file
+            {
+                currentFileIndex.index += delta;
+                m_fileIndices.insert(i.key(), currentFileIndex);
+            }
+        }
+
+        fileIndex.count = newCount;
+        m_fileIndices.insert(fileName, fileIndex);
+    }
+
+    clearPreview(fileName, prefix + 1);
+
+    return prefix + 1;
+}
+
+bool QGCodeProgramModel::containsFile(const QString &fileName) const
+{
+    return m_fileIndices.contains(fileName);
+}
+
 void QGCodeProgramModel::prepareFile(const QString &fileName, int lineCount)
 {
     FileIndex fileIndex;
@@ -240,6 +401,24 @@ void QGCodeProgramModel::clear()
     m_fileIndices.clear();
 }
 
+/** Removes the previews of a file starting from firstLine */
+void QGCodeProgramModel::clearPreview(const QString &fileName, int firstLine)
+{
+    FileIndex fileIndex;
+
+    if (!m_fileIndices.contains(fileName))
+    {
+        return;
+    }
+
+    fileIndex = m_fileIndices.value(fileName);
+
+    for (int row = fileIndex.index + qMax(firstLine, 1) - 1; row < (fileIndex.index + fileIndex.count); ++row)
+    {
+        m_items.at(row)->setPreviewList(NULL);
+    }
+}
+
 void QGCodeProgramModel::beginUpdate()
 {
     beginResetModel();
@@ -250,6 +429,25 @@ void QGCodeProgramModel::endUpdate()
     endResetModel();
 }
 
+/** Notifies views that the previews from firstLine of a file on changed,
+ *  previews before this line are unchanged.
+ **/
+void QGCodeProgramModel::endPreviewUpdate(const QString &fileName, int firstLine)
+{
+    QModelIndex modelIndex;
+
+    modelIndex = index(fileName, qMax(firstLine, 1));
+    if (modelIndex.isValid())
+    {
+        emit previewUpdated(modelIndex.row());
+    }
+    else if (m_fileIndices.contains(fileName))  // past the end of the file
+    {
+        FileIndex fileIndex = m_fileIndices.value(fileName);
+        emit previewUpdated(fileIndex.index + fileIndex.count);
+    }
+}
+
 QVariant QGCodeProgramModel::internalData(const QModelIndex &index, int role) const
 {
     if (!index.isValid() || (index.row() > (m_items.count() - 1)))
@@ -304,7 +502,7 @@ bool QGCodeProgramModel::internalSetData(const QModelIndex &index, const QVarian
         item->setGcode(value.toString());
         break;
     case PreviewRole:
-        item->setPreviewList(static_cast<QList<pb::Preview>* >(value.value<void*>()));
+        item->setPreviewList(static_cast<PreviewRecordList*>(value.value<void*>()));
         break;
     case SelectedRole:
         item->setSelected(value.toBool());
@@ -24,6 +24,7 @@
 #define QGCODEPROGRAMMODEL_H
 
 #include <QAbstractListModel>
+#include <QStringList>
 #include "qgcodeprogramitem.h"
 
 class QGCodeProgramModel : public QAbstractListModel
@@ -52,6 +53,9 @@ public:
     Qt::ItemFlags flags(const QModelIndex &index) const;
     int rowCount(const QModelIndex &parent = QModelIndex()) const;
     QHash<int, QByteArray> roleNames() const;
+    void addPreview(const QString &fileName, const PreviewRecord *records, int count);
+    int updateFile(const QString &fileName, const QStringList &lines);
+    bool containsFile(const QString &fileName) const;
 
 public slots:
     void prepareFile(const QString &fileName, int lineCount);
@@ -60,8 +64,13 @@ public slots:
     QVariant data(const QString &fileName, int lineNumber, int role) const;
     bool setData(const QString &fileName, int lineNumber, const QVariant &value, int role);
     void clear();
+    void clearPreview(const QString &fileName, int firstLine);
     void beginUpdate();
     void endUpdate();
+    void endPreviewUpdate(const QString &fileName, int firstLine);
+
+signals:
+    void previewUpdated(int firstRow);
 
 private:
     typedef struct {
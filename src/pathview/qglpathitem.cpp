@@ -24,6 +24,8 @@
 #include <QtCore/qmath.h>
 #include "debughelper.h"
 
+static const int checkpointInterval = 1000;   // rows
+
 QGLPathItem::QGLPathItem(QQuickItem *parent) :
     QGLItem(parent),
     m_model(NULL),
@@ -35,6 +37,8 @@ QGLPathItem::QGLPathItem(QQuickItem *parent) :
     m_backplotTraverseColor(QColor(Qt::yellow)),
     m_selectedColor(QColor(Qt::magenta)),
     m_activeColor(QColor(Qt::red)),
+    m_unitScale(1.0),
+    m_currentModelRow(-1),
     m_needsFullUpdate(true),
     m_minimumExtents(QVector3D(0, 0, 0)),
     m_maximumExtents(QVector3D(0, 0, 0))
@@ -86,6 +90,7 @@ void QGLPathItem::paint(QGLView *glView)
                     glView->color(m_traverseColor);
                     glView->lineStipple(true, 1.0);
                 }
+                glView->scale(m_unitScale, m_unitScale, m_unitScale);
                 glView->translate(linePathItem->position);
                 drawablePointer = glView->line(linePathItem->lineVector);
             }
@@ -93,6 +98,7 @@ void QGLPathItem::paint(QGLView *glView)
             {
                 ArcPathItem *arcPathItem = static_cast<ArcPathItem*>(pathItem);
                 glView->color(m_arcFeedColor);
+                glView->scale(m_unitScale, m_unitScale, m_unitScale);
                 glView->translate(arcPathItem->position);
                 if (arcPathItem->rotationPlane == XZPlane) {
                     glView->rotate(90, 1, 0, 0);
@@ -130,14 +136,15 @@ void QGLPathItem::paint(QGLView *glView)
             if (pathItem != NULL)
             {
                 QColor color;
-                if (m_model->data(pathItem->modelIndex, QGCodeProgramModel::SelectedRole).toBool()) {
+                QModelIndex index = m_model->index(pathItem->modelRow);
+                if (m_model->data(index, QGCodeProgramModel::SelectedRole).toBool()) {
                     color = m_selectedColor;
                 }
-                else if (m_model->data(pathItem->modelIndex, QGCodeProgramModel::ActiveRole).toBool())
+                else if (m_model->data(index, QGCodeProgramModel::ActiveRole).toBool())
                 {
                     color = m_activeColor;
                 }
-                else if (m_model->data(pathItem->modelIndex, QGCodeProgramModel::ExecutedRole).toBool())
+                else if (m_model->data(index, QGCodeProgramModel::ExecutedRole).toBool())
                 {
                     if (pathItem->movementType == FeedMove) {
                         if (pathItem->pathType == Arc) {
@@ -194,12 +201,17 @@ QColor QGLPathItem::selectedColor() const
 
 QVector3D QGLPathItem::minimumExtents() const
 {
-    return m_minimumExtents;
+    return m_minimumExtents * m_unitScale;
 }
 
 QVector3D QGLPathItem::maximumExtents() const
 {
-    return m_maximumExtents;
+    return m_maximumExtents * m_unitScale;
+}
+
+double QGLPathItem::unitScale() const
+{
+    return m_unitScale;
 }
 
 QColor QGLPathItem::straightFeedColor() const
@@ -240,7 +252,7 @@ void QGLPathItem::selectDrawable(void *pointer)
     mappedPathItem = m_drawablePathMap.value(pointer, NULL);
     if (mappedPathItem != NULL)
     {
-        mappedModelIndex = mappedPathItem->modelIndex;
+        mappedModelIndex = m_model->index(mappedPathItem->modelRow);
         m_model->setData(mappedModelIndex, true, QGCodeProgramModel::SelectedRole);
     }
 
@@ -249,7 +261,7 @@ void QGLPathItem::selectDrawable(void *pointer)
         mappedPathItem = m_drawablePathMap.value(m_previousSelectedDrawable);
         if (mappedPathItem != NULL)
         {
-            mappedModelIndex = mappedPathItem->modelIndex;
+            mappedModelIndex = m_model->index(mappedPathItem->modelRow);
             m_model->setData(mappedModelIndex, false, QGCodeProgramModel::SelectedRole);
         }
 
@@ -267,8 +279,14 @@ void QGLPathItem::setModel(QGCodeProgramModel *arg)
         {
             connect(m_model, SIGNAL(modelReset()),
                     this, SLOT(drawPath()));
+            connect(m_model, SIGNAL(previewUpdated(int)),
+                    this, SLOT(updatePath(int)));
             connect(m_model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)),
                     this, SLOT(modelDataChanged(QModelIndex,QModelIndex,QVector<int>)));
+            connect(m_model, SIGNAL(rowsInserted(QModelIndex,int,int)),
+                    this, SLOT(modelRowsInserted(QModelIndex,int,int)));
+            connect(m_model, SIGNAL(rowsRemoved(QModelIndex,int,int)),
+                    this, SLOT(modelRowsRemoved(QModelIndex,int,int)));
 
             if (m_model->rowCount() > 0)
             {
@@ -342,18 +360,25 @@ void QGLPathItem::setBackplotTraverseColor(QColor arg)
     }
 }
 
+void QGLPathItem::setUnitScale(double arg)
+{
+    if (m_unitScale != arg) {
+        m_unitScale = arg;
+        emit unitScaleChanged(arg);
+
+        // the path items stay untouched, only the drawables are scaled
+        m_needsFullUpdate = true;
+        emit needsUpdate();
+        releaseExtents();
+    }
+}
+
 void QGLPathItem::resetActiveOffsets()
 {
     Position clearOffset;
     clearOffset.x = 0.0;
     clearOffset.y = 0.0;
     clearOffset.z = 0.0;
-    clearOffset.a = 0.0;
-    clearOffset.b = 0.0;
-    clearOffset.c = 0.0;
-    clearOffset.u = 0.0;
-    clearOffset.v = 0.0;
-    clearOffset.w = 0.0;
 
     m_activeOffsets.g92Offset = clearOffset;
     m_activeOffsets.toolOffset = clearOffset;
@@ -370,12 +395,6 @@ void QGLPathItem::resetCurrentPosition()
     m_currentPosition.x = 0.0;
     m_currentPosition.y = 0.0;
     m_currentPosition.z = 0.0;
-    m_currentPosition.a = 0.0;
-    m_currentPosition.b = 0.0;
-    m_currentPosition.c = 0.0;
-    m_currentPosition.u = 0.0;
-    m_currentPosition.v = 0.0;
-    m_currentPosition.w = 0.0;
 }
 
 void QGLPathItem::resetActivePlane()
@@ -413,38 +432,25 @@ void QGLPathItem::updateExtents(const QVector3D &vector)
 
 void QGLPathItem::releaseExtents()
 {
-    emit minimumExtentsChanged(m_minimumExtents);
-    emit maximumExtentsChanged(m_maximumExtents);
+    emit minimumExtentsChanged(minimumExtents());
+    emit maximumExtentsChanged(maximumExtents());
 }
 
-void QGLPathItem::processPreview(const pb::Preview &preview)
+void QGLPathItem::processPreview(const PreviewRecord &preview)
 {
-    switch (preview.type())
+    switch (preview.type)
     {
-    case pb::PV_STRAIGHT_PROBE:  /*nothing*/ return;
-    case pb::PV_RIGID_TAP:  /*nothing*/ return;
-    case pb::PV_STRAIGHT_FEED: processStraightMove(preview, FeedMove); return;
-    case pb::PV_ARC_FEED: processArcFeed(preview); return;
-    case pb::PV_STRAIGHT_TRAVERSE: processStraightMove(preview, TraverseMove); return;
-    case pb::PV_SET_G5X_OFFSET: processSetG5xOffset(preview); return;
-    case pb::PV_SET_G92_OFFSET: processSetG92Offset(preview); return;
-    case pb::PV_SET_XY_ROTATION: /*nothing*/ return;
-    case pb::PV_SELECT_PLANE: processSelectPlane(preview); return;
-    case pb::PV_SET_TRAVERSE_RATE: /*nothing*/ return;
-    case pb::PV_SET_FEED_RATE: /*nothing*/ return;
-    case pb::PV_CHANGE_TOOL: /*nothing*/ return;
-    case pb::PV_CHANGE_TOOL_NUMBER: /*nothing*/ return;
-    case pb::PV_DWELL: /*nothing*/ return;
-    case pb::PV_MESSAGE: /*nothing*/ return;
-    case pb::PV_COMMENT: /*nothing*/ return;
-    case pb::PV_USE_TOOL_OFFSET: processUseToolOffset(preview); return;
-    case pb::PV_SET_PARAMS: /*nothing*/ return;
-    case pb::PV_SET_FEED_MODE: /*nothing*/ return;
-    case pb::PV_SOURCE_CONTEXT: /*nothing*/ return;
-    }
-}
-
-void QGLPathItem::processStraightMove(const pb::Preview &preview, MovementType movementType)
+    case PreviewRecord::StraightFeed: processStraightMove(preview, FeedMove); return;
+    case PreviewRecord::ArcFeed: processArcFeed(preview); return;
+    case PreviewRecord::StraightTraverse: processStraightMove(preview, TraverseMove); return;
+    case PreviewRecord::SetG5xOffset: processSetG5xOffset(preview); return;
+    case PreviewRecord::SetG92Offset: processSetG92Offset(preview); return;
+    case PreviewRecord::SelectPlane: processSelectPlane(preview); return;
+    case PreviewRecord::UseToolOffset: processUseToolOffset(preview); return;
+    }
+}
+
+void QGLPathItem::processStraightMove(const PreviewRecord &preview, MovementType movementType)
 {
 #ifdef QT_DEBUG
     if (movementType == FeedMove)
@@ -463,23 +469,23 @@ void QGLPathItem::processStraightMove(const pb::Preview &preview, MovementType m
     LinePathItem *linePathItem;
 
     linePathItem = new LinePathItem();
-    newPosition = calculateNewPosition(preview.pos());
+    newPosition = calculateNewPosition(preview);
     currentVector = positionToVector3D(m_currentPosition);
     newVector = positionToVector3D(newPosition);
 
     linePathItem->position = currentVector;
     linePathItem->lineVector = newVector - currentVector;
     linePathItem->movementType = movementType;
-    linePathItem->modelIndex = m_currentModelIndex,
+    linePathItem->modelRow = m_currentModelRow,
     m_previewPathItems.append(linePathItem);
-    m_modelPathMap.insert(m_currentModelIndex, linePathItem);   // mapping model index to the item
+    m_modelPathMap.insert(m_currentModelRow, linePathItem);   // mapping model row to the item
 
     m_currentPosition = newPosition;
 
     updateExtents(newVector);
 }
 
-void QGLPathItem::processArcFeed(const pb::Preview &preview)
+void QGLPathItem::processArcFeed(const PreviewRecord &preview)
 {
 #ifdef QT_DEBUG
     qDebug() << "arc feed";
@@ -501,14 +507,14 @@ void QGLPathItem::processArcFeed(const pb::Preview &preview)
     ArcPathItem *arcPathItem;
 
     currentVector = positionToVector3D(m_currentPosition);
-    newPosition = calculateNewPosition(preview.pos());
+    newPosition = m_currentPosition;
 
     if (m_activePlane == XYPlane)
     {
         arcPathItem = new ArcPathItem();
-        newPosition.x = preview.first_end();
-        newPosition.y = preview.second_end();
-        newPosition.z = preview.axis_end_point();
+        newPosition.x = preview.pos[0];
+        newPosition.y = preview.pos[1];
+        newPosition.z = preview.pos[2];
         newVector = positionToVector3D(newPosition);
 
         startPoint.setX(currentVector.x());
@@ -519,9 +525,9 @@ void QGLPathItem::processArcFeed(const pb::Preview &preview)
     else if (m_activePlane == YZPlane)
     {
         arcPathItem = new ArcPathItem();
-        newPosition.y = preview.first_end();
-        newPosition.z = preview.second_end();
-        newPosition.x = preview.axis_end_point();
+        newPosition.y = preview.pos[0];
+        newPosition.z = preview.pos[1];
+        newPosition.x = preview.pos[2];
         newVector = positionToVector3D(newPosition);
 
         startPoint.setX(currentVector.y());
@@ -532,9 +538,9 @@ void QGLPathItem::processArcFeed(const pb::Preview &preview)
     else if (m_activePlane == XZPlane)
     {
         arcPathItem = new ArcPathItem();
-        newPosition.x = preview.first_end();
-        newPosition.z = preview.second_end();
-        newPosition.y = preview.axis_end_point();
+        newPosition.x = preview.pos[0];
+        newPosition.z = preview.pos[1];
+        newPosition.y = preview.pos[2];
         newVector = positionToVector3D(newPosition);
 
         startPoint.setX(currentVector.x());
@@ -547,10 +553,10 @@ void QGLPathItem::processArcFeed(const pb::Preview &preview)
         return; // not supported
     }
 
-    endPoint.setX(preview.first_end());
-    endPoint.setY(preview.second_end());
-    centerPoint.setX(preview.first_axis());
-    centerPoint.setY(preview.second_axis());
+    endPoint.setX(preview.pos[0]);
+    endPoint.setY(preview.pos[1]);
+    centerPoint.setX(preview.center[0]);
+    centerPoint.setY(preview.center[1]);
     startVector = startPoint - centerPoint;
     endVector = endPoint - centerPoint;
 
@@ -562,12 +568,12 @@ void QGLPathItem::processArcFeed(const pb::Preview &preview)
     if (endAngle < 0) {
         endAngle += 2 * M_PI;
     }
-    anticlockwise = preview.rotation() >= 0;
+    anticlockwise = preview.rotation >= 0;
     if (anticlockwise) {
-        startAngle += 2.0 * M_PI * (qAbs((double)preview.rotation())-1.0);  // for rotation > 1 increase the endAngle
+        startAngle += 2.0 * M_PI * (qAbs((double)preview.rotation)-1.0);  // for rotation > 1 increase the endAngle
     }
     else {
-        endAngle -= 2.0 * M_PI * (qAbs((double)preview.rotation())-1.0);  // for rotation > 1 decrease the startAngle
+        endAngle -= 2.0 * M_PI * (qAbs((double)preview.rotation)-1.0);  // for rotation > 1 decrease the startAngle
     }
 
     radius = centerPoint.distanceToPoint(startPoint);
@@ -687,155 +693,82 @@ void QGLPathItem::processArcFeed(const pb::Preview &preview)
     arcPathItem->endAngle = endAngle;
     arcPathItem->anticlockwise = anticlockwise;
     arcPathItem->movementType = FeedMove;
-    arcPathItem->modelIndex = m_currentModelIndex,
+    arcPathItem->modelRow = m_currentModelRow,
     m_previewPathItems.append(arcPathItem);
-    m_modelPathMap.insertMulti(m_currentModelIndex, arcPathItem);   // mapping model index to the item
+    m_modelPathMap.insertMulti(m_currentModelRow, arcPathItem);   // mapping model row to the item
 
     m_currentPosition = newPosition;
 }
 
-void QGLPathItem::processSetG5xOffset(const pb::Preview &preview)
+void QGLPathItem::processSetG5xOffset(const PreviewRecord &preview)
 {
-    if (preview.has_pos()) {
-        m_activeOffsets.g5xOffsets.replace(preview.g5_index(), previewPositionToPosition(preview.pos()));
+    if ((preview.g5Index < 1) || (preview.g5Index > m_activeOffsets.g5xOffsets.size())) {
+        return;
     }
+
+    // the offset is set when the coordinate system is selected
+    m_activeOffsets.g5xOffsets.replace(preview.g5Index - 1, previewPositionToPosition(preview));
+    m_activeOffsets.g5xOffsetIndex = preview.g5Index;
 }
 
-void QGLPathItem::processSetG92Offset(const pb::Preview &preview)
+void QGLPathItem::processSetG92Offset(const PreviewRecord &preview)
 {
-    if (preview.has_pos()) {
-        m_activeOffsets.g92Offset = previewPositionToPosition(preview.pos());
-    }
+    m_activeOffsets.g92Offset = previewPositionToPosition(preview);
 }
 
-void QGLPathItem::processUseToolOffset(const pb::Preview &preview)
+void QGLPathItem::processUseToolOffset(const PreviewRecord &preview)
 {
-    if (preview.has_pos()) {
-        m_activeOffsets.toolOffset = previewPositionToPosition(preview.pos());
-    }
+    m_activeOffsets.toolOffset = previewPositionToPosition(preview);
 }
 
-void QGLPathItem::processSelectPlane(const pb::Preview &preview)
+void QGLPathItem::processSelectPlane(const PreviewRecord &preview)
 {
-    if (preview.has_plane())
+    switch (preview.plane)
     {
-        switch (preview.plane())
-        {
-        case 1: m_activePlane = XYPlane; break;
-        case 2: m_activePlane = YZPlane; break;
-        case 3: m_activePlane = XZPlane; break;
-        case 4: m_activePlane = UVPlane; break;
-        case 5: m_activePlane = VWPlane; break;
-        case 6: m_activePlane = WUPlane; break;
-        default: break;
-        }
+    case 1: m_activePlane = XYPlane; break;
+    case 2: m_activePlane = YZPlane; break;
+    case 3: m_activePlane = XZPlane; break;
+    case 4: m_activePlane = UVPlane; break;
+    case 5: m_activePlane = VWPlane; break;
+    case 6: m_activePlane = WUPlane; break;
+    default: break;
     }
 }
 
-QGLPathItem::Position QGLPathItem::previewPositionToPosition(const pb::Position &position) const
+QGLPathItem::Position QGLPathItem::previewPositionToPosition(const PreviewRecord &preview) const
 {
     Position newPosition;
-    newPosition.x = 0.0;
-    newPosition.y = 0.0;
-    newPosition.z = 0.0;
-    newPosition.a = 0.0;
-    newPosition.b = 0.0;
-    newPosition.c = 0.0;
-    newPosition.u = 0.0;
-    newPosition.v = 0.0;
-    newPosition.w = 0.0;
-
-    if (position.has_x()) {
-        newPosition.x = position.x();
-    }
-    if (position.has_y()) {
-        newPosition.y = position.y();
-    }
-    if (position.has_z()) {
-        newPosition.z = position.z();
-    }
-    if (position.has_a()) {
-        newPosition.a = position.a();
-    }
-    if (position.has_b()) {
-        newPosition.b = position.b();
-    }
-    if (position.has_c()) {
-        newPosition.c = position.c();
-    }
-    if (position.has_u()) {
-        newPosition.u = position.u();
-    }
-    if (position.has_v()) {
-        newPosition.v = position.v();
-    }
-    if (position.has_w()) {
-        newPosition.w = position.w();
-    }
+    newPosition.x = (preview.axes & PreviewRecord::XAxis) ? preview.pos[0] : 0.0;
+    newPosition.y = (preview.axes & PreviewRecord::YAxis) ? preview.pos[1] : 0.0;
+    newPosition.z = (preview.axes & PreviewRecord::ZAxis) ? preview.pos[2] : 0.0;
 
     return newPosition;
 }
 
-QGLPathItem::Position QGLPathItem::calculateNewPosition(const pb::Position &newPosition) const
+QGLPathItem::Position QGLPathItem::calculateNewPosition(const PreviewRecord &preview) const
 {
     Position position = m_currentPosition;
+    const Position &g5xOffset = m_activeOffsets.g5xOffsets.at(m_activeOffsets.g5xOffsetIndex-1);
 
-    if (newPosition.has_x()) {
+    if (preview.axes & PreviewRecord::XAxis) {
         position.x = m_activeOffsets.g92Offset.x;
-        position.x += m_activeOffsets.g5xOffsets.at(m_activeOffsets.g5xOffsetIndex-1).x;
+        position.x += g5xOffset.x;
         position.x += m_activeOffsets.toolOffset.x;
-        position.x += newPosition.x();
+        position.x += preview.pos[0];
     }
 
-    if (newPosition.has_y()) {
+    if (preview.axes & PreviewRecord::YAxis) {
         position.y = m_activeOffsets.g92Offset.y;
-        position.y += m_activeOffsets.g5xOffsets.at(m_activeOffsets.g5xOffsetIndex-1).y;
+        position.y += g5xOffset.y;
         position.y += m_activeOffsets.toolOffset.y;
-        position.y += newPosition.y();
+        position.y += preview.pos[1];
     }
 
-    if (newPosition.has_z()) {
+    if (preview.axes & PreviewRecord::ZAxis) {
         position.z = m_activeOffsets.g92Offset.z;
-        position.z += m_activeOffsets.g5xOffsets.at(m_activeOffsets.g5xOffsetIndex-1).z;
+        position.z += g5xOffset.z;
         position.z += m_activeOffsets.toolOffset.z;
-        position.z += newPosition.z();
-    }
-
-    if (newPosition.has_a()) {
-        position.a = m_activeOffsets.g92Offset.a;
-        position.a += m_activeOffsets.g5xOffsets.at(m_activeOffsets.g5xOffsetIndex-1).a;
-        position.a += m_activeOffsets.toolOffset.a;
-        position.a += newPosition.a();
-    }
-    if (newPosition.has_b()) {
-        position.b = m_activeOffsets.g92Offset.b;
-        position.b += m_activeOffsets.g5xOffsets.at(m_activeOffsets.g5xOffsetIndex-1).b;
-        position.b += m_activeOffsets.toolOffset.b;
-        position.b += newPosition.b();
-    }
-    if (newPosition.has_c()) {
-        position.c = m_activeOffsets.g92Offset.c;
-        position.c += m_activeOffsets.g5xOffsets.at(m_activeOffsets.g5xOffsetIndex-1).c;
-        position.c += m_activeOffsets.toolOffset.c;
-        position.c += newPosition.c();
-    }
-    if (newPosition.has_u()) {
-        position.u = m_activeOffsets.g92Offset.u;
-        position.u += m_activeOffsets.g5xOffsets.at(m_activeOffsets.g5xOffsetIndex-1).u;
-        position.u += m_activeOffsets.toolOffset.u;
-        position.u += newPosition.u();
-    }
-    if (newPosition.has_v()) {
-        position.v = m_activeOffsets.g92Offset.v;
-        position.v += m_activeOffsets.g5xOffsets.at(m_activeOffsets.g5xOffsetIndex-1).v;
-        position.v += m_activeOffsets.toolOffset.v;
-        position.v += newPosition.v();
-    }
-    if (newPosition.has_w()) {
-        position.w = m_activeOffsets.g92Offset.w;
-        position.w += m_activeOffsets.g5xOffsets.at(m_activeOffsets.g5xOffsetIndex-1).w;
-        position.w += m_activeOffsets.toolOffset.w;
-        position.w += newPosition.w();
+        position.z += preview.pos[2];
     }
 
     return position;
@@ -863,33 +796,107 @@ void QGLPathItem::drawPath()
 
     m_modelPathMap.clear();
     m_drawablePathMap.clear();
+    m_checkpoints.clear();
+    m_previousSelectedDrawable = NULL;
+
+    processRows(0);
+
+    m_needsFullUpdate = true;
+    emit needsUpdate();
+
+    releaseExtents();
+}
+
+/** Rebuilds the path from firstRow on. The processing state is restored
+ *  from the last checkpoint before firstRow so the path items of the
+ *  unchanged part of the program are retained.
+ **/
+void QGLPathItem::updatePath(int firstRow)
+{
+    if (m_model == NULL)
+    {
+        return;
+    }
+
+    while (!m_checkpoints.isEmpty() && (m_checkpoints.last().row > firstRow))
+    {
+        m_checkpoints.removeLast();
+    }
+
+    if (m_checkpoints.isEmpty())
+    {
+        drawPath();
+        return;
+    }
+
+    const Checkpoint &checkpoint = m_checkpoints.last();
+    while (m_previewPathItems.size() > checkpoint.pathItemCount)
+    {
+        PathItem *pathItem = m_previewPathItems.takeLast();
+        m_modelPathMap.remove(pathItem->modelRow, pathItem);
+        delete pathItem;
+    }
+    m_currentPosition = checkpoint.currentPosition;
+    m_activeOffsets = checkpoint.activeOffsets;
+    m_activePlane = checkpoint.activePlane;
+    m_minimumExtents = checkpoint.minimumExtents;
+    m_maximumExtents = checkpoint.maximumExtents;
+
+    m_drawablePathMap.clear();  // drawables are recreated on the next paint
     m_previousSelectedDrawable = NULL;
 
-    for (int i = 0; i < m_model->rowCount(); ++i)
+    processRows(checkpoint.row);
+
+    m_needsFullUpdate = true;
+    emit needsUpdate();
+
+    releaseExtents();
+}
+
+void QGLPathItem::processRows(int firstRow)
+{
+    for (int i = firstRow; i < m_model->rowCount(); ++i)
     {
         QModelIndex index;
-        QList<pb::Preview>* previewList;
+        PreviewRecordList *previewList;
+
+        if ((i % checkpointInterval) == 0) {
+            addCheckpoint(i);
+        }
 
         index = m_model->index(i);
         if (!index.isValid()) {
             continue;
         }
-        previewList = static_cast<QList<pb::Preview>* >(m_model->data(index, QGCodeProgramModel::PreviewRole).value<void*>());
+        previewList = static_cast<PreviewRecordList*>(m_model->data(index, QGCodeProgramModel::PreviewRole).value<void*>());
 
         if (previewList != NULL)
         {
-            m_currentModelIndex = index;
+            m_currentModelRow = i;
+            const PreviewRecord *records = previewList->constData();
             for (int j = 0; j < previewList->size(); ++j)
             {
-                processPreview(previewList->at(j));
+                processPreview(records[j]);
             }
         }
     }
+}
 
-    m_needsFullUpdate = true;
-    emit needsUpdate();
+void QGLPathItem::addCheckpoint(int row)
+{
+    if (!m_checkpoints.isEmpty() && (m_checkpoints.last().row >= row)) {
+        return;
+    }
 
-    releaseExtents();
+    Checkpoint checkpoint;
+    checkpoint.row = row;
+    checkpoint.pathItemCount = m_previewPathItems.size();
+    checkpoint.currentPosition = m_currentPosition;
+    checkpoint.activeOffsets = m_activeOffsets;
+    checkpoint.activePlane = m_activePlane;
+    checkpoint.minimumExtents = m_minimumExtents;
+    checkpoint.maximumExtents = m_maximumExtents;
+    m_checkpoints.append(checkpoint);
 }
 
 void QGLPathItem::modelDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
@@ -901,7 +908,7 @@ void QGLPathItem::modelDataChanged(const QModelIndex &topLeft, const QModelIndex
     {
         QList<PathItem*> pathItemList;
 
-        pathItemList = m_modelPathMap.values(topLeft);
+        pathItemList = m_modelPathMap.values(topLeft.row());
         if (!pathItemList.isEmpty())
         {
             m_modifiedPathItems.append(pathItemList);
@@ -910,6 +917,55 @@ void QGLPathItem::modelDataChanged(const QModelIndex &topLeft, const QModelIndex
     }
 }
 
+void QGLPathItem::modelRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    Q_UNUSED(parent)
+    shiftRows(first, last, last - first + 1);
+}
+
+void QGLPathItem::modelRowsRemoved(const QModelIndex &parent, int first, int last)
+{
+    Q_UNUSED(parent)
+    shiftRows(first, last, -(last - first + 1));
+}
+
+/** Moves the path items behind an inserted or removed block of rows
+ *  to their new rows. Items of removed rows are detached from the model
+ *  until the path is updated. Checkpoints behind the block refer to
+ *  the old rows and are dropped, updatePath restarts before the block.
+ **/
+void QGLPathItem::shiftRows(int first, int last, int offset)
+{
+    QMultiMap<int, PathItem*> modelPathMap;
+
+    for (int i = 0; i < m_previewPathItems.size(); ++i)
+    {
+        PathItem *pathItem = m_previewPathItems.at(i);
+        if (pathItem->modelRow >= first)
+        {
+            if ((offset < 0) && (pathItem->modelRow <= last))
+            {
+                pathItem->modelRow = -1;
+            }
+            else
+            {
+                pathItem->modelRow += offset;
+            }
+        }
+
+        if (pathItem->modelRow != -1)
+        {
+            modelPathMap.insertMulti(pathItem->modelRow, pathItem);
+        }
+    }
+    m_modelPathMap = modelPathMap;
+
+    while (!m_checkpoints.isEmpty() && (m_checkpoints.last().row > first))
+    {
+        m_checkpoints.removeLast();
+    }
+}
+
 void QGLPathItem::triggerFullUpdate()
 {
     m_needsFullUpdate = true;
@@ -25,7 +25,7 @@
 
 #include "qglitem.h"
 #include "qgcodeprogrammodel.h"
-#include <machinetalk/protobuf/preview.pb.h>
+#include "previewrecord.h"
 
 class QGLPathItem : public QGLItem
 {
@@ -41,6 +41,7 @@ class QGLPathItem : public QGLItem
     Q_PROPERTY(QGCodeProgramModel *model READ model WRITE setModel NOTIFY modelChanged)
     Q_PROPERTY(QVector3D minimumExtents READ minimumExtents NOTIFY minimumExtentsChanged)
     Q_PROPERTY(QVector3D maximumExtents READ maximumExtents NOTIFY maximumExtentsChanged)
+    Q_PROPERTY(double unitScale READ unitScale WRITE setUnitScale NOTIFY unitScaleChanged)
 
 public:
     explicit QGLPathItem(QQuickItem *parent = 0);
@@ -59,6 +60,7 @@ public:
     QColor activeColor() const;
     QVector3D minimumExtents() const;
     QVector3D maximumExtents() const;
+    double unitScale() const;
 
 public slots:
     virtual void selectDrawable(void *pointer);
@@ -72,18 +74,13 @@ public slots:
     void setBackplotStraightFeedColor(QColor arg);
     void setBackplotTraverseColor(QColor arg);
     void setActiveColor(QColor arg);
+    void setUnitScale(double arg);
 
 private:
     struct Position {
         double x;
         double y;
         double z;
-        double a;
-        double b;
-        double c;
-        double u;
-        double v;
-        double w;
     };
 
     struct Offsets {
@@ -117,12 +114,13 @@ private:
         PathItem():
             pathType(Line),
             movementType(FeedMove),
+            modelRow(-1),
             drawablePointer(NULL){}
 
         PathType pathType;
         MovementType movementType;
         QVector3D position;
-        QModelIndex modelIndex;
+        int modelRow;   // row of the model the item belongs to, -1 if the row was removed
         void *drawablePointer;
     };
 
@@ -158,6 +156,16 @@ private:
         Plane rotationPlane;
     };
 
+    struct Checkpoint {
+        int row;
+        int pathItemCount;
+        Position currentPosition;
+        Offsets activeOffsets;
+        Plane activePlane;
+        QVector3D minimumExtents;
+        QVector3D maximumExtents;
+    };
+
     QGCodeProgramModel * m_model;
     QColor m_arcFeedColor;
     QColor m_straightFeedColor;
@@ -167,14 +175,16 @@ private:
     QColor m_backplotTraverseColor;
     QColor m_selectedColor;
     QColor m_activeColor;
+    double m_unitScale;     // from the inch based preview to displayed units
 
     Offsets m_activeOffsets;
     Position m_currentPosition;
     Plane m_activePlane;
     QList<PathItem*> m_previewPathItems;
-    QModelIndex m_currentModelIndex;
-    QMultiMap<QModelIndex, PathItem*> m_modelPathMap;  // for mapping the model to internal items
+    int m_currentModelRow;
+    QMultiMap<int, PathItem*> m_modelPathMap;  // for mapping model rows to internal items, shifted when rows are inserted or removed
     QMap<void*, PathItem*> m_drawablePathMap;  // for mapping GL views drawables to internal items
+    QList<Checkpoint> m_checkpoints;  // processing state at regular rows, for partial updates
     void* m_previousSelectedDrawable;
 
     bool m_needsFullUpdate;
@@ -189,20 +199,26 @@ private:
     void resetExtents();
     void updateExtents(const QVector3D &vector);
     void releaseExtents();
-    void processPreview(const pb::Preview &preview);
-    void processStraightMove(const pb::Preview &preview, MovementType movementType);
-    void processArcFeed(const pb::Preview &preview);
-    void processSetG5xOffset(const pb::Preview &preview);
-    void processSetG92Offset(const pb::Preview &preview);
-    void processUseToolOffset(const pb::Preview &preview);
-    void processSelectPlane(const pb::Preview &preview);
-    Position previewPositionToPosition(const pb::Position &position) const;
-    Position calculateNewPosition(const pb::Position &newPosition) const;
+    void processRows(int firstRow);
+    void addCheckpoint(int row);
+    void shiftRows(int first, int last, int offset);
+    void processPreview(const PreviewRecord &preview);
+    void processStraightMove(const PreviewRecord &preview, MovementType movementType);
+    void processArcFeed(const PreviewRecord &preview);
+    void processSetG5xOffset(const PreviewRecord &preview);
+    void processSetG92Offset(const PreviewRecord &preview);
+    void processUseToolOffset(const PreviewRecord &preview);
+    void processSelectPlane(const PreviewRecord &preview);
+    Position previewPositionToPosition(const PreviewRecord &preview) const;
+    Position calculateNewPosition(const PreviewRecord &preview) const;
     QVector3D positionToVector3D(const Position &position) const;
 
 private slots:
     void drawPath();
+    void updatePath(int firstRow);
     void modelDataChanged(const QModelIndex & topLeft, const QModelIndex & bottomRight, const QVector<int> & roles);
+    void modelRowsInserted(const QModelIndex &parent, int first, int last);
+    void modelRowsRemoved(const QModelIndex &parent, int first, int last);
     void triggerFullUpdate();
 
 signals:
@@ -218,6 +234,7 @@ signals:
     void backplotArcFeedColorChanged(QColor arg);
     void backplotStraightFeedColorChanged(QColor arg);
     void backplotTraverseColorChanged(QColor arg);
+    void unitScaleChanged(double arg);
 };
 
 #endif // QGLPATHITEM_H
@@ -0,0 +1,299 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+
+#include "qpreviewcache.h"
+
+static const quint32 cacheMagic = 0x4d4b5043;  // MKPC
+static const quint32 cacheVersion = 3;    // 2: lengths stored in inches, 3: keyed by file path
+
+QPreviewCache::QPreviewCache(QObject *parent) :
+    QObject(parent),
+    m_model(NULL),
+    m_maximumSize(256 * 1024 * 1024)
+{
+    QString basePath;
+#ifndef PORTABLE
+    basePath = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+#else
+    basePath = QDir::currentPath();
+#endif
+    m_cachePath = QDir(basePath).filePath("preview");
+}
+
+/** Tries to load the preview of a program file from the cache.
+ *  On a cache hit the preview records are inserted into the model
+ *  and true is returned. The program is only hashed if its size and
+ *  modification time match the entry.
+ **/
+bool QPreviewCache::load(const QString &localFilePath, const QString &remoteFilePath)
+{
+    if (m_model == NULL)
+    {
+        return false;
+    }
+
+    QFileInfo fileInfo(QUrl(localFilePath).toLocalFile());
+    if (!fileInfo.isFile())
+    {
+        return false;
+    }
+
+    QString filePath = cacheFilePath(fileInfo);
+
+    QFile file(filePath);
+    if (!file.exists() || !file.open(QIODevice::ReadWrite))
+    {
+        return false;
+    }
+
+    if (file.size() < (qint64)sizeof(CacheHeader))
+    {
+        file.remove();
+        return false;
+    }
+
+    uchar *data = file.map(0, file.size());
+    if (data == NULL)
+    {
+        return false;
+    }
+
+    CacheHeader *header = reinterpret_cast<CacheHeader*>(data);
+    if ((header->magic != cacheMagic)
+            || (header->version != cacheVersion)
+            || (header->recordSize != sizeof(PreviewRecord))
+            || (file.size() != (qint64)(sizeof(CacheHeader) + header->recordCount * sizeof(PreviewRecord))))
+    {
+        file.unmap(data);
+        file.remove();  // stale or corrupted entry
+        return false;
+    }
+
+    if ((header->fileSize != fileInfo.size())
+            || (header->fileModified != fileInfo.lastModified().toMSecsSinceEpoch())
+            || (QByteArray(header->fileHash, sizeof(header->fileHash)) != fileHash(fileInfo)))
+    {
+        file.unmap(data);   // the program changed, the entry is replaced by the next store
+        return false;
+    }
+
+    const PreviewRecord *records = reinterpret_cast<const PreviewRecord*>(data + sizeof(CacheHeader));
+
+    m_model->beginUpdate();
+    m_model->addPreview(remoteFilePath, records, header->recordCount);
+
+    header->lastUsed = QDateTime::currentMSecsSinceEpoch();
+    file.unmap(data);
+    file.close();
+    m_model->endUpdate();
+
+    return true;
+}
+
+/** Stores the current preview of a program file from the model in the cache. */
+bool QPreviewCache::store(const QString &localFilePath, const QString &remoteFilePath)
+{
+    if (m_model == NULL)
+    {
+        return false;
+    }
+
+    QFileInfo fileInfo(QUrl(localFilePath).toLocalFile());
+    QByteArray hash = fileHash(fileInfo);
+    if (hash.isEmpty())
+    {
+        return false;
+    }
+
+    QString filePath = cacheFilePath(fileInfo);
+
+    PreviewRecordList records;
+    for (int lineNumber = 1; ; ++lineNumber)
+    {
+        QModelIndex index;
+        PreviewRecordList *previewList;
+
+        index = m_model->index(remoteFilePath, lineNumber);
+        if (!index.isValid())
+        {
+            break;
+        }
+
+        previewList = static_cast<PreviewRecordList*>(m_model->data(index, QGCodeProgramModel::PreviewRole).value<void*>());
+        if (previewList != NULL)
+        {
+            records += *previewList;
+        }
+    }
+
+    if (records.isEmpty())
+    {
+        return false;
+    }
+
+    QDir dir;
+    if (!dir.mkpath(m_cachePath))
+    {
+        return false;
+    }
+
+    CacheHeader header;
+    header.magic = cacheMagic;
+    header.version = cacheVersion;
+    header.recordSize = sizeof(PreviewRecord);
+    header.recordCount = records.size();
+    header.lastUsed = QDateTime::currentMSecsSinceEpoch();
+    header.fileSize = fileInfo.size();
+    header.fileModified = fileInfo.lastModified().toMSecsSinceEpoch();
+    memcpy(header.fileHash, hash.constData(), sizeof(header.fileHash));
+
+    // write to a temporary file first to never leave a partial entry behind
+    QFile file(filePath + ".tmp");
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    qint64 size = records.size() * sizeof(PreviewRecord);
+    if ((file.write(reinterpret_cast<const char*>(&header), sizeof(CacheHeader)) != (qint64)sizeof(CacheHeader))
+            || (file.write(reinterpret_cast<const char*>(records.constData()), size) != size))
+    {
+        file.close();
+        file.remove();
+        return false;
+    }
+    file.close();
+
+    QFile::remove(filePath);
+    if (!file.rename(filePath))
+    {
+        file.remove();
+        return false;
+    }
+
+    evict();
+
+    return true;
+}
+
+/** Removes all entries from the cache */
+void QPreviewCache::clear()
+{
+    QDir dir(m_cachePath);
+    QStringList fileNames = dir.entryList(QStringList() << "*.preview", QDir::Files);
+
+    for (int i = 0; i < fileNames.size(); ++i)
+    {
+        dir.remove(fileNames.at(i));
+    }
+}
+
+/** The cache key is built from the path of the program and the
+ *  interpreter parameters that have an influence on the preview.
+ *  The content of the program is checked against the entry header.
+ **/
+QString QPreviewCache::cacheFilePath(const QFileInfo &fileInfo) const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArray::number(cacheVersion));
+    hash.addData(QByteArray::number((int)sizeof(PreviewRecord)));
+    hash.addData(fileInfo.absoluteFilePath().toUtf8());
+    hash.addData(QJsonDocument(m_parameters).toJson(QJsonDocument::Compact));
+
+    return QDir(m_cachePath).filePath(QString::fromLatin1(hash.result().toHex()) + ".preview");
+}
+
+/** Returns the SHA-1 of a program file. The hash is kept until the size
+ *  or the modification time of the file changes, so a program is hashed
+ *  once and not on every load and store.
+ **/
+QByteArray QPreviewCache::fileHash(const QFileInfo &fileInfo)
+{
+    QString path = fileInfo.absoluteFilePath();
+    qint64 modified = fileInfo.lastModified().toMSecsSinceEpoch();
+    QHash<QString, FileDigest>::const_iterator it = m_digests.constFind(path);
+
+    if ((it != m_digests.constEnd()) && (it->size == fileInfo.size()) && (it->modified == modified))
+    {
+        return it->hash;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        m_digests.remove(path);
+        return QByteArray();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(&file);
+    file.close();
+
+    FileDigest digest;
+    digest.size = fileInfo.size();
+    digest.modified = modified;
+    digest.hash = hash.result();
+    m_digests.insert(path, digest);
+
+    return digest.hash;
+}
+
+/** Removes the least recently used entries until the cache fits into maximumSize */
+void QPreviewCache::evict()
+{
+    QDir dir(m_cachePath);
+    QFileInfoList fileInfos = dir.entryInfoList(QStringList() << "*.preview", QDir::Files);
+    QMultiMap<qint64, QString> usageMap;
+    qint64 totalSize = 0;
+
+    for (int i = 0; i < fileInfos.size(); ++i)
+    {
+        const QFileInfo &fileInfo = fileInfos.at(i);
+        CacheHeader header;
+        qint64 lastUsed = 0;
+
+        QFile file(fileInfo.filePath());
+        if (file.open(QIODevice::ReadOnly)
+                && (file.read(reinterpret_cast<char*>(&header), sizeof(CacheHeader)) == (qint64)sizeof(CacheHeader))
+                && (header.magic == cacheMagic))
+        {
+            lastUsed = header.lastUsed;
+        }
+        file.close();
+
+        totalSize += fileInfo.size();
+        usageMap.insert(lastUsed, fileInfo.filePath());
+    }
+
+    QMultiMap<qint64, QString>::const_iterator it = usageMap.constBegin();
+    while ((totalSize > m_maximumSize) && (it != usageMap.constEnd()))
+    {
+        QFileInfo fileInfo(it.value());
+        qint64 size = fileInfo.size();
+        if (QFile::remove(it.value()))
+        {
+            totalSize -= size;
+        }
+        ++it;
+    }
+}
@@ -0,0 +1,148 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+
+#ifndef QPREVIEWCACHE_H
+#define QPREVIEWCACHE_H
+
+#include <QObject>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QUrl>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QMap>
+#include <QHash>
+#include "qgcodeprogrammodel.h"
+#include "previewrecord.h"
+
+class QPreviewCache : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QGCodeProgramModel *model READ model WRITE setModel NOTIFY modelChanged)
+    Q_PROPERTY(QString cachePath READ cachePath WRITE setCachePath NOTIFY cachePathChanged)
+    Q_PROPERTY(qint64 maximumSize READ maximumSize WRITE setMaximumSize NOTIFY maximumSizeChanged)
+    Q_PROPERTY(QJsonObject parameters READ parameters WRITE setParameters NOTIFY parametersChanged)
+
+public:
+    explicit QPreviewCache(QObject *parent = 0);
+
+    QGCodeProgramModel * model() const
+    {
+        return m_model;
+    }
+
+    QString cachePath() const
+    {
+        return m_cachePath;
+    }
+
+    qint64 maximumSize() const
+    {
+        return m_maximumSize;
+    }
+
+    QJsonObject parameters() const
+    {
+        return m_parameters;
+    }
+
+signals:
+    void modelChanged(QGCodeProgramModel * arg);
+    void cachePathChanged(QString arg);
+    void maximumSizeChanged(qint64 arg);
+    void parametersChanged(QJsonObject arg);
+
+public slots:
+    bool load(const QString &localFilePath, const QString &remoteFilePath);
+    bool store(const QString &localFilePath, const QString &remoteFilePath);
+    void clear();
+
+    void setModel(QGCodeProgramModel * arg)
+    {
+        if (m_model != arg) {
+            m_model = arg;
+            emit modelChanged(arg);
+        }
+    }
+
+    void setCachePath(QString arg)
+    {
+        if (m_cachePath == arg)
+            return;
+
+        m_cachePath = arg;
+        emit cachePathChanged(arg);
+    }
+
+    void setMaximumSize(qint64 arg)
+    {
+        if (m_maximumSize == arg)
+            return;
+
+        m_maximumSize = arg;
+        emit maximumSizeChanged(arg);
+    }
+
+    void setParameters(QJsonObject arg)
+    {
+        if (m_parameters == arg)
+            return;
+
+        m_parameters = arg;
+        emit parametersChanged(arg);
+    }
+
+private:
+    struct CacheHeader {
+        quint32 magic;
+        quint32 version;
+        quint32 recordSize;
+        quint32 recordCount;
+        qint64  lastUsed;   // msecs since epoch, used for LRU eviction
+        qint64  fileSize;   // size of the program file
+        qint64  fileModified;   // modification time of the program file in msecs since epoch
+        char    fileHash[20];   // SHA-1 of the program file
+    };
+
+    struct FileDigest {
+        qint64 size;
+        qint64 modified;
+        QByteArray hash;
+    };
+
+    QGCodeProgramModel *m_model;
+    QString m_cachePath;
+    qint64 m_maximumSize;
+    QJsonObject m_parameters;
+    QHash<QString, FileDigest> m_digests;
+
+    QString cacheFilePath(const QFileInfo &fileInfo) const;
+    QByteArray fileHash(const QFileInfo &fileInfo);
+    void evict();
+};
+
+#endif // QPREVIEWCACHE_H
@@ -34,9 +34,6 @@ QPreviewClient::QPreviewClient(QObject *parent) :
     m_model(NULL),
     m_interpreterState(InterpreterStateUnset),
     m_interpreterNote(""),
-    m_units(CanonUnitsInches),
-    m_convertFactor(1.0),
-    m_context(NULL),
     m_statusSocket(NULL),
     m_previewSocket(NULL),
     m_previewUpdated(false)
@@ -45,29 +42,6 @@ QPreviewClient::QPreviewClient(QObject *parent) :
     m_previewStatus.lineNumber = 0;
 }
 
-void QPreviewClient::setUnits(QPreviewClient::CanonUnits arg)
-{
-    if (m_units == arg)
-        return;
-
-    switch (arg) {
-    case CanonUnitsInches:
-        m_convertFactor = 1.0;
-        break;
-    case CanonUnitsMm:
-        m_convertFactor = 25.4;
-        break;
-    case CanonUnitsCm:
-        m_convertFactor = 2.54;
-        break;
-    default:
-        m_convertFactor = 1.0;
-    }
-
-    m_units = arg;
-    emit unitsChanged(arg);
-}
-
 void QPreviewClient::start()
 {
 #ifdef QT_DEBUG
@@ -138,30 +112,90 @@ void QPreviewClient::updateError(QPreviewClient::ConnectionError error, QString
     }
 }
 
-double QPreviewClient::convertValue(double value)
+/** Decodes a preview message into a compact preview record.
+ *  Lengths are kept in inches, the unit of the preview messages.
+ *  Returns false if the preview type is not relevant for drawing the path.
+ **/
+bool QPreviewClient::decodePreview(const pb::Preview &preview, PreviewRecord *record)
 {
-    return value * m_convertFactor;
-}
+    record->axes = 0;
+    record->reserved = 0;
+    record->lineNumber = m_previewStatus.lineNumber;
+    record->pos[0] = 0.0;
+    record->pos[1] = 0.0;
+    record->pos[2] = 0.0;
+    record->center[0] = 0.0;
+    record->center[1] = 0.0;
+    record->rotation = 0;
+
+    switch (preview.type())
+    {
+    case pb::PV_STRAIGHT_TRAVERSE: record->type = PreviewRecord::StraightTraverse; break;
+    case pb::PV_STRAIGHT_FEED: record->type = PreviewRecord::StraightFeed; break;
+    case pb::PV_ARC_FEED: record->type = PreviewRecord::ArcFeed; break;
+    case pb::PV_SET_G5X_OFFSET: record->type = PreviewRecord::SetG5xOffset; break;
+    case pb::PV_SET_G92_OFFSET: record->type = PreviewRecord::SetG92Offset; break;
+    case pb::PV_USE_TOOL_OFFSET: record->type = PreviewRecord::UseToolOffset; break;
+    case pb::PV_SELECT_PLANE: record->type = PreviewRecord::SelectPlane; break;
+    default: return false;
+    }
 
-void QPreviewClient::convertPos(pb::Position *position)
-{
-    position->set_x(convertValue(position->x()));
-    position->set_y(convertValue(position->y()));
-    position->set_z(convertValue(position->z()));
-    position->set_a(convertValue(position->a()));
-    position->set_b(convertValue(position->b()));
-    position->set_c(convertValue(position->c()));
-    position->set_u(convertValue(position->u()));
-    position->set_v(convertValue(position->v()));
-    position->set_w(convertValue(position->w()));
+    if (record->type == PreviewRecord::ArcFeed)
+    {
+        record->pos[0] = preview.first_end();
+        record->pos[1] = preview.second_end();
+        record->pos[2] = preview.axis_end_point();
+        record->center[0] = preview.first_axis();
+        record->center[1] = preview.second_axis();
+        record->rotation = preview.rotation();
+        record->axes = PreviewRecord::XAxis | PreviewRecord::YAxis | PreviewRecord::ZAxis;
+        return true;
+    }
+
+    if (record->type == PreviewRecord::SelectPlane)
+    {
+        if (!preview.has_plane())
+        {
+            return false;
+        }
+        record->plane = preview.plane();
+        return true;
+    }
+
+    if (!preview.has_pos())
+    {
+        return (record->type == PreviewRecord::StraightFeed)
+                || (record->type == PreviewRecord::StraightTraverse);
+    }
+
+    const pb::Position &position = preview.pos();
+    if (position.has_x()) {
+        record->pos[0] = position.x();
+        record->axes |= PreviewRecord::XAxis;
+    }
+    if (position.has_y()) {
+        record->pos[1] = position.y();
+        record->axes |= PreviewRecord::YAxis;
+    }
+    if (position.has_z()) {
+        record->pos[2] = position.z();
+        record->axes |= PreviewRecord::ZAxis;
+    }
+
+    if (record->type == PreviewRecord::SetG5xOffset)
+    {
+        record->g5Index = preview.g5_index();
+    }
+
+    return true;
 }
 
 /** Processes all message received on the status 0MQ socket */
-void QPreviewClient::statusMessageReceived(QList<QByteArray> messageList)
+void QPreviewClient::statusMessageReceived(const ThreadedZMQFrameList &messageList)
 {
     QByteArray topic;
 
-    topic = messageList.at(0);
+    topic = messageList.at(0).toByteArray();
     m_rx.ParseFromArray(messageList.at(1).data(), messageList.at(1).size());
 
     #ifdef QT_DEBUG
@@ -194,11 +228,11 @@ void QPreviewClient::statusMessageReceived(QList<QByteArray> messageList)
 }
 
 /** Processes all message received on the preview 0MQ socket */
-void QPreviewClient::previewMessageReceived(QList<QByteArray> messageList)
+void QPreviewClient::previewMessageReceived(const ThreadedZMQFrameList &messageList)
 {
     QByteArray topic;
 
-    topic = messageList.at(0);
+    topic = messageList.at(0).toByteArray();
     m_rx.ParseFromArray(messageList.at(1).data(), messageList.at(1).size());
 
     #ifdef QT_DEBUG
@@ -216,10 +250,9 @@ void QPreviewClient::previewMessageReceived(QList<QByteArray> messageList)
 
         for (int i = 0; i < m_rx.preview_size(); ++i)
         {
-            QList<pb::Preview> *previewList;
-            pb::Preview preview;
-
-            preview = m_rx.preview(i);
+            PreviewRecordList *previewList;
+            PreviewRecord record;
+            const pb::Preview &preview = m_rx.preview(i);
 
             if (preview.has_line_number())
             {
@@ -231,45 +264,20 @@ void QPreviewClient::previewMessageReceived(QList<QByteArray> messageList)
                 m_previewStatus.fileName = QString::fromStdString(preview.filename());
             }
 
-            if (preview.has_pos())
-            {
-                convertPos(preview.mutable_pos());  // messages come always with unit inches
-            }
-
-            if (preview.has_first_axis())
-            {
-                preview.set_first_axis(convertValue(preview.first_axis()));
-            }
-
-            if (preview.has_second_axis())
-            {
-                preview.set_second_axis(convertValue(preview.second_axis()));
-            }
-
-            if (preview.has_first_end())
-            {
-                preview.set_first_end(convertValue(preview.first_end()));
-            }
-
-            if (preview.has_second_end())
-            {
-                preview.set_second_end(convertValue(preview.second_end()));
-            }
-
-            if (preview.has_axis_end_point())
+            if (!decodePreview(preview, &record))
             {
-                preview.set_axis_end_point(convertValue(preview.axis_end_point()));
+                continue;
             }
 
-            previewList = static_cast<QList<pb::Preview>*>(m_model->data(m_previewStatus.fileName,
-                                                                         m_previewStatus.lineNumber,
-                                                                         QGCodeProgramModel::PreviewRole).value<void*>());
+            previewList = static_cast<PreviewRecordList*>(m_model->data(m_previewStatus.fileName,
+                                                                        m_previewStatus.lineNumber,
+                                                                        QGCodeProgramModel::PreviewRole).value<void*>());
             if (previewList == NULL)
             {
-                previewList = new QList<pb::Preview>();
+                previewList = new PreviewRecordList();
             }
 
-            previewList->append(preview);
+            previewList->append(record);
 
             m_model->setData(m_previewStatus.fileName, m_previewStatus.lineNumber,
                              QVariant::fromValue(static_cast<void*>(previewList)),
@@ -290,15 +298,14 @@ void QPreviewClient::pollError(int errorNum, const QString &errorMsg)
 /** Connects the 0MQ sockets */
 bool QPreviewClient::connectSockets()
 {
-    m_context = new PollingZMQContext(this, 1);
-    connect(m_context, SIGNAL(pollError(int,QString)),
+    m_statusSocket = TransportManager::instance()->createSocket(ZMQSocket::TYP_SUB, "previewstatus", this);
+    connect(m_statusSocket, SIGNAL(receiveError(int,QString)),
             this, SLOT(pollError(int,QString)));
-    m_context->start();
-
-    m_statusSocket = m_context->createSocket(ZMQSocket::TYP_SUB, this);
     m_statusSocket->setLinger(0);
 
-    m_previewSocket = m_context->createSocket(ZMQSocket::TYP_SUB, this);
+    m_previewSocket = TransportManager::instance()->createSocket(ZMQSocket::TYP_SUB, "preview", this);
+    connect(m_previewSocket, SIGNAL(receiveError(int,QString)),
+            this, SLOT(pollError(int,QString)));
     m_previewSocket->setLinger(0);
 
     try {
@@ -312,10 +319,10 @@ bool QPreviewClient::connectSockets()
         return false;
     }
 
-    connect(m_statusSocket, SIGNAL(messageReceived(QList<QByteArray>)),
-            this, SLOT(statusMessageReceived(QList<QByteArray>)));
-    connect(m_previewSocket, SIGNAL(messageReceived(QList<QByteArray>)),
-            this, SLOT(previewMessageReceived(QList<QByteArray>)));
+    connect(m_statusSocket, SIGNAL(framesReceived(ThreadedZMQFrameList)),
+            this, SLOT(statusMessageReceived(ThreadedZMQFrameList)));
+    connect(m_previewSocket, SIGNAL(framesReceived(ThreadedZMQFrameList)),
+            this, SLOT(previewMessageReceived(ThreadedZMQFrameList)));
 
 #ifdef QT_DEBUG
     DEBUG_TAG(1, "preview", "sockets connected" << m_statusUri << m_previewUri)
@@ -340,11 +347,4 @@ void QPreviewClient::disconnectSockets()
         m_previewSocket->deleteLater();
         m_previewSocket = NULL;
     }
-
-    if (m_context != NULL)
-    {
-        m_context->stop();
-        m_context->deleteLater();
-        m_context = NULL;
-    }
 }
@@ -26,7 +26,9 @@
 #include <google/protobuf/text_format.h>
 #include <abstractserviceimplementation.h>
 #include <nzmqt/nzmqt.hpp>
+#include <transportmanager.h>
 #include "qgcodeprogrammodel.h"
+#include "previewrecord.h"
 #include <machinetalk/protobuf/message.pb.h>
 
 #if defined(Q_OS_IOS)
@@ -50,7 +52,6 @@ class QPreviewClient : public AbstractServiceImplementation
     Q_PROPERTY(QGCodeProgramModel *model READ model WRITE setModel NOTIFY modelChanged)
     Q_PROPERTY(InterpreterState interpreterState READ interpreterState NOTIFY interpreterStateChanged)
     Q_PROPERTY(QString interpreterNote READ interpreterNote NOTIFY interpreterNoteChanged)
-    Q_PROPERTY(CanonUnits units READ units WRITE setUnits NOTIFY unitsChanged)
     Q_ENUMS(State ConnectionError InterpreterState CanonUnits)
 
 public:
@@ -131,11 +132,6 @@ public:
         return m_connected;
     }
 
-    CanonUnits units() const
-    {
-        return m_units;
-    }
-
 public slots:
 
     void setStatusUri(QString arg)
@@ -162,8 +158,6 @@ public slots:
         }
     }
 
-    void setUnits(CanonUnits arg);
-
 private:
     typedef struct {
         QString fileName;
@@ -179,12 +173,9 @@ private:
     QGCodeProgramModel *m_model;
     InterpreterState    m_interpreterState;
     QString             m_interpreterNote;
-    CanonUnits          m_units;
-    double              m_convertFactor;
 
-    PollingZMQContext *m_context;
-    ZMQSocket  *m_statusSocket;
-    ZMQSocket  *m_previewSocket;
+    ThreadedZMQSocket  *m_statusSocket;
+    ThreadedZMQSocket  *m_previewSocket;
     // more efficient to reuse a protobuf Message
     pb::Container   m_rx;
 
@@ -198,12 +189,11 @@ private:
     void updateState(State state, ConnectionError error, QString errorString);
     void updateError(ConnectionError error, QString errorString);
 
-    double convertValue(double value);
-    void convertPos(pb::Position *position);
+    bool decodePreview(const pb::Preview &preview, PreviewRecord *record);
 
 private slots:
-    void statusMessageReceived(QList<QByteArray> messageList);
-    void previewMessageReceived(QList<QByteArray> messageList);
+    void statusMessageReceived(const ThreadedZMQFrameList &messageList);
+    void previewMessageReceived(const ThreadedZMQFrameList &messageList);
     void pollError(int errorNum, const QString& errorMsg);
 
     bool connectSockets();
@@ -219,7 +209,6 @@ signals:
     void interpreterStateChanged(InterpreterState arg);
     void interpreterNoteChanged(QString arg);
     void connectedChanged(bool arg);
-    void unitsChanged(CanonUnits arg);
 };
 
 #endif // QPREVIEWCLIENT_H
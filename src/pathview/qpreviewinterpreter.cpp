@@ -0,0 +1,794 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+
+#include "qpreviewinterpreter.h"
+#include <QtCore/qmath.h>
+#include "debughelper.h"
+
+static const int cancelCheckInterval = 1000;  // lines
+static const int checkpointInterval = 500;    // lines
+
+static bool equalState(const PreviewInterpreterState &a, const PreviewInterpreterState &b)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        if ((a.position[i] != b.position[i])
+                || (a.g92Offset[i] != b.g92Offset[i])
+                || (a.toolOffset[i] != b.toolOffset[i])) {
+            return false;
+        }
+        for (int j = 0; j < 9; ++j)
+        {
+            if (a.g5xOffsets[j][i] != b.g5xOffsets[j][i]) {
+                return false;
+            }
+        }
+    }
+
+    for (int j = 0; j < 9; ++j)
+    {
+        if (a.g5xKnown[j] != b.g5xKnown[j]) {
+            return false;
+        }
+    }
+
+    return (a.g5xIndex == b.g5xIndex)
+            && (a.plane == b.plane)
+            && (a.motionMode == b.motionMode)
+            && (a.toolNumber == b.toolNumber)
+            && (a.selectedTool == b.selectedTool)
+            && (a.absolute == b.absolute)
+            && (a.absoluteArcs == b.absoluteArcs)
+            && (a.metric == b.metric);
+}
+
+QPreviewInterpreterWorker::QPreviewInterpreterWorker(QAtomicInt *currentRequestId, QObject *parent) :
+    QObject(parent),
+    m_currentRequestId(currentRequestId),
+    m_machineToInch(1.0 / 25.4),
+    m_lineNumber(0),
+    m_programEnded(false)
+{
+}
+
+/** Interprets a G-code file and produces the preview records for it.
+ *  If the program uses a feature not supported by the local interpreter
+ *  supported is false and the remote preview has to be used instead.
+ *  When the program was interpreted before with the same start state the
+ *  interpreter resumes from the last checkpoint before firstLine and only
+ *  the records from this checkpoint on are emitted.
+ **/
+void QPreviewInterpreterWorker::interpret(int requestId, const QString &filePath, int firstLine, const PreviewInterpreterState &state,
+                                          const QJsonArray &toolTable, double machineToInch)
+{
+    int checkpoint = 0;
+
+    if (canResume(filePath, state, toolTable, machineToInch))
+    {
+        checkpoint = qBound(0, (firstLine - 1) / checkpointInterval, m_checkpoints.size() - 1);
+    }
+    else
+    {
+        m_checkpoints.clear();
+        m_checkpoints.append(state);
+    }
+
+    m_checkpointFilePath = filePath;
+    m_checkpoints.resize(checkpoint + 1);
+    m_state = m_checkpoints.last();
+    m_toolTable = toolTable;
+    m_machineToInch = machineToInch;
+    m_lineNumber = 1;
+    m_programEnded = false;
+    m_records.clear();
+
+    int resumeLine = checkpoint * checkpointInterval + 1;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        m_checkpoints.clear();
+        emit finished(requestId, PreviewRecordList(), false, 0, 1);
+        return;
+    }
+
+    if (resumeLine == 1)
+    {
+        // initial state of the interpreter goes to the first line
+        addG5xOffsetRecord();
+        addRecord(PreviewRecord::SetG92Offset, m_state.g92Offset, PreviewRecord::XAxis | PreviewRecord::YAxis | PreviewRecord::ZAxis);
+        addRecord(PreviewRecord::UseToolOffset, m_state.toolOffset, PreviewRecord::XAxis | PreviewRecord::YAxis | PreviewRecord::ZAxis);
+        addPlaneRecord();
+    }
+
+    m_lineNumber = 0;
+    while (!file.atEnd() && !m_programEnded)
+    {
+        QByteArray line = file.readLine();
+        Block block;
+
+        m_lineNumber++;
+
+        if (m_lineNumber < resumeLine) {
+            continue;
+        }
+
+        if (((m_lineNumber % cancelCheckInterval) == 0)
+                && (m_currentRequestId->load() != requestId))
+        {
+            m_checkpoints.resize(1);
+            return; // a newer request is pending, drop this one
+        }
+
+        if ((m_lineNumber > resumeLine) && (((m_lineNumber - 1) % checkpointInterval) == 0))
+        {
+            m_checkpoints.append(m_state);
+        }
+
+        if (!parseLine(line, &block) || !executeBlock(block))
+        {
+#ifdef QT_DEBUG
+            DEBUG_TAG(1, "interpreter", "unsupported line" << m_lineNumber << line)
+#endif
+            m_checkpoints.clear();
+            emit finished(requestId, PreviewRecordList(), false, m_lineNumber, 1);
+            return;
+        }
+    }
+
+    file.close();
+    emit finished(requestId, m_records, true, 0, resumeLine);
+    m_records.clear();
+}
+
+/** Forgets the retained checkpoints, the next request starts at the first line. **/
+void QPreviewInterpreterWorker::clearCheckpoints()
+{
+    m_checkpoints.clear();
+    m_checkpointFilePath.clear();
+}
+
+bool QPreviewInterpreterWorker::canResume(const QString &filePath, const PreviewInterpreterState &state,
+                                          const QJsonArray &toolTable, double machineToInch) const
+{
+    return !m_checkpoints.isEmpty()
+            && (m_checkpointFilePath == filePath)
+            && equalState(m_checkpoints.first(), state)
+            && (m_toolTable == toolTable)
+            && (m_machineToInch == machineToInch);
+}
+
+bool QPreviewInterpreterWorker::parseLine(const QByteArray &line, Block *block) const
+{
+    const int size = line.size();
+    int i = 0;
+
+    block->words = 0;
+    block->gCodeCount = 0;
+    block->mCodeCount = 0;
+
+    while (i < size)
+    {
+        char c = line.at(i);
+
+        if ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n') || (c == '%') || (c == '/'))
+        {
+            ++i;    // whitespace, program delimiters and block delete are ignored
+            continue;
+        }
+        else if (c == '(')
+        {
+            int end = line.indexOf(')', i);
+            if (end < 0) {
+                return false;
+            }
+            i = end + 1;
+            continue;
+        }
+        else if (c == ';')
+        {
+            break;
+        }
+
+        if ((c >= 'a') && (c <= 'z')) {
+            c = c - 'a' + 'A';
+        }
+
+        if ((c < 'A') || (c > 'Z') || (c == 'O'))
+        {
+            return false;   // parameters, expressions and O-word control flow are not supported
+        }
+
+        ++i;
+        QByteArray number;
+        while ((i < size)
+               && (((line.at(i) >= '0') && (line.at(i) <= '9'))
+                   || (line.at(i) == '.') || (line.at(i) == ' ')
+                   || (number.trimmed().isEmpty() && ((line.at(i) == '-') || (line.at(i) == '+')))))
+        {
+            if (line.at(i) != ' ') {
+                number.append(line.at(i));
+            }
+            ++i;
+        }
+
+        bool ok;
+        double value = number.toDouble(&ok);
+        if (!ok) {
+            return false;
+        }
+
+        if (c == 'G')
+        {
+            if (block->gCodeCount == 10) {
+                return false;
+            }
+            block->gCodes[block->gCodeCount++] = qRound(value * 10.0);
+        }
+        else if (c == 'M')
+        {
+            if (block->mCodeCount == 10) {
+                return false;
+            }
+            block->mCodes[block->mCodeCount++] = qRound(value);
+        }
+        else
+        {
+            quint32 bit = 1u << (c - 'A');
+            if (block->words & bit) {
+                return false;   // a word may only appear once per line
+            }
+            block->words |= bit;
+            block->values[c - 'A'] = value;
+        }
+    }
+
+    return true;
+}
+
+bool QPreviewInterpreterWorker::hasWord(const Block &block, char letter) const
+{
+    return (block.words & (1u << (letter - 'A'))) != 0;
+}
+
+double QPreviewInterpreterWorker::wordValue(const Block &block, char letter) const
+{
+    return block.values[letter - 'A'];
+}
+
+/** Executes the block in the order used by the RS274NGC interpreter */
+bool QPreviewInterpreterWorker::executeBlock(const Block &block)
+{
+    int plane = 0;
+    int units = 0;
+    int toolLengthMode = 0;
+    int g5xIndex = 0;
+    int g92Mode = 0;
+    bool machineCoordinates = false;
+
+    for (int i = 0; i < block.gCodeCount; ++i)
+    {
+        int code = block.gCodes[i];
+        switch (code)
+        {
+        case 0: m_state.motionMode = PreviewInterpreterState::Traverse; break;
+        case 10: m_state.motionMode = PreviewInterpreterState::Feed; break;
+        case 20: m_state.motionMode = PreviewInterpreterState::ArcClockwise; break;
+        case 30: m_state.motionMode = PreviewInterpreterState::ArcCounterClockwise; break;
+        case 800: m_state.motionMode = PreviewInterpreterState::NoMotion; break;
+        case 40: /* dwell */ break;
+        case 170: plane = 1; break;
+        case 180: plane = 3; break;
+        case 190: plane = 2; break;
+        case 200: units = 20; break;
+        case 210: units = 21; break;
+        case 400: /* cutter compensation off */ break;
+        case 430:
+        case 431:
+        case 490: toolLengthMode = code; break;
+        case 530: machineCoordinates = true; break;
+        case 540: case 550: case 560: case 570: case 580: case 590:
+            g5xIndex = code / 10 - 53;
+            break;
+        case 591: case 592: case 593:
+            g5xIndex = code - 584;
+            break;
+        case 610: case 611: case 640: /* path control */ break;
+        case 900: m_state.absolute = true; break;
+        case 910: m_state.absolute = false; break;
+        case 901: m_state.absoluteArcs = true; break;
+        case 911: m_state.absoluteArcs = false; break;
+        case 920: case 921: case 922: g92Mode = code; break;
+        case 930: case 940: case 950: /* feed mode */ break;
+        case 980: case 990: /* canned cycle return mode */ break;
+        default: return false;
+        }
+    }
+
+    if (hasWord(block, 'T')) {
+        m_state.selectedTool = qRound(wordValue(block, 'T'));
+    }
+
+    for (int i = 0; i < block.mCodeCount; ++i)
+    {
+        switch (block.mCodes[i])
+        {
+        case 2:
+        case 30: m_programEnded = true; break;
+        case 6: m_state.toolNumber = m_state.selectedTool; break;
+        case 61:
+            if (!hasWord(block, 'Q')) {
+                return false;
+            }
+            m_state.toolNumber = qRound(wordValue(block, 'Q'));
+            break;
+        default: break;    // no influence on the path
+        }
+    }
+
+    if (plane != 0)
+    {
+        m_state.plane = plane;
+        addPlaneRecord();
+    }
+
+    if (units != 0) {
+        m_state.metric = (units == 21);
+    }
+
+    if (toolLengthMode == 430)
+    {
+        int toolNumber = hasWord(block, 'H') ? qRound(wordValue(block, 'H')) : m_state.toolNumber;
+        if (!executeToolOffset(toolNumber)) {
+            return false;
+        }
+    }
+    else if ((toolLengthMode == 431) || (toolLengthMode == 490))
+    {
+        double unitFactor = m_state.metric ? (1.0 / 25.4) : 1.0;
+        double toolOffset[3] = {0.0, 0.0, 0.0};
+        if (toolLengthMode == 431)
+        {
+            const char axisLetters[3] = {'X', 'Y', 'Z'};
+            for (int i = 0; i < 3; ++i) {
+                if (hasWord(block, axisLetters[i])) {
+                    toolOffset[i] = wordValue(block, axisLetters[i]) * unitFactor;
+                }
+            }
+        }
+        for (int i = 0; i < 3; ++i) {
+            m_state.position[i] += m_state.toolOffset[i] - toolOffset[i];
+            m_state.toolOffset[i] = toolOffset[i];
+        }
+        addRecord(PreviewRecord::UseToolOffset, m_state.toolOffset, PreviewRecord::XAxis | PreviewRecord::YAxis | PreviewRecord::ZAxis);
+    }
+
+    if ((g5xIndex != 0) && (g5xIndex != m_state.g5xIndex))
+    {
+        if (!m_state.g5xKnown[g5xIndex - 1]) {
+            return false;   // offsets of inactive coordinate systems are only known to the remote interpreter
+        }
+        for (int i = 0; i < 3; ++i) {
+            m_state.position[i] += m_state.g5xOffsets[m_state.g5xIndex - 1][i] - m_state.g5xOffsets[g5xIndex - 1][i];
+        }
+        m_state.g5xIndex = g5xIndex;
+        addG5xOffsetRecord();
+    }
+
+    if (g92Mode != 0)
+    {
+        return executeG92(block, g92Mode);
+    }
+
+    if (toolLengthMode == 431) {
+        return true;    // axis words are used by G43.1
+    }
+
+    return executeMove(block, machineCoordinates);
+}
+
+bool QPreviewInterpreterWorker::executeMove(const Block &block, bool machineCoordinates)
+{
+    const char axisLetters[3] = {'X', 'Y', 'Z'};
+    double unitFactor = m_state.metric ? (1.0 / 25.4) : 1.0;
+    double target[3];
+    bool axisWords = false;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        target[i] = m_state.position[i];
+        if (!hasWord(block, axisLetters[i])) {
+            continue;
+        }
+
+        axisWords = true;
+        double value = wordValue(block, axisLetters[i]) * unitFactor;
+        if (machineCoordinates) {
+            target[i] = value - m_state.g5xOffsets[m_state.g5xIndex - 1][i] - m_state.g92Offset[i] - m_state.toolOffset[i];
+        }
+        else if (m_state.absolute) {
+            target[i] = value;
+        }
+        else {
+            target[i] += value;
+        }
+    }
+
+    switch (m_state.motionMode)
+    {
+    case PreviewInterpreterState::Traverse:
+    case PreviewInterpreterState::Feed:
+        if (!axisWords) {
+            return true;
+        }
+        addRecord((m_state.motionMode == PreviewInterpreterState::Traverse) ? PreviewRecord::StraightTraverse : PreviewRecord::StraightFeed,
+                  target, PreviewRecord::XAxis | PreviewRecord::YAxis | PreviewRecord::ZAxis);
+        for (int i = 0; i < 3; ++i) {
+            m_state.position[i] = target[i];
+        }
+        return true;
+    case PreviewInterpreterState::ArcClockwise:
+    case PreviewInterpreterState::ArcCounterClockwise:
+        if (machineCoordinates) {
+            return false;
+        }
+        if (!axisWords && !hasWord(block, 'I') && !hasWord(block, 'J') && !hasWord(block, 'K') && !hasWord(block, 'R')) {
+            return true;
+        }
+        return executeArc(block, target);
+    default:
+        return !axisWords;  // axis words without active motion mode are an error
+    }
+}
+
+bool QPreviewInterpreterWorker::executeArc(const Block &block, const double target[3])
+{
+    double unitFactor = m_state.metric ? (1.0 / 25.4) : 1.0;
+    bool clockwise = (m_state.motionMode == PreviewInterpreterState::ArcClockwise);
+    int firstAxis;
+    int secondAxis;
+    int helixAxis;
+    char firstOffset;
+    char secondOffset;
+
+    // same axis order as rs274ngc and the remote preview, G18 is (Z,X)
+    switch (m_state.plane)
+    {
+    case 1: firstAxis = 0; secondAxis = 1; helixAxis = 2; firstOffset = 'I'; secondOffset = 'J'; break;
+    case 2: firstAxis = 1; secondAxis = 2; helixAxis = 0; firstOffset = 'J'; secondOffset = 'K'; break;
+    case 3: firstAxis = 2; secondAxis = 0; helixAxis = 1; firstOffset = 'K'; secondOffset = 'I'; break;
+    default: return false;
+    }
+
+    double start1 = m_state.position[firstAxis];
+    double start2 = m_state.position[secondAxis];
+    double end1 = target[firstAxis];
+    double end2 = target[secondAxis];
+    double center1;
+    double center2;
+
+    if (hasWord(block, 'R'))
+    {
+        double radius = wordValue(block, 'R') * unitFactor;
+        double delta1 = end1 - start1;
+        double delta2 = end2 - start2;
+        double chord = qSqrt(delta1 * delta1 + delta2 * delta2);
+
+        if (chord < 1e-9) {
+            return false;   // full circles can not be programmed with radius format
+        }
+
+        double halfChord = chord / 2.0;
+        if (qAbs(radius) < (halfChord - 1e-6)) {
+            return false;   // radius too small to reach the end point
+        }
+
+        double height = qSqrt(qMax(0.0, radius * radius - halfChord * halfChord));
+        // center is on the left side of the chord for counter clockwise arcs with positive radius
+        double side = (clockwise ? -1.0 : 1.0) * ((radius < 0.0) ? -1.0 : 1.0);
+        center1 = (start1 + end1) / 2.0 - side * height * delta2 / chord;
+        center2 = (start2 + end2) / 2.0 + side * height * delta1 / chord;
+    }
+    else
+    {
+        if (!hasWord(block, firstOffset) && !hasWord(block, secondOffset)) {
+            return false;
+        }
+
+        double offset1 = hasWord(block, firstOffset) ? (wordValue(block, firstOffset) * unitFactor) : 0.0;
+        double offset2 = hasWord(block, secondOffset) ? (wordValue(block, secondOffset) * unitFactor) : 0.0;
+        if (m_state.absoluteArcs) {
+            center1 = offset1;
+            center2 = offset2;
+        }
+        else {
+            center1 = start1 + offset1;
+            center2 = start2 + offset2;
+        }
+    }
+
+    int turns = 1;
+    if (hasWord(block, 'P'))
+    {
+        turns = qRound(wordValue(block, 'P'));
+        if (turns < 1) {
+            return false;
+        }
+    }
+
+    PreviewRecord record;
+    record.type = PreviewRecord::ArcFeed;
+    record.axes = PreviewRecord::XAxis | PreviewRecord::YAxis | PreviewRecord::ZAxis;
+    record.reserved = 0;
+    record.lineNumber = m_lineNumber;
+    record.pos[0] = end1;
+    record.pos[1] = end2;
+    record.pos[2] = target[helixAxis];
+    record.center[0] = center1;
+    record.center[1] = center2;
+    record.rotation = clockwise ? -turns : turns;
+    m_records.append(record);
+
+    for (int i = 0; i < 3; ++i) {
+        m_state.position[i] = target[i];
+    }
+
+    return true;
+}
+
+bool QPreviewInterpreterWorker::executeG92(const Block &block, int g92Mode)
+{
+    if (g92Mode == 920)
+    {
+        const char axisLetters[3] = {'X', 'Y', 'Z'};
+        double unitFactor = m_state.metric ? (1.0 / 25.4) : 1.0;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            if (!hasWord(block, axisLetters[i])) {
+                continue;
+            }
+            double value = wordValue(block, axisLetters[i]) * unitFactor;
+            m_state.g92Offset[i] += m_state.position[i] - value;
+            m_state.position[i] = value;
+        }
+    }
+    else    // G92.1 and G92.2 reset the offsets
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            m_state.position[i] += m_state.g92Offset[i];
+            m_state.g92Offset[i] = 0.0;
+        }
+    }
+
+    addRecord(PreviewRecord::SetG92Offset, m_state.g92Offset, PreviewRecord::XAxis | PreviewRecord::YAxis | PreviewRecord::ZAxis);
+
+    return true;
+}
+
+bool QPreviewInterpreterWorker::executeToolOffset(int toolNumber)
+{
+    double toolOffset[3] = {0.0, 0.0, 0.0};
+
+    if (toolNumber != 0)
+    {
+        bool found = false;
+        for (int i = 0; i < m_toolTable.size(); ++i)
+        {
+            QJsonObject tool = m_toolTable.at(i).toObject();
+            if (tool.value("id").toInt() == toolNumber)
+            {
+                toolOffset[0] = tool.value("xOffset").toDouble() * m_machineToInch;
+                toolOffset[2] = tool.value("zOffset").toDouble() * m_machineToInch;
+                found = true;
+                break;
+            }
+        }
+
+        if (!found) {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        m_state.position[i] += m_state.toolOffset[i] - toolOffset[i];
+        m_state.toolOffset[i] = toolOffset[i];
+    }
+    addRecord(PreviewRecord::UseToolOffset, m_state.toolOffset, PreviewRecord::XAxis | PreviewRecord::YAxis | PreviewRecord::ZAxis);
+
+    return true;
+}
+
+void QPreviewInterpreterWorker::addRecord(PreviewRecord::Type type, const double pos[3], quint8 axes)
+{
+    PreviewRecord record;
+    record.type = type;
+    record.axes = axes;
+    record.reserved = 0;
+    record.lineNumber = m_lineNumber;
+    record.pos[0] = pos[0];
+    record.pos[1] = pos[1];
+    record.pos[2] = pos[2];
+    record.center[0] = 0.0;
+    record.center[1] = 0.0;
+    record.rotation = 0;
+    m_records.append(record);
+}
+
+void QPreviewInterpreterWorker::addG5xOffsetRecord()
+{
+    addRecord(PreviewRecord::SetG5xOffset, m_state.g5xOffsets[m_state.g5xIndex - 1],
+              PreviewRecord::XAxis | PreviewRecord::YAxis | PreviewRecord::ZAxis);
+    m_records.last().g5Index = m_state.g5xIndex;
+}
+
+void QPreviewInterpreterWorker::addPlaneRecord()
+{
+    double zero[3] = {0.0, 0.0, 0.0};
+    addRecord(PreviewRecord::SelectPlane, zero, 0);
+    m_records.last().plane = m_state.plane;
+}
+
+QPreviewInterpreter::QPreviewInterpreter(QObject *parent) :
+    QObject(parent),
+    m_model(NULL),
+    m_units(QPreviewClient::CanonUnitsInches),
+    m_linearUnits(1.0),
+    m_g5xIndex(1),
+    m_running(false),
+    m_thread(NULL),
+    m_worker(NULL),
+    m_currentRequestId(0)
+{
+    qRegisterMetaType<PreviewInterpreterState>("PreviewInterpreterState");
+    qRegisterMetaType<PreviewRecordList>("PreviewRecordList");
+
+    m_thread = new QThread(this);
+    m_worker = new QPreviewInterpreterWorker(&m_currentRequestId);
+    m_worker->moveToThread(m_thread);
+    connect(m_thread, SIGNAL(finished()),
+            m_worker, SLOT(deleteLater()));
+    connect(m_worker, SIGNAL(finished(int,PreviewRecordList,bool,int,int)),
+            this, SLOT(workerFinished(int,PreviewRecordList,bool,int,int)));
+    m_thread->start();
+}
+
+QPreviewInterpreter::~QPreviewInterpreter()
+{
+    m_currentRequestId.fetchAndAddOrdered(1);  // cancels a running request
+    m_thread->quit();
+    m_thread->wait();
+}
+
+/** Starts interpreting a program in the background.
+ *  finished is emitted when the preview is in the model or
+ *  the program uses features not supported by the local interpreter.
+ *  firstLine is the first line changed since the last interpretation
+ *  of the program, previews before this line may be retained.
+ **/
+void QPreviewInterpreter::interpret(const QString &localFilePath, const QString &remoteFilePath, int firstLine)
+{
+    if (m_model == NULL)
+    {
+        emit finished(false);
+        return;
+    }
+
+    double machineToInch = (m_linearUnits > 0.0) ? (1.0 / (m_linearUnits * 25.4)) : (1.0 / 25.4);
+
+    PreviewInterpreterState state;
+    for (int i = 0; i < 9; ++i)
+    {
+        state.g5xKnown[i] = false;
+        for (int j = 0; j < 3; ++j) {
+            state.g5xOffsets[i][j] = 0.0;
+        }
+    }
+    state.g5xIndex = qBound(1, m_g5xIndex, 9);
+    state.g5xKnown[state.g5xIndex - 1] = true;
+    jsonToPosition(m_g5xOffset, machineToInch, state.g5xOffsets[state.g5xIndex - 1]);
+    jsonToPosition(m_g92Offset, machineToInch, state.g92Offset);
+    jsonToPosition(m_toolOffset, machineToInch, state.toolOffset);
+    for (int i = 0; i < 3; ++i) {
+        state.position[i] = 0.0;
+    }
+    state.plane = 1;
+    state.motionMode = PreviewInterpreterState::NoMotion;
+    state.toolNumber = 0;
+    state.selectedTool = 0;
+    state.absolute = true;
+    state.absoluteArcs = false;
+    state.metric = (m_units != QPreviewClient::CanonUnitsInches);
+
+    int requestId = m_currentRequestId.fetchAndAddOrdered(1) + 1;
+    m_remoteFilePath = remoteFilePath;
+    updateRunning(true);
+
+    QMetaObject::invokeMethod(m_worker, "interpret", Qt::QueuedConnection,
+                              Q_ARG(int, requestId),
+                              Q_ARG(QString, QUrl(localFilePath).toLocalFile()),
+                              Q_ARG(int, firstLine),
+                              Q_ARG(PreviewInterpreterState, state),
+                              Q_ARG(QJsonArray, m_toolTable),
+                              Q_ARG(double, machineToInch));
+}
+
+/** Cancels a running request and drops the checkpoints of the last interpretation.
+ *  Must be called when the preview in the model was not produced by the interpreter,
+ *  e.g. loaded from the cache or received from the remote preview, otherwise a later
+ *  edit could be spliced onto a preview of an older version of the program.
+ **/
+void QPreviewInterpreter::invalidate()
+{
+    m_currentRequestId.fetchAndAddOrdered(1);
+    updateRunning(false);
+
+    QMetaObject::invokeMethod(m_worker, "clearCheckpoints", Qt::QueuedConnection);
+}
+
+void QPreviewInterpreter::updateRunning(bool running)
+{
+    if (m_running == running)
+        return;
+
+    m_running = running;
+    emit runningChanged(running);
+}
+
+void QPreviewInterpreter::jsonToPosition(const QJsonObject &object, double machineToInch, double position[3]) const
+{
+    position[0] = object.value("x").toDouble() * machineToInch;
+    position[1] = object.value("y").toDouble() * machineToInch;
+    position[2] = object.value("z").toDouble() * machineToInch;
+}
+
+void QPreviewInterpreter::workerFinished(int requestId, const PreviewRecordList &records, bool supported, int errorLine, int firstLine)
+{
+    Q_UNUSED(errorLine)
+
+    if (requestId != m_currentRequestId.load()) {
+        return; // outdated result
+    }
+
+    updateRunning(false);
+
+    if (supported && (m_model != NULL))
+    {
+        if (firstLine <= 1)
+        {
+            m_model->beginUpdate();
+            m_model->clearPreview(m_remoteFilePath, 1);
+            m_model->addPreview(m_remoteFilePath, records.constData(), records.size());
+            m_model->endUpdate();
+        }
+        else    // splice the new records into the retained preview
+        {
+            m_model->clearPreview(m_remoteFilePath, firstLine);
+            m_model->addPreview(m_remoteFilePath, records.constData(), records.size());
+            m_model->endPreviewUpdate(m_remoteFilePath, firstLine);
+        }
+    }
+
+    emit finished(supported);
+}
@@ -0,0 +1,292 @@
+/****************************************************************************
+**
+** Copyright (C) 2015 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+
+
+#ifndef QPREVIEWINTERPRETER_H
+#define QPREVIEWINTERPRETER_H
+
+#include <QObject>
+#include <QThread>
+#include <QAtomicInt>
+#include <QFile>
+#include <QUrl>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QMetaType>
+#include "qgcodeprogrammodel.h"
+#include "qpreviewclient.h"
+#include "previewrecord.h"
+
+/** Modal state of the local preview interpreter.
+ *  All lengths are stored in inches like in the remote preview.
+ **/
+struct PreviewInterpreterState
+{
+    enum MotionMode {
+        NoMotion = -1,
+        Traverse = 0,
+        Feed = 1,
+        ArcClockwise = 2,
+        ArcCounterClockwise = 3
+    };
+
+    double position[3];
+    double g5xOffsets[9][3];
+    bool   g5xKnown[9];
+    int    g5xIndex;
+    double g92Offset[3];
+    double toolOffset[3];
+    int    plane;           // 1=XY 2=YZ 3=XZ
+    int    motionMode;
+    int    toolNumber;
+    int    selectedTool;
+    bool   absolute;
+    bool   absoluteArcs;
+    bool   metric;
+};
+
+Q_DECLARE_METATYPE(PreviewInterpreterState)
+
+class QPreviewInterpreterWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit QPreviewInterpreterWorker(QAtomicInt *currentRequestId, QObject *parent = 0);
+
+public slots:
+    void interpret(int requestId, const QString &filePath, int firstLine, const PreviewInterpreterState &state,
+                   const QJsonArray &toolTable, double machineToInch);
+    void clearCheckpoints();
+
+signals:
+    void finished(int requestId, const PreviewRecordList &records, bool supported, int errorLine, int firstLine);
+
+private:
+    struct Block {
+        double values[26];
+        quint32 words;          // bit n set if letter 'A' + n is present
+        int gCodes[10];         // G code * 10, e.g. 591 for G59.1
+        int gCodeCount;
+        int mCodes[10];
+        int mCodeCount;
+    };
+
+    QAtomicInt *m_currentRequestId;
+    PreviewInterpreterState m_state;
+    QJsonArray m_toolTable;
+    double m_machineToInch;
+    int m_lineNumber;
+    bool m_programEnded;
+    PreviewRecordList m_records;
+    QString m_checkpointFilePath;
+    QVector<PreviewInterpreterState> m_checkpoints;   // state before line n * checkpointInterval + 1
+
+    bool canResume(const QString &filePath, const PreviewInterpreterState &state,
+                   const QJsonArray &toolTable, double machineToInch) const;
+
+    bool parseLine(const QByteArray &line, Block *block) const;
+    bool executeBlock(const Block &block);
+    bool hasWord(const Block &block, char letter) const;
+    double wordValue(const Block &block, char letter) const;
+    bool executeMove(const Block &block, bool machineCoordinates);
+    bool executeArc(const Block &block, const double target[3]);
+    bool executeG92(const Block &block, int g92Mode);
+    bool executeToolOffset(int toolNumber);
+    void addRecord(PreviewRecord::Type type, const double pos[3], quint8 axes);
+    void addG5xOffsetRecord();
+    void addPlaneRecord();
+};
+
+class QPreviewInterpreter : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QGCodeProgramModel *model READ model WRITE setModel NOTIFY modelChanged)
+    Q_PROPERTY(QPreviewClient::CanonUnits units READ units WRITE setUnits NOTIFY unitsChanged)
+    Q_PROPERTY(double linearUnits READ linearUnits WRITE setLinearUnits NOTIFY linearUnitsChanged)
+    Q_PROPERTY(int g5xIndex READ g5xIndex WRITE setG5xIndex NOTIFY g5xIndexChanged)
+    Q_PROPERTY(QJsonObject g5xOffset READ g5xOffset WRITE setG5xOffset NOTIFY g5xOffsetChanged)
+    Q_PROPERTY(QJsonObject g92Offset READ g92Offset WRITE setG92Offset NOTIFY g92OffsetChanged)
+    Q_PROPERTY(QJsonObject toolOffset READ toolOffset WRITE setToolOffset NOTIFY toolOffsetChanged)
+    Q_PROPERTY(QJsonArray toolTable READ toolTable WRITE setToolTable NOTIFY toolTableChanged)
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
+
+public:
+    explicit QPreviewInterpreter(QObject *parent = 0);
+    ~QPreviewInterpreter();
+
+    QGCodeProgramModel * model() const
+    {
+        return m_model;
+    }
+
+    QPreviewClient::CanonUnits units() const
+    {
+        return m_units;
+    }
+
+    double linearUnits() const
+    {
+        return m_linearUnits;
+    }
+
+    int g5xIndex() const
+    {
+        return m_g5xIndex;
+    }
+
+    QJsonObject g5xOffset() const
+    {
+        return m_g5xOffset;
+    }
+
+    QJsonObject g92Offset() const
+    {
+        return m_g92Offset;
+    }
+
+    QJsonObject toolOffset() const
+    {
+        return m_toolOffset;
+    }
+
+    QJsonArray toolTable() const
+    {
+        return m_toolTable;
+    }
+
+    bool isRunning() const
+    {
+        return m_running;
+    }
+
+public slots:
+    void interpret(const QString &localFilePath, const QString &remoteFilePath, int firstLine = 1);
+    void invalidate();
+
+    void setModel(QGCodeProgramModel * arg)
+    {
+        if (m_model != arg) {
+            m_model = arg;
+            emit modelChanged(arg);
+        }
+    }
+
+    void setUnits(QPreviewClient::CanonUnits arg)
+    {
+        if (m_units == arg)
+            return;
+
+        m_units = arg;
+        emit unitsChanged(arg);
+    }
+
+    void setLinearUnits(double arg)
+    {
+        if (m_linearUnits == arg)
+            return;
+
+        m_linearUnits = arg;
+        emit linearUnitsChanged(arg);
+    }
+
+    void setG5xIndex(int arg)
+    {
+        if (m_g5xIndex == arg)
+            return;
+
+        m_g5xIndex = arg;
+        emit g5xIndexChanged(arg);
+    }
+
+    void setG5xOffset(QJsonObject arg)
+    {
+        if (m_g5xOffset == arg)
+            return;
+
+        m_g5xOffset = arg;
+        emit g5xOffsetChanged(arg);
+    }
+
+    void setG92Offset(QJsonObject arg)
+    {
+        if (m_g92Offset == arg)
+            return;
+
+        m_g92Offset = arg;
+        emit g92OffsetChanged(arg);
+    }
+
+    void setToolOffset(QJsonObject arg)
+    {
+        if (m_toolOffset == arg)
+            return;
+
+        m_toolOffset = arg;
+        emit toolOffsetChanged(arg);
+    }
+
+    void setToolTable(QJsonArray arg)
+    {
+        if (m_toolTable == arg)
+            return;
+
+        m_toolTable = arg;
+        emit toolTableChanged(arg);
+    }
+
+private:
+    QGCodeProgramModel *m_model;
+    QPreviewClient::CanonUnits m_units;
+    double m_linearUnits;
+    int m_g5xIndex;
+    QJsonObject m_g5xOffset;
+    QJsonObject m_g92Offset;
+    QJsonObject m_toolOffset;
+    QJsonArray m_toolTable;
+    bool m_running;
+
+    QThread *m_thread;
+    QPreviewInterpreterWorker *m_worker;
+    QAtomicInt m_currentRequestId;
+    QString m_remoteFilePath;
+
+    void updateRunning(bool running);
+    void jsonToPosition(const QJsonObject &object, double machineToInch, double position[3]) const;
+
+private slots:
+    void workerFinished(int requestId, const PreviewRecordList &records, bool supported, int errorLine, int firstLine);
+
+signals:
+    void modelChanged(QGCodeProgramModel * arg);
+    void unitsChanged(QPreviewClient::CanonUnits arg);
+    void linearUnitsChanged(double arg);
+    void g5xIndexChanged(int arg);
+    void g5xOffsetChanged(QJsonObject arg);
+    void g92OffsetChanged(QJsonObject arg);
+    void toolOffsetChanged(QJsonObject arg);
+    void toolTableChanged(QJsonArray arg);
+    void runningChanged(bool arg);
+    void finished(bool supported);
+};
+
+#endif // QPREVIEWINTERPRETER_H
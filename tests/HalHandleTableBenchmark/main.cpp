@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QHash>
+#include <QVector>
+#include "qhalhandletable.h"
+
+/** Compares handle lookups in QHalHandleTable with the QHash lookup
+ *  for incremental updates of 1000 pins at 1 kHz, i.e. one second of
+ *  updates per run. The handles follow the remote side and are not
+ *  continuous, every fourth handle is skipped.
+ **/
+
+struct Pin {
+    double value;
+};
+
+static const int pinCount = 1000;
+static const int updateRate = 1000;     // incremental updates per second
+static const int handleBase = 0x2a000;
+static volatile double valueSink = 0.0;  // keeps the lookups from being optimized out
+
+static QVector<int> createHandles(int step)
+{
+    QVector<int> handles;
+
+    for (int i = 0; i < pinCount; ++i)
+    {
+        handles.append(handleBase + i * step + i / 3);
+    }
+
+    return handles;
+}
+
+/** Returns the time in ms to resolve one second of updates */
+static double hashTime(const QHash<int, Pin*> &pins, const QVector<int> &handles)
+{
+    QElapsedTimer timer;
+    double sum = 0.0;
+
+    timer.start();
+    for (int update = 0; update < updateRate; ++update)
+    {
+        for (int i = 0; i < handles.size(); ++i)
+        {
+            Pin *pin = pins.value(handles.at(i), NULL);
+            if (pin != NULL) {
+                pin->value += 1.0;
+                sum += pin->value;
+            }
+        }
+    }
+    valueSink = sum;
+
+    return timer.nsecsElapsed() / 1000000.0;
+}
+
+static double tableTime(const QHalHandleTable<Pin> &table, const QVector<int> &handles)
+{
+    QElapsedTimer timer;
+    double sum = 0.0;
+
+    timer.start();
+    for (int update = 0; update < updateRate; ++update)
+    {
+        for (int i = 0; i < handles.size(); ++i)
+        {
+            Pin *pin = table.value(handles.at(i));
+            if (pin != NULL) {
+                pin->value += 1.0;
+                sum += pin->value;
+            }
+        }
+    }
+    valueSink = sum;
+
+    return timer.nsecsElapsed() / 1000000.0;
+}
+
+static void run(const QString &name, int step, QTextStream &out)
+{
+    QVector<Pin> storage(pinCount);
+    QVector<int> handles = createHandles(step);
+    QHash<int, Pin*> pins;
+    QHalHandleTable<Pin> table;
+    double hash;
+    double dense;
+    int lookups = pinCount * updateRate;
+
+    for (int i = 0; i < pinCount; ++i)
+    {
+        storage[i].value = 0.0;
+        pins.insert(handles.at(i), &storage[i]);
+    }
+    table.build(pins);
+
+    hashTime(pins, handles);    // warm up the caches
+    hash = hashTime(pins, handles);
+    dense = tableTime(table, handles);
+
+    out << name << ": QHash " << hash * 1000000.0 / lookups << " ns, QHalHandleTable "
+        << dense * 1000000.0 / lookups << " ns per lookup, "
+        << hash / 10.0 << " % vs " << dense / 10.0 << " % of one second" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+
+    run("dense handles", 1, out);
+    run("sparse handles", 100, out);    // falls back to the hash
+
+    return 0;
+}
@@ -0,0 +1,10 @@
+TEMPLATE = app
+TARGET = ProtobufAllocationBenchmark
+
+QT = core
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../machinekit.pri)
+
+SOURCES += main.cpp
@@ -0,0 +1,229 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <new>
+#include <cstdlib>
+#include <google/protobuf/message.h>
+#include <machinetalk/protobuf/message.pb.h>
+
+/** Counts the heap allocations per received message for status,
+ *  halrcomp and preview traffic. Compares a container allocated per
+ *  message, a reused container with submessages copied out and a
+ *  reused container with submessages read by reference, the way the
+ *  services handle messages now.
+ **/
+
+static int allocationCount = 0;
+static volatile double valueSink = 0.0;   // keeps the reads from being optimized out
+
+void *operator new(std::size_t size)
+{
+    allocationCount++;
+    void *pointer = std::malloc((size == 0) ? 1 : size);
+    if (pointer == NULL) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void operator delete(void *pointer) throw()
+{
+    std::free(pointer);
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete[](void *pointer) throw()
+{
+    operator delete(pointer);
+}
+
+static const int iterations = 10000;
+static const int pinCount = 100;
+static const int previewCount = 1000;
+
+enum Strategy {
+    NewContainer,
+    CopySubmessages,
+    ReferenceSubmessages
+};
+
+static void setPosition(pb::Position *position, double offset)
+{
+    position->set_x(offset + 1.0);
+    position->set_y(offset + 2.0);
+    position->set_z(offset + 3.0);
+}
+
+static std::string statusMessage()
+{
+    pb::Container container;
+    pb::EmcStatusMotion *motion = container.mutable_emc_status_motion();
+
+    container.set_type(pb::MT_EMCSTAT_INCREMENTAL_UPDATE);
+    setPosition(motion->mutable_actual_position(), 0.1);
+    setPosition(motion->mutable_position(), 0.2);
+    setPosition(motion->mutable_dtg(), 0.3);
+    motion->set_current_vel(12.5);
+    for (int i = 0; i < 3; ++i)
+    {
+        pb::EmcStatusMotionAxis *axis = motion->add_axis();
+        axis->set_index(i);
+        axis->set_input(10.0 * i);
+        axis->set_output(10.0 * i);
+    }
+
+    return container.SerializeAsString();
+}
+
+static std::string halrcompMessage()
+{
+    pb::Container container;
+
+    container.set_type(pb::MT_HALRCOMP_INCREMENTAL_UPDATE);
+    for (int i = 0; i < pinCount; ++i)
+    {
+        pb::Pin *pin = container.add_pin();
+        pin->set_handle(i);
+        pin->set_halfloat(0.5 * i);
+    }
+
+    return container.SerializeAsString();
+}
+
+static std::string previewMessage()
+{
+    pb::Container container;
+
+    container.set_type(pb::MT_PREVIEW);
+    for (int i = 0; i < previewCount; ++i)
+    {
+        pb::Preview *preview = container.add_preview();
+        preview->set_type(pb::PV_STRAIGHT_FEED);
+        preview->set_line_number(i);
+        setPosition(preview->mutable_pos(), i);
+    }
+
+    return container.SerializeAsString();
+}
+
+/** Reads the message like the services do, returns a value to keep the reads */
+static double dispatch(const pb::Container &rx, Strategy strategy)
+{
+    double sum = 0.0;
+
+    if (rx.has_emc_status_motion())
+    {
+        if (strategy == ReferenceSubmessages) {
+            const pb::EmcStatusMotion &motion = rx.emc_status_motion();
+            sum += motion.current_vel();
+        }
+        else {
+            pb::EmcStatusMotion motion = rx.emc_status_motion();
+            sum += motion.current_vel();
+        }
+    }
+
+    for (int i = 0; i < rx.pin_size(); ++i)
+    {
+        if (strategy == ReferenceSubmessages) {
+            const pb::Pin &pin = rx.pin(i);
+            sum += pin.halfloat();
+        }
+        else {
+            pb::Pin pin = rx.pin(i);
+            sum += pin.halfloat();
+        }
+    }
+
+    for (int i = 0; i < rx.preview_size(); ++i)
+    {
+        if (strategy == ReferenceSubmessages) {
+            const pb::Preview &preview = rx.preview(i);
+            sum += preview.pos().x();
+        }
+        else {
+            pb::Preview preview = rx.preview(i);
+            sum += preview.pos().x();
+        }
+    }
+
+    return sum;
+}
+
+static void run(const QString &name, const std::string &data, Strategy strategy, QTextStream &out)
+{
+    static const char *strategyNames[] = { "new container", "copy submessages", "reference submessages" };
+    pb::Container rx;
+    QElapsedTimer timer;
+    double sum = 0.0;
+    int allocations;
+
+    rx.ParseFromArray(data.data(), data.size());    // warm up the reused container
+
+    allocations = allocationCount;
+    timer.start();
+    for (int i = 0; i < iterations; ++i)
+    {
+        if (strategy == NewContainer)
+        {
+            pb::Container *container = new pb::Container();
+            container->ParseFromArray(data.data(), data.size());
+            sum += dispatch(*container, strategy);
+            delete container;
+        }
+        else
+        {
+            rx.ParseFromArray(data.data(), data.size());
+            sum += dispatch(rx, strategy);
+        }
+    }
+
+    out << name << ", " << strategyNames[strategy] << ": "
+        << (double)(allocationCount - allocations) / iterations << " allocations, "
+        << timer.nsecsElapsed() / 1000.0 / iterations << " us per message" << endl;
+
+    valueSink = sum;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+    const std::string status = statusMessage();
+    const std::string halrcomp = halrcompMessage();
+    const std::string preview = previewMessage();
+
+    for (int strategy = NewContainer; strategy <= ReferenceSubmessages; ++strategy)
+    {
+        run("status", status, static_cast<Strategy>(strategy), out);
+        run("halrcomp", halrcomp, static_cast<Strategy>(strategy), out);
+        run("preview", preview, static_cast<Strategy>(strategy), out);
+    }
+
+    return 0;
+}
@@ -0,0 +1,15 @@
+TEMPLATE = app
+TARGET = StatusConverterBenchmark
+
+QT = core qml
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../machinekit.pri)
+
+INCLUDEPATH += $$SOURCE_ROOT/src/application
+
+SOURCES += main.cpp \
+    $$SOURCE_ROOT/src/application/qapplicationstatusconverter.cpp
+
+HEADERS += $$SOURCE_ROOT/src/application/qapplicationstatusconverter.h
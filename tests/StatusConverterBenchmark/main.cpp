@@ -0,0 +1,187 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <service.h>
+#include "qapplicationstatusconverter.h"
+
+/** Compares the reflection based Service::recurseMessage with the
+ *  typed QApplicationStatusConverter on status motion updates.
+ *  Exits with 1 if the two produce different objects.
+ **/
+
+static const int axisCount = 9;
+static const int iterations = 20000;
+
+static void setPosition(pb::Position *position, double offset)
+{
+    position->set_x(offset + 1.0);
+    position->set_y(offset + 2.0);
+    position->set_z(offset + 3.0);
+    position->set_a(offset + 4.0);
+    position->set_b(offset + 5.0);
+    position->set_c(offset + 6.0);
+    position->set_u(offset + 7.0);
+    position->set_v(offset + 8.0);
+    position->set_w(offset + 9.0);
+}
+
+/** A full update with all fields that change while a machine runs */
+static void fillFullUpdate(pb::EmcStatusMotion *motion)
+{
+    motion->set_active_queue(1);
+    setPosition(motion->mutable_actual_position(), 0.1);
+    setPosition(motion->mutable_position(), 0.2);
+    setPosition(motion->mutable_dtg(), 0.3);
+    setPosition(motion->mutable_joint_actual_position(), 0.4);
+    setPosition(motion->mutable_joint_position(), 0.5);
+    setPosition(motion->mutable_g5x_offset(), 0.6);
+    setPosition(motion->mutable_g92_offset(), 0.7);
+    setPosition(motion->mutable_probed_position(), 0.8);
+    motion->set_current_line(42);
+    motion->set_current_vel(12.5);
+    motion->set_distance_to_go(3.25);
+    motion->set_enabled(true);
+    motion->set_feedrate(1.0);
+    motion->set_g5x_index(pb::ORIGIN_G54);
+    motion->set_inpos(false);
+    motion->set_motion_line(41);
+    motion->set_spindle_speed(1200.0);
+    motion->set_state(pb::RCS_EXEC);
+
+    for (int i = 0; i < axisCount; ++i)
+    {
+        pb::EmcStatusMotionAxis *axis = motion->add_axis();
+        axis->set_index(i);
+        axis->set_enabled(true);
+        axis->set_ferror_current(0.001 * i);
+        axis->set_homed(true);
+        axis->set_input(10.0 * i);
+        axis->set_output(10.0 * i);
+        axis->set_velocity(1.0 * i);
+    }
+
+    for (int i = 0; i < 16; ++i)
+    {
+        pb::EmcStatusDigitalIO *din = motion->add_din();
+        din->set_index(i);
+        din->set_value((i % 2) == 0);
+        pb::EmcStatusAnalogIO *ain = motion->add_ain();
+        ain->set_index(i);
+        ain->set_value(0.5 * i);
+    }
+}
+
+/** A typical incremental update while moving */
+static void fillIncrementalUpdate(pb::EmcStatusMotion *motion)
+{
+    setPosition(motion->mutable_actual_position(), 1.1);
+    setPosition(motion->mutable_position(), 1.2);
+    setPosition(motion->mutable_dtg(), 1.3);
+    motion->set_current_vel(13.0);
+    motion->set_distance_to_go(3.0);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        pb::EmcStatusMotionAxis *axis = motion->add_axis();
+        axis->set_index(i);
+        axis->set_ferror_current(0.002 * i);
+        axis->set_input(11.0 * i);
+        axis->set_output(11.0 * i);
+    }
+}
+
+static double reflectionTime(const pb::EmcStatusMotion &motion, const QJsonObject &initial, QJsonObject *result)
+{
+    QElapsedTimer timer;
+    QJsonObject object;
+
+    timer.start();
+    for (int i = 0; i < iterations; ++i)
+    {
+        QStringList updatedFields;
+        object = initial;
+        Service::recurseMessage(motion, &object, &updatedFields);
+    }
+    *result = object;
+
+    return timer.nsecsElapsed() / 1000.0 / iterations;
+}
+
+static double typedTime(const pb::EmcStatusMotion &motion, const QJsonObject &initial, QJsonObject *result)
+{
+    QElapsedTimer timer;
+    QJsonObject object;
+
+    timer.start();
+    for (int i = 0; i < iterations; ++i)
+    {
+        QStringList updatedFields;
+        object = initial;
+        QApplicationStatusConverter::motionToJson(motion, &object, &updatedFields);
+    }
+    *result = object;
+
+    return timer.nsecsElapsed() / 1000.0 / iterations;
+}
+
+static bool run(const QString &name, const pb::EmcStatusMotion &motion, QTextStream &out)
+{
+    QJsonObject initial;
+    QJsonObject reflectionResult;
+    QJsonObject typedResult;
+    double reflection;
+    double typed;
+
+    Service::recurseDescriptor(pb::EmcStatusMotion::descriptor(), &initial);
+    reflection = reflectionTime(motion, initial, &reflectionResult);
+    typed = typedTime(motion, initial, &typedResult);
+
+    out << name << ": reflection " << reflection << " us, typed " << typed
+        << " us per message (" << motion.ByteSize() << " bytes)" << endl;
+
+    if (reflectionResult != typedResult)
+    {
+        out << name << ": converters produce different objects" << endl;
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+    pb::EmcStatusMotion fullUpdate;
+    pb::EmcStatusMotion incrementalUpdate;
+    bool equal = true;
+
+    fillFullUpdate(&fullUpdate);
+    fillIncrementalUpdate(&incrementalUpdate);
+
+    equal &= run("full update", fullUpdate, out);
+    equal &= run("incremental update", incrementalUpdate, out);
+
+    return equal ? 0 : 1;
+}
@@ -0,0 +1,13 @@
+TEMPLATE = app
+TARGET = ValueModelBenchmark
+
+QT = core
+CONFIG += console
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../../src/controls
+
+SOURCES += main.cpp \
+    ../../src/controls/qvaluemodel.cpp
+
+HEADERS += ../../src/controls/qvaluemodel.h
@@ -0,0 +1,132 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <qmath.h>
+#include "qvaluemodel.h"
+
+/** Times the operations of the ValueModel used by the charts: adding
+ *  samples to a full ring buffer, reading the extrema and decimating
+ *  a window for drawing. Samples are added at 1 kHz for one minute
+ *  into a model of the default size. The extrema are compared with a
+ *  scan of all stored samples after the ring has wrapped, the benchmark
+ *  exits with 1 if they differ.
+ **/
+
+static const int sampleRate = 1000;     // samples per second
+static const int duration = 60;         // s
+static const int windowPoints = 500;    // points drawn by a chart
+static const int repetitions = 1000;
+static const int checkInterval = 97;    // samples between extrema checks
+static volatile double valueSink = 0.0; // keeps the reads from being optimized out
+
+static bool checkExtrema(const QValueModel &model, const QString &name, QTextStream &out)
+{
+    double highest = model.get(0).value("value").toDouble();
+    double lowest = highest;
+
+    for (int i = 1; i < model.count(); ++i)
+    {
+        double value = model.get(i).value("value").toDouble();
+        highest = qMax(highest, value);
+        lowest = qMin(lowest, value);
+    }
+
+    if ((model.highestValue() != highest) || (model.lowestValue() != lowest))
+    {
+        out << name << ": extrema " << model.lowestValue() << " to " << model.highestValue()
+            << " differ from the stored samples " << lowest << " to " << highest << endl;
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+    QValueModel model;
+    QElapsedTimer timer;
+    int samples = sampleRate * duration;
+    double start = 1.4e12;  // ms since epoch
+    double end = start + (samples - 1) * 1000.0 / sampleRate;
+    double sum = 0.0;
+    qint64 addTime;
+    qint64 extremaTime;
+    qint64 windowTime;
+    qint64 indexTime;
+    bool equal = true;
+
+    timer.start();
+    for (int i = 0; i < samples; ++i)
+    {
+        model.addData(qSin(i / 100.0) * 10.0 + (i % 7), start + i * 1000.0 / sampleRate);
+    }
+    addTime = timer.nsecsElapsed();
+    equal &= checkExtrema(model, "addData", out);
+
+    timer.start();
+    for (int i = 0; i < repetitions; ++i)
+    {
+        model.addData(qSin(i / 100.0), end + (i + 1) * 1000.0 / sampleRate);
+        sum += model.highestValue() - model.lowestValue();
+    }
+    extremaTime = timer.nsecsElapsed();
+    equal &= checkExtrema(model, "addData with extrema", out);
+
+    timer.start();
+    for (int i = 0; i < repetitions; ++i)
+    {
+        sum += model.window(model.startTimestamp(), model.endTimestamp(), windowPoints).size();
+    }
+    windowTime = timer.nsecsElapsed();
+
+    timer.start();
+    for (int i = 0; i < repetitions; ++i)
+    {
+        sum += model.indexOf(model.startTimestamp() + i);
+    }
+    indexTime = timer.nsecsElapsed();
+
+    valueSink = sum;
+
+    // random values over two ring lengths, the extremum leaves the ring often
+    qsrand(1);
+    for (int i = 0; i < 2 * model.maximumSize(); ++i)
+    {
+        model.addData(qrand() % 1000, end + (repetitions + i + 1) * 1000.0 / sampleRate);
+        if ((i % checkInterval) == 0)
+        {
+            equal &= checkExtrema(model, "random values", out);
+        }
+    }
+
+    out << model.count() << " of " << samples + repetitions << " samples stored" << endl;
+    out << "addData: " << addTime / 1000.0 / samples << " us per sample" << endl;
+    out << "addData with extrema: " << extremaTime / 1000.0 / repetitions << " us per sample" << endl;
+    out << "window of " << windowPoints << " points: " << windowTime / 1000.0 / repetitions << " us" << endl;
+    out << "indexOf: " << indexTime / 1000.0 / repetitions << " us" << endl;
+
+    return equal ? 0 : 1;
+}
@@ -0,0 +1,17 @@
+# Include this file into a benchmark to link the QtQuickVcp libraries.
+# The benchmark has to be built in tests/<name> or tools/<name> of the
+# QtQuickVcp build directory.
+BUILD_ROOT = $$OUT_PWD/../..
+SOURCE_ROOT = $$PWD/..
+
+include($$SOURCE_ROOT/paths.pri)
+
+INCLUDEPATH += $$SOURCE_ROOT/src/common
+INCLUDEPATH += $$BUILD_ROOT/3rdparty/machinetalk-protobuf-qt/build/cpp
+!isEmpty(PROTOBUF_INCLUDE_PATH): INCLUDEPATH += $$PROTOBUF_INCLUDE_PATH
+!isEmpty(PROTOBUF_LIB_PATH): LIBS += -L$$PROTOBUF_LIB_PATH
+
+LIBS += -L$$BUILD_ROOT/src/common -lmachinekit-common
+LIBS += -L$$BUILD_ROOT/3rdparty/machinetalk-protobuf-qt -lmachinetalk-protobuf
+!win32: LIBS += -lprotobuf
+win32:  LIBS += -llibprotobuf
@@ -0,0 +1,12 @@
+TEMPLATE = app
+TARGET = haltrace2csv
+
+QT = core
+CONFIG += console
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../../src/halremote
+
+SOURCES += main.cpp
+
+HEADERS += ../../src/halremote/qhaltraceformat.h
@@ -0,0 +1,151 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#include <QCoreApplication>
+#include <QFile>
+#include <QHash>
+#include <QStringList>
+#include <QTextStream>
+#include "qhaltraceformat.h"
+
+/** Converts a ring file or a dump of the HAL trace recorder to CSV.
+ *  The records are written in chronological order with the absolute
+ *  time in ms since epoch.
+ **/
+
+static const char *kindNames[] = { "pin", "pinset", "signal" };
+static const char *typeNames[] = { "", "bit", "float", "s32", "u32" };
+
+static quint64 nameKey(quint16 source, quint8 kind, quint32 handle)
+{
+    return ((quint64)source << 40) | ((quint64)kind << 32) | handle;
+}
+
+static QString formatValue(const QHalTraceRecord &record)
+{
+    switch (record.type)
+    {
+    case QHalTraceBit: return QString::number(record.value.bit);
+    case QHalTraceFloat: return QString::number(record.value.floating, 'g', 17);
+    case QHalTraceS32: return QString::number(record.value.s32);
+    case QHalTraceU32: return QString::number(record.value.u32);
+    default: return QString();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QStringList arguments = app.arguments();
+    QTextStream err(stderr);
+
+    if ((arguments.size() < 2) || (arguments.size() > 3))
+    {
+        err << "usage: haltrace2csv <trace file> [<csv file>]" << endl;
+        return 1;
+    }
+
+    QFile input(arguments.at(1));
+    if (!input.open(QIODevice::ReadOnly))
+    {
+        err << arguments.at(1) << ": " << input.errorString() << endl;
+        return 1;
+    }
+
+    QHalTraceHeader header;
+    if ((input.read((char*)&header, sizeof(header)) != (qint64)sizeof(header))
+        || (header.magic != QHAL_TRACE_MAGIC)
+        || (header.version != QHAL_TRACE_VERSION)
+        || (header.headerSize != sizeof(QHalTraceHeader))
+        || (header.nameSize != sizeof(QHalTraceName))
+        || (header.recordSize != sizeof(QHalTraceRecord)))
+    {
+        err << arguments.at(1) << ": not a HAL trace file of this version" << endl;
+        return 1;
+    }
+
+    QHash<quint64, QString> names;     // by source, kind and handle
+    for (quint32 i = 0; i < header.nameCapacity; ++i)
+    {
+        QHalTraceName name;
+        if (input.read((char*)&name, sizeof(name)) != (qint64)sizeof(name))
+        {
+            err << arguments.at(1) << ": truncated name table" << endl;
+            return 1;
+        }
+        if (i < header.namesWritten)
+        {
+            name.name[QHAL_TRACE_NAME_LENGTH - 1] = '\0';
+            names.insert(nameKey(name.source, name.kind, name.handle), QString::fromUtf8(name.name));
+        }
+    }
+
+    QFile output;
+    if (arguments.size() == 3)
+    {
+        output.setFileName(arguments.at(2));
+        if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        {
+            err << arguments.at(2) << ": " << output.errorString() << endl;
+            return 1;
+        }
+    }
+    else
+    {
+        output.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+    }
+    QTextStream out(&output);
+
+    // the oldest record follows the newest one once the ring has wrapped
+    qint64 recordsOffset = input.pos();
+    quint64 count = qMin(header.recordsWritten, header.recordCapacity);
+    quint64 first = (header.recordsWritten > header.recordCapacity) ? (header.recordsWritten % header.recordCapacity) : 0;
+
+    out << "timestamp,kind,handle,name,type,value" << endl;
+    for (quint64 i = 0; i < count; ++i)
+    {
+        QHalTraceRecord record;
+        quint64 index = (first + i) % header.recordCapacity;
+
+        if (((i == 0) || (index == 0))  // records are read sequentially between the seeks
+            && !input.seek(recordsOffset + (qint64)(index * sizeof(QHalTraceRecord))))
+        {
+            err << arguments.at(1) << ": truncated records" << endl;
+            return 1;
+        }
+        if (input.read((char*)&record, sizeof(record)) != (qint64)sizeof(record))
+        {
+            err << arguments.at(1) << ": truncated records" << endl;
+            return 1;
+        }
+
+        quint8 nameKind = (record.kind == QHalTraceSignalUpdate) ? QHalTraceSignalUpdate : QHalTracePinUpdate;
+        out << QString::number(header.startTime + record.timestamp / 1e6, 'f', 3) << ","
+            << ((record.kind <= QHalTraceSignalUpdate) ? kindNames[record.kind] : "") << ","
+            << record.handle << ","
+            << names.value(nameKey(record.source, nameKind, record.handle)) << ","
+            << ((record.type <= QHalTraceU32) ? typeNames[record.type] : "") << ","
+            << formatValue(record) << "\n";
+    }
+    out.flush();
+
+    return 0;
+}
@@ -0,0 +1,23 @@
+TEMPLATE = app
+TARGET = haltracetiming
+
+QT = core qml
+CONFIG += console
+CONFIG -= app_bundle
+
+include(../../tests/machinekit.pri)
+
+INCLUDEPATH += ../../src/halremote
+
+SOURCES += main.cpp \
+    ../../src/halremote/qhaltracerecorder.cpp \
+    ../../src/halremote/qhalpin.cpp \
+    ../../src/halremote/qhalsignal.cpp \
+    ../../src/halremote/qhalvalue.cpp
+
+HEADERS += ../../src/halremote/qhaltracerecorder.h \
+    ../../src/halremote/qhaltraceformat.h \
+    ../../src/halremote/qhalpin.h \
+    ../../src/halremote/qhalsignal.h \
+    ../../src/halremote/qhalvalue.h \
+    ../../src/halremote/qhalobjectregistry.h
@@ -0,0 +1,87 @@
+/****************************************************************************
+**
+** Copyright (C) 2014 Alexander Rössler
+** License: LGPL version 2.1
+**
+** This file is part of QtQuickVcp.
+**
+** All rights reserved. This program and the accompanying materials
+** are made available under the terms of the GNU Lesser General Public License
+** (LGPL) version 2.1 which accompanies this distribution, and is available at
+** http://www.gnu.org/licenses/lgpl-2.1.html
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+** Lesser General Public License for more details.
+**
+** Contributors:
+** Alexander Rössler @ The Cool Tool GmbH <mail DOT aroessler AT gmail DOT com>
+**
+****************************************************************************/
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QVector>
+#include "qhaltracerecorder.h"
+
+/** Checks that recording a value with the HAL trace recorder takes well
+ *  under a microsecond. Records into a ring file in the temporary
+ *  directory and exits with 1 if a sample takes longer than the limit.
+ **/
+
+static const int samples = 10000000;    // ten times the ring, so it wraps
+static const int recordCapacity = 1000000;
+static const double limitNs = 250.0;
+
+static double recordTime(const QVector<QHalValue> &values)
+{
+    QElapsedTimer timer;
+
+    timer.start();
+    for (int i = 0; i < samples; ++i)
+    {
+        const QHalValue &value = values.at(i % values.size());
+        QHalTraceRecorder::record(QHalTracePinUpdate, 0, (i % 1000) + 1, value);
+    }
+
+    return (double)timer.nsecsElapsed() / samples;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+    QHalTraceRecorder recorder;
+    QVector<QHalValue> values;
+    double inactive;
+    double active;
+
+    values.append(QHalValue(1.5));
+    values.append(QHalValue(true));
+    values.append(QHalValue((qint32)-42));
+    values.append(QHalValue((quint32)42));
+
+    inactive = recordTime(values);
+
+    recorder.setFileName(QDir::temp().filePath("haltracetiming.bin"));
+    recorder.setRecordCapacity(recordCapacity);
+    recorder.classBegin();
+    recorder.componentComplete();
+    recorder.setActive(true);
+    if (!recorder.isActive())
+    {
+        out << "cannot start the recorder: " << recorder.errorString() << endl;
+        return 1;
+    }
+
+    active = recordTime(values);
+    recorder.setActive(false);
+    QFile::remove(recorder.fileName());
+
+    out << "no recorder: " << inactive << " ns per sample" << endl;
+    out << "recording: " << active << " ns per sample, limit " << limitNs << " ns" << endl;
+
+    return (active < limitNs) ? 0 : 1;
+}